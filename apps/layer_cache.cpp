@@ -0,0 +1,20 @@
+#include "layer_cache.hpp"
+
+#include <cstdint>
+#include <system_error>
+
+namespace lve {
+
+std::string fileKey(const std::filesystem::path &path) {
+   std::string key = path.string();
+   std::error_code ec;
+   std::filesystem::file_time_type time =
+       std::filesystem::last_write_time(path, ec);
+   if (ec) return key;
+   uintmax_t bytes = std::filesystem::file_size(path, ec);
+   if (ec) return key;
+   return key + "|" + std::to_string(bytes) + "|" +
+          std::to_string(time.time_since_epoch().count());
+}
+
+}  // namespace lve
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace lve {
+
+/**
+ * @brief Ruta, tamaño y fecha de modificación de un archivo; sólo la
+ * ruta si no se puede leer.
+ */
+std::string fileKey(const std::filesystem::path &path);
+
+/**
+ * @brief Una capa del proyecto, calculada una sola vez por clave. Si dos
+ * hilos la piden a la vez, uno la calcula y el otro espera.
+ */
+template <typename T>
+class Layer {
+  public:
+   /**
+    * @brief Llama a compute sólo si la clave cambió.
+    * @throws Lo que tire compute; la capa queda como estaba.
+    */
+   template <typename F>
+   std::shared_ptr<const T> get(const std::string &key, F &&compute) {
+      std::lock_guard<std::mutex> lock(mutex);
+      if (!value || key != cachedKey) {
+         value = std::make_shared<const T>(compute());
+         cachedKey = key;
+      }
+      return value;
+   }
+
+  private:
+   std::mutex mutex;
+   std::string cachedKey;
+   std::shared_ptr<const T> value;
+};
+
+}  // namespace lve
@@ -6,6 +6,8 @@
 // std
 #include <imgui.h>
 
+#include <algorithm>
+#include <charconv>
 #include <chrono>
 #include <cmath>
 #include <cstdint>
@@ -28,13 +30,16 @@
 #include "../lve/lve_camera.hpp"
 #include "../lve/lve_descriptors.hpp"
 #include "../lve/lve_device.hpp"
+#include "../lve/lve_palette.hpp"
 #include "../lve/lve_swap_chain.hpp"
 #include "../lve/lve_terrain.hpp"
 #include "../lve/colormaps.hpp"
 #include "../movement_controllers/terrain_movement_controller.hpp"
 #include "../systems/gui_system.hpp"
 #include "../systems/terrain_render_system.hpp"
+#include "../systems/wind_particle_system.hpp"
 #include "../systems/wind_render_system.hpp"
+#include "../systems/wind_trace_system.hpp"
 #include "second_app_frame_info.hpp"
 
 // libs
@@ -45,6 +50,27 @@
 
 namespace lve {
 
+namespace {
+
+// Error vertical de TERRAIN_ERROR, entre espacios. Vacío, mal escrito,
+// negativo o no finito vale 0: la grilla completa.
+glm::float32 parseMaxError(const std::string& text) {
+   size_t first = text.find_first_not_of(" \t\r");
+   if (first == std::string::npos) return 0.f;
+   size_t last = text.find_last_not_of(" \t\r") + 1;
+   const char* end = text.data() + last;
+   glm::float32 value = 0.f;
+   auto [ptr, ec] = std::from_chars(text.data() + first, end, value);
+   if (ec != std::errc() || ptr != end || !std::isfinite(value) ||
+       value < 0.f) {
+      std::cerr << "TERRAIN_ERROR inválido: " << text << "\n";
+      return 0.f;
+   }
+   return value;
+}
+
+}  // namespace
+
 SecondApp::SecondApp() {
 }
 
@@ -85,12 +111,33 @@ void SecondApp::run() {
        lveDevice, lveRenderer.getSwapChainRenderPass(),
        globalSetLayout->getDescriptorSetLayout(),
        "shaders/terrain_shader.vert.spv",
-       "shaders/terrain_shader.frag.spv"};
+       "shaders/terrain_raster_shader.vert.spv",
+       "shaders/terrain_shader.frag.spv",
+       "shaders/terrain_cull.comp.spv"};
+
+   // Las líneas y las partículas sólo guardan la velocidad; el color lo
+   // buscan los shaders en esta paleta.
+   LvePalette windPalette{lveDevice, paleta_viento};
 
    WindRenderSystem windRenderSystem{
-       lveDevice, lveRenderer.getSwapChainRenderPass(),
+       lveDevice,
+       lveRenderer.getSwapChainRenderPass(),
+       globalSetLayout->getDescriptorSetLayout(),
+       "shaders/wind_shader.vert.spv",
+       "shaders/wind_shader.frag.spv",
+       windPalette};
+
+   WindTraceSystem windTraceSystem{lveDevice,
+                                   "shaders/wind_trace.comp.spv"};
+
+   WindParticleSystem windParticleSystem{
+       lveDevice,
+       lveRenderer.getSwapChainRenderPass(),
        globalSetLayout->getDescriptorSetLayout(),
-       "shaders/wind_shader.vert.spv", "shaders/wind_shader.frag.spv"};
+       "shaders/wind_particles.vert.spv",
+       "shaders/wind_shader.frag.spv",
+       "shaders/wind_particles.comp.spv",
+       windPalette};
 
    LveCamera camera{};
 
@@ -106,10 +153,24 @@ void SecondApp::run() {
    auto currentTime = std::chrono::high_resolution_clock::now();
    bool caminata = false;
    bool viento = false;
+   // Partículas que sigue el viento, o las líneas trazadas de antemano.
+   bool particulas = true;
+   // Las líneas se trazan en la GPU, o con LveWind::Builder en otro
+   // hilo, espaciadas de manera uniforme.
+   bool lineas_gpu = true;
+   bool lineas_gpu_trazadas = lineas_gpu;
+   // Si las líneas siguen al viento actual.
+   bool lineas_trazadas = false;
+   std::future<LveWind::Builder> lineas_cpu;
+   // Cargas de mapas; las líneas armadas para una anterior se descartan.
+   size_t cargas = 0;
+   size_t lineas_cpu_carga = 0;
 
    std::string new_path = path;
    size_t pipeline = 0;
    int paleta_elegida = paleta_viento;
+   int tipo_pincel = 0;
+   int radio_pincel = 10;
 
    while (!lveWindow.shouldClose()) {
       glfwPollEvents();
@@ -121,8 +182,67 @@ void SecondApp::run() {
               .count();
       currentTime = newTime;
 
+      if (lineas_gpu != lineas_gpu_trazadas) {
+         lineas_gpu_trazadas = lineas_gpu;
+         lineas_trazadas = false;
+      }
+      // Las líneas se trazan recién cuando se muestran.
+      bool trazar =
+          viento && !particulas && !lineas_trazadas && windSource;
+      if (trazar && lineas_gpu) {
+         auto beginTime = std::chrono::high_resolution_clock::now();
+         // Los cuadros en vuelo pueden estar dibujando las anteriores.
+         vkDeviceWaitIdle(lveDevice.device());
+         try {
+            wind = windTraceSystem.trace(*altitudeMap, windSource->speed,
+                                         windSource->min,
+                                         windSource->max);
+         } catch (...) {
+            wind = nullptr;
+         }
+         lineas_trazadas = true;
+         auto endTime = std::chrono::high_resolution_clock::now();
+         float time =
+             std::chrono::duration<float, std::chrono::seconds::period>(
+                 endTime - beginTime)
+                 .count();
+         std::cout << "Wind time: " << time << "\n";
+      } else if (trazar && !lineas_cpu.valid()) {
+         lineas_cpu_carga = cargas;
+         lineas_cpu = std::async(
+             std::launch::async,
+             [altitude = altitudeMap, field = windSource] {
+                auto beginTime = std::chrono::high_resolution_clock::now();
+                LveWind::Builder builder;
+                builder.generateMesh(*altitude, field->speed, field->min,
+                                     field->max);
+                auto endTime = std::chrono::high_resolution_clock::now();
+                float time = std::chrono::duration<
+                                 float, std::chrono::seconds::period>(
+                                 endTime - beginTime)
+                                 .count();
+                std::cout << "Wind time: " << time << "\n";
+                return builder;
+             });
+      }
+      if (lineas_cpu.valid() &&
+          lineas_cpu.wait_for(std::chrono::duration(
+              std::chrono::seconds(0))) == std::future_status::ready) {
+         bool vigentes = !lineas_gpu && lineas_cpu_carga == cargas;
+         try {
+            LveWind::Builder builder = lineas_cpu.get();
+            if (vigentes) {
+               vkDeviceWaitIdle(lveDevice.device());
+               wind = std::make_unique<LveWind>(lveDevice, builder);
+            }
+         } catch (...) {
+            if (vigentes) wind = nullptr;
+         }
+         if (vigentes) lineas_trazadas = true;
+      }
+
       cameraController.moveInPlaneXZ(lveWindow.getGLFWwindow(), frameTime,
-                                     viewerObject, altitudeMap,
+                                     viewerObject, *altitudeMap,
                                      cameraHeight, caminata);
 
       camera.setViewYXZ(viewerObject.transform.translation,
@@ -132,6 +252,7 @@ void SecondApp::run() {
       camera.setPerspectiveProjection(glm::radians(50.f), aspect, 0.1f,
                                       fmax(xn, yn) * 1.8);
 
+      bool pintar = false;
       if (auto commandBuffer = lveRenderer.beginFrame()) {
          int frameIndex = lveRenderer.getFrameIndex();
          FrameInfo frameInfo{frameIndex,
@@ -154,7 +275,17 @@ void SecondApp::run() {
          myimgui.update(cameraController, caminata, new_path, maps, curr,
                         loadingTerrain, pipeline,
                         viewerObject.transform.translation, viento,
-                        paleta_elegida, colormap::paletas());
+                        particulas, lineas_gpu, paleta_elegida,
+                        colormap::paletas());
+         pintar = myimgui.brush(brushNames, tipo_pincel, radio_pincel);
+
+         // compute, antes del render pass
+         if (terrain) {
+            terrainRenderSystem.cullTerrain(frameInfo);
+         }
+         if (viento && particulas) {
+            windParticleSystem.advect(frameInfo);
+         }
 
          // render system
          lveRenderer.beginSwapChainRenderPass(commandBuffer);
@@ -164,7 +295,9 @@ void SecondApp::run() {
                 frameInfo,
                 static_cast<TerrainRenderSystem::PipeLineType>(pipeline));
          }
-         if (wind && viento) {
+         if (viento && particulas) {
+            windParticleSystem.renderParticles(frameInfo);
+         } else if (wind && viento) {
             windRenderSystem.renderWind(frameInfo);
          }
          myimgui.render(commandBuffer);
@@ -173,12 +306,23 @@ void SecondApp::run() {
          lveRenderer.endFrame();
       }
 
+      // Se pinta entre cuadros; update espera a los que están en vuelo.
+      if (pintar && terrain && !loadingTerrain) {
+         try {
+            paintVegetation(viewerObject.transform.translation,
+                            brushTypes[tipo_pincel], radio_pincel);
+         } catch (const std::exception& e) {
+            std::cerr << "No se pudo pintar: " << e.what() << "\n";
+         }
+      }
+
       if (new_path != lastTryedPath && !loadingTerrain) {
          asyncLoadGameObjects(new_path.c_str());
       }
-      if (paleta_viento != paleta_elegida && !loadingTerrain) {
+      // Un cambio de paleta no retraza nada.
+      if (paleta_viento != paleta_elegida) {
          paleta_viento = paleta_elegida;
-         asyncLoadGameObjects(new_path.c_str());
+         windPalette.setColormap(paleta_viento);
       }
 
       if (loadingState.valid() &&
@@ -187,14 +331,35 @@ void SecondApp::run() {
          loadingTerrain = false;
          try {
             NewMap newMap = loadingState.get();
-            altitudeMap = newMap.altittudeMap;
             xn = newMap.xn;
             yn = newMap.yn;
-            terrain = std::make_unique<LveTerrain>(lveDevice,
-                                                   newMap.terrain_builder);
-            fixViewer(viewerObject, cameraHeight);
-            wind =
-                std::make_unique<LveWind>(lveDevice, newMap.wind_builder);
+            altitudeMap = newMap.altittudeMap;
+            // Sin constructor el terreno subido sigue valiendo: un cambio
+            // de paleta no lo rehace.
+            if (newMap.terrain_builder) {
+               terrain = std::make_unique<LveTerrain>(
+                   lveDevice, *newMap.terrain_builder);
+               newMap.terrain_builder.reset();
+               terrainKey = newMap.terrain_key;
+               vegetationMap = std::move(*newMap.vegetation_map);
+               paletSource = nullptr;
+               fixViewer(viewerObject, cameraHeight);
+            }
+            if (newMap.palet_db != paletSource) {
+               paletSource = newMap.palet_db;
+               brushTypes = paletSource->all_types();
+               brushNames.clear();
+               for (glm::int32 type : brushTypes) {
+                  brushNames.push_back(paletSource->color(type).name);
+               }
+               updateTerrainPalette();
+            }
+            const WindField& field = *newMap.wind_field;
+            windParticleSystem.setField(*altitudeMap, field.speed,
+                                        field.min, field.max);
+            windSource = newMap.wind_field;
+            lineas_trazadas = false;
+            ++cargas;
          } catch (...) {
          }
       }
@@ -204,110 +369,129 @@ void SecondApp::run() {
 }
 
 SecondApp::NewMap SecondApp::loadGameObjects(
-    const std::filesystem::path& new_path) {
+    const std::filesystem::path& new_path,
+    const std::string& current_terrain) {
    Lexer::Config config(new_path);
    NewMap newMap;
 
    newMap.yn = std::stoi(config.value("ROWS"));
    newMap.xn = std::stoi(config.value("COLS"));
-   auto altittude_join =
-       std::async(std::launch::async, [&config, &newMap] {
-          Lexer::Ascf altitudeAsc = Lexer::loadf(
-              (config.get_path() / config.value("ELEV_MAP")).c_str());
-          newMap.altittudeMap = altitudeAsc.body;
-          glm::float32 min = NAN;
-          for (std::vector<glm::float32>& row : newMap.altittudeMap) {
-             for (glm::float32& cell : row) {
-                if (cell == altitudeAsc.NODATA_value) {
-                   cell = 0;
-                }
-                glm::float32 alt{cell / altitudeAsc.cellsize};
-                cell = alt;
-                min = min != NAN && min < cell ? min : cell;
-             }
-          }
-          for (std::vector<glm::float32>& row : newMap.altittudeMap) {
-             for (glm::float32& cell : row) {
-                cell -= min;
-             }
-          }
-       });
-   auto terrain_join = std::async(std::launch::async, [&config, &newMap,
-                                                       &altittude_join] {
-      auto beginTime = std::chrono::high_resolution_clock::now();
-      auto vege_join = std::async(std::launch::async, [&config] {
-         Lexer::Asci vegetationAsc = Lexer::loadi(
-             (config.get_path() / config.value("VEGETATION_MAP")).c_str());
-         return vegetationAsc.body;
+
+   // Los mapas demasiado grandes se leen de a bloques y a resolución
+   // reducida, sin llegar a tenerlos completos en memoria.
+   uint32_t factor =
+       (std::max(newMap.xn, newMap.yn) + max_terrain_size - 1) /
+       max_terrain_size;
+   auto loadf = [factor](const std::filesystem::path& asc,
+                         const Lexer::Transform& transform) {
+      return factor > 1 ? Lexer::loadfReduced(asc, factor, transform)
+                        : Lexer::loadf(asc, transform);
+   };
+   auto loadi = [factor](const std::filesystem::path& asc) {
+      return factor > 1 ? Lexer::loadiReduced(asc, factor)
+                        : Lexer::loadi(asc);
+   };
+   if (factor > 1) {
+      newMap.xn = (newMap.xn + factor - 1) / factor;
+      newMap.yn = (newMap.yn + factor - 1) / factor;
+   }
+
+   // Archivos y parámetros de cada capa, más las claves de las que
+   // depende.
+   std::string factor_key = "|" + std::to_string(factor);
+   auto source_key = [&config, &factor_key](const std::string& key) {
+      return fileKey(config.get_path() / config.value(key)) + factor_key;
+   };
+   std::string elevation_key = source_key("ELEV_MAP");
+   std::string vegetation_key = source_key("VEGETATION_MAP");
+   // Error vertical admitido en metros. Sin la clave se dibuja la grilla
+   // completa.
+   std::string max_error = config.value("TERRAIN_ERROR");
+   std::string terrain_key =
+       elevation_key + "|" + vegetation_key + "|" + max_error;
+   std::string palette_key =
+       fileKey(config.get_path() / config.value("PALETA"));
+   std::string wind_field_key =
+       source_key("WIND_MAP") + "|" + source_key("INT_WIND");
+
+   // La pide el terreno y el viento; si llegan a la vez, uno la lee y el
+   // otro espera.
+   auto elevation = [this, &config, &elevation_key, &loadf] {
+      return layers.elevation.get(elevation_key, [&config, &loadf] {
+         // La altura queda en unidades de celda, con NODATA_value en 0.
+         Lexer::Transform transform{.fill_nodata = true,
+                                    .per_cell = true};
+         Lexer::Ascf altitude = loadf(
+             config.get_path() / config.value("ELEV_MAP"), transform);
+         altitude.offset(-altitude.min);
+         return altitude;
       });
-      std::vector<std::vector<glm::vec3>> colorMap;
-      auto paleta_join = std::async(std::launch::async, [&config] {
-         Lexer::PaletDB paletDb{
-             (config.get_path() / config.value("PALETA")).c_str()};
-         return paletDb;
+   };
+   auto terrain_join = std::async(std::launch::async, [&, this] {
+      // Los colores los elige el hilo principal, para los tipos que
+      // tenga el terreno.
+      newMap.palet_db = layers.palet_db.get(palette_key, [&config] {
+         return Lexer::PaletDB(config.get_path() / config.value("PALETA"));
       });
-      std::vector<std::vector<glm::int32>> vegetationMap = vege_join.get();
-      Lexer::PaletDB paletDb = paleta_join.get();
-      for (std::vector<glm::int32> row : vegetationMap) {
-         std::vector<glm::vec3> aux;
-         for (glm::int32 cell : row) {
-            Lexer::PaletDB::Color color = paletDb.color(cell);
-            aux.push_back(color.color);
-         }
-         colorMap.push_back(aux);
-      }
-      altittude_join.wait();
-      newMap.terrain_builder.generateMesh(newMap.altittudeMap, colorMap);
+      if (terrain_key == current_terrain) return;
+
+      auto beginTime = std::chrono::high_resolution_clock::now();
+      auto vege_join = std::async(std::launch::async, [&config, &loadi] {
+         return loadi(config.get_path() / config.value("VEGETATION_MAP"));
+      });
+      std::shared_ptr<const Lexer::Ascf> altitude = elevation();
+      // La vegetación queda para pintarla encima.
+      newMap.vegetation_map =
+          std::make_unique<Lexer::Asci>(vege_join.get());
+      auto builder = std::make_unique<LveTerrain::Builder>();
+      builder->maxError = parseMaxError(max_error);
+      builder->generateRaster(*altitude, *newMap.vegetation_map);
+      // Los colores los pone setPalette con la capa de la paleta.
+      builder->palette.resize(builder->vegetationTypes.size());
       auto endTime = std::chrono::high_resolution_clock::now();
       float time =
           std::chrono::duration<float, std::chrono::seconds::period>(
               endTime - beginTime)
               .count();
       std::cout << "Terrain time: " << time << "\n";
+      newMap.terrain_builder = std::move(builder);
+      newMap.terrain_key = terrain_key;
    });
 
-   auto wind_join = std::async(std::launch::async, [&config, &newMap,
-                                                    &altittude_join,
-                                                    this] {
-      auto beginTime = std::chrono::high_resolution_clock::now();
-      auto dir_join = std::async(std::launch::async, [&config] {
-         return Lexer::loadi(
-                    (config.get_path() / config.value("WIND_MAP")).c_str())
-             .body;
-      });
-      auto vel_join = std::async(std::launch::async, [&config] {
-         return Lexer::loadf(
-                    (config.get_path() / config.value("INT_WIND")).c_str())
-             .body;
-      });
-
-      std::vector<std::vector<glm::int32>> dirViento = dir_join.get();
-      std::vector<std::vector<glm::float32>> velViento = vel_join.get();
-      std::vector<std::vector<glm::vec2>> windSpeed;
-      float min = std::numeric_limits<float>::max();
-      float max = std::numeric_limits<float>::min();
-      for (size_t y = 0; y < dirViento.size(); ++y) {
-         std::vector<glm::vec2> row;
-         for (size_t x = 0; x < dirViento[0].size(); ++x) {
-            float angulo = dirViento[y][x] * glm::two_pi<float>() / 360.f;
-            row.push_back(glm::vec2(glm::cos(angulo), glm::sin(angulo)) *
-                          velViento[y][x]);
-            min = glm::min(min, velViento[y][x]);
-            max = glm::max(max, velViento[y][x]);
+   auto wind_join = std::async(std::launch::async, [&, this] {
+      newMap.wind_field = layers.wind_field.get(wind_field_key, [&, this] {
+         // La dirección y la intensidad sólo sirven para armar el campo.
+         auto dir_join = std::async(std::launch::async, [&] {
+            return loadi(config.get_path() / config.value("WIND_MAP"));
+         });
+         auto vel_join = std::async(std::launch::async, [&] {
+            // Sin dato es viento calmo, no una intensidad de -9999.
+            Lexer::Transform transform{.fill_nodata = true,
+                                       .nodata_fill = 0};
+            return loadf(config.get_path() / config.value("INT_WIND"),
+                         transform);
+         });
+
+         Lexer::Asci dirViento = dir_join.get();
+         Lexer::Ascf velViento = vel_join.get();
+         WindField field;
+         field.speed = Raster<glm::vec2>(dirViento.width(),
+                                         dirViento.height());
+         for (size_t i = 0; i < dirViento.size(); ++i) {
+            float angulo =
+                dirViento.data()[i] * glm::two_pi<float>() / 360.f;
+            float vel = velViento.data()[i];
+            field.speed.data()[i] =
+                glm::vec2(glm::cos(angulo), glm::sin(angulo)) * vel;
          }
-         windSpeed.push_back(row);
-      }
-      altittude_join.wait();
-      newMap.wind_builder.generateMesh(newMap.altittudeMap, windSpeed, min,
-                                       max, paleta_viento);
-      auto endTime = std::chrono::high_resolution_clock::now();
-      float time =
-          std::chrono::duration<float, std::chrono::seconds::period>(
-              endTime - beginTime)
-              .count();
-      std::cout << "Wind time: " << time << "\n";
+         field.min = velViento.min;
+         field.max = velViento.max;
+         return field;
+      });
    });
 
+   newMap.altittudeMap = elevation();
+
    path = new_path;
    std::pair<std::set<std::string>::iterator, bool> insert_result =
        maps.insert(path);
@@ -315,8 +499,10 @@ SecondApp::NewMap SecondApp::loadGameObjects(
       curr = std::distance(maps.begin(), insert_result.first);
    }
 
-   terrain_join.wait();
-   wind_join.wait();
+   // get, para que un error al cargar alguna capa llegue a quien espera
+   // el mapa.
+   terrain_join.get();
+   wind_join.get();
 
    return newMap;
 }
@@ -326,11 +512,51 @@ void SecondApp::asyncLoadGameObjects(
    lastTryedPath = new_path;
    if (std::filesystem::exists(new_path / "config.txt")) {
       loadingState = std::async(
-          std::launch::async, &SecondApp::loadGameObjects, this, new_path);
+          std::launch::async, &SecondApp::loadGameObjects, this, new_path,
+          terrainKey);
       loadingTerrain = true;
    }
 }
 
+void SecondApp::updateTerrainPalette() {
+   if (!terrain || !paletSource) return;
+   std::vector<glm::vec4> palette;
+   for (glm::int32 type : terrain->getVegetationTypes()) {
+      palette.push_back(glm::vec4(paletSource->color(type).color, 1.f));
+   }
+   terrain->setPalette(palette);
+}
+
+void SecondApp::paintVegetation(const glm::vec3& position,
+                                glm::int32 type, uint32_t radius) {
+   int64_t w = vegetationMap.width();
+   int64_t h = vegetationMap.height();
+   if (!w || !h) return;
+   // La misma celda que toma fixViewer bajo el observador.
+   int64_t x = glm::clamp<int64_t>(w - std::lround(position.x), 0, w - 1);
+   int64_t y = glm::clamp<int64_t>(std::lround(position.z), 0, h - 1);
+   int64_t r = radius;
+   LveTerrain::Region region{
+       .x0 = static_cast<uint32_t>(std::max<int64_t>(x - r, 0)),
+       .y0 = static_cast<uint32_t>(std::max<int64_t>(y - r, 0)),
+       .x1 = static_cast<uint32_t>(std::min<int64_t>(x + r + 1, w)),
+       .y1 = static_cast<uint32_t>(std::min<int64_t>(y + r + 1, h)),
+   };
+   for (uint32_t cy = region.y0; cy < region.y1; ++cy) {
+      for (uint32_t cx = region.x0; cx < region.x1; ++cx) {
+         int64_t dx = cx - x;
+         int64_t dy = cy - y;
+         if (dx * dx + dy * dy <= r * r) vegetationMap(cx, cy) = type;
+      }
+   }
+
+   size_t classes = terrain->getVegetationTypes().size();
+   terrain->update(vegetationMap, region);
+   if (terrain->getVegetationTypes().size() != classes) {
+      updateTerrainPalette();
+   }
+}
+
 void SecondApp::fixViewer(LveGameObject& viewerObject,
                           float cameraHeight) {
    viewerObject.transform.translation.x = static_cast<float>(xn - 1) / 2.f;
@@ -343,7 +569,7 @@ void SecondApp::fixViewer(LveGameObject& viewerObject,
                   (uint32_t)0, yn - 1);
    if (xn && yn) {
       viewerObject.transform.translation.y =
-          -cameraHeight - altitudeMap[y][x];
+          -cameraHeight - (*altitudeMap)(x, y);
    }
 }
 
@@ -6,14 +6,19 @@
 #include <future>
 #include <memory>
 #include <set>
+#include <string>
+#include <vector>
 
+#include "../asc_process/Lexer.hpp"
 #include "../lve/lve_descriptors.hpp"
 #include "../lve/lve_device.hpp"
 #include "../lve/lve_game_object.hpp"
+#include "../lve/lve_raster.hpp"
 #include "../lve/lve_renderer.hpp"
 #include "../lve/lve_terrain.hpp"
 #include "../lve/lve_wind.hpp"
 #include "../lve/lve_window.hpp"
+#include "layer_cache.hpp"
 namespace lve {
 
 class SecondApp {
@@ -32,12 +37,23 @@ class SecondApp {
 
    void asyncLoadGameObjects(const std::filesystem::path &);
 
+   // Viento de cada celda y el rango de su intensidad.
+   struct WindField {
+      Raster<glm::vec2> speed;
+      float min = 0.f;
+      float max = 0.f;
+   };
+
    struct NewMap {
       uint32_t yn;
       uint32_t xn;
-      std::vector<std::vector<glm::float32>> altittudeMap;
-      LveTerrain::Builder terrain_builder;
-      LveWind::Builder wind_builder;
+      std::shared_ptr<const Lexer::Ascf> altittudeMap;
+      // Vacíos si el terreno subido sigue valiendo.
+      std::string terrain_key;
+      std::unique_ptr<LveTerrain::Builder> terrain_builder;
+      std::unique_ptr<Lexer::Asci> vegetation_map;
+      std::shared_ptr<const Lexer::PaletDB> palet_db;
+      std::shared_ptr<const WindField> wind_field;
    };
   private:
    LveWindow lveWindow{WIDTH, HEIGHT, "Hello Vulkan!"};
@@ -66,7 +82,14 @@ class SecondApp {
    uint32_t xn = 0;
    uint32_t yn = 0;
 
-   std::vector<std::vector<glm::float32>> altitudeMap = {};
+   // La misma que guarda su capa; nunca es nula.
+   std::shared_ptr<const Lexer::Ascf> altitudeMap =
+       std::make_shared<const Lexer::Ascf>();
+   // Vegetación del terreno actual, con lo que se le pintó encima.
+   Raster<glm::int32> vegetationMap = {};
+   // Tipos de vegetación que se pueden pintar y sus nombres.
+   std::vector<glm::int32> brushTypes = {};
+   std::vector<std::string> brushNames = {};
 
    std::set<std::string> maps = {};
    int curr = 0;
@@ -75,8 +98,28 @@ class SecondApp {
 
    size_t paleta_viento = 10;
 
-   NewMap loadGameObjects(const std::filesystem::path &);
+   // Capas del proyecto, para que una recarga recalcule sólo las que
+   // cambiaron. Ver Layer. Guardan sólo lo que usa el mapa actual.
+   struct Layers {
+      Layer<Lexer::Ascf> elevation;
+      Layer<WindField> wind_field;
+      Layer<Lexer::PaletDB> palet_db;
+   } layers;
+   // Clave del terreno subido; la carga no lo rearma si no cambió.
+   std::string terrainKey;
+   // Paleta y viento actuales.
+   std::shared_ptr<const Lexer::PaletDB> paletSource;
+   std::shared_ptr<const WindField> windSource;
+
+   // Lado máximo, en celdas, del terreno que se arma a resolución
+   // completa.
+   static constexpr uint32_t max_terrain_size = 4096;
+
+   NewMap loadGameObjects(const std::filesystem::path &,
+                          const std::string &);
 
    void fixViewer(LveGameObject &, float);
+   void updateTerrainPalette();
+   void paintVegetation(const glm::vec3 &, glm::int32, uint32_t);
 };
 }  // namespace lve
@@ -1,12 +1,26 @@
 #include "Lexer.hpp"
 
+#include <algorithm>
+#include <charconv>
 #include <cmath>
 #include <cstdint>
 #include <cstdio>
 #include <cstring>
 #include <fstream>
 #include <glm/ext/scalar_int_sized.hpp>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
 #include <string>
+#include <system_error>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include "../lve/lve_utils.hpp"
+#include "MappedFile.hpp"
+#include "RasterCache.hpp"
 
 namespace Lexer {
 
@@ -53,99 +67,516 @@ PaletDB::PaletDB(const std::filesystem::path &path) {
    }
 }
 
-PaletDB::Color PaletDB::color(int32_t type) {
-   uint32_t id = types[type];
-   return layer[id];
+PaletDB::Color PaletDB::color(int32_t type) const {
+   // Un tipo desconocido toma la capa 0, y una capa desconocida sale
+   // negra y sin nombre.
+   auto type_id = types.find(type);
+   uint32_t id = type_id == types.end() ? 0 : type_id->second;
+   auto found = layer.find(id);
+   return found == layer.end() ? Color{} : found->second;
 }
 
-Ascf loadf(const std::filesystem::path &path) {
-   std::ifstream ifile(path);
-   int32_t NODATA_value;
-   int cellsize;
+std::vector<int32_t> PaletDB::all_types() const {
+   std::vector<int32_t> all;
+   for (const auto &[type, id] : types) all.push_back(type);
+   return all;
+}
+
+namespace {
+
+typedef struct {
    uint32_t xn;
    uint32_t yn;
+   int cellsize;
+   int32_t NODATA_value;
+} Header;
+
+bool isBlank(char character) {
+   return character == ' ' || character == '\t' || character == '\r' ||
+          character == '\n';
+}
+
+/**
+ * @brief Procesa las líneas de metadatos del asc en memoria.
+ * @param cursor inicio del archivo, queda apuntando al cuerpo.
+ * @param end fin del archivo.
+ * @return Las dimensiones y los valores especiales del asc.
+ * @throws LexicalError Si se encuentra un token no válido.
+ */
+Header parseHeader(const char *&cursor, const char *end) {
+   Header header{};
    const int meta_data_lines = 6;
-   std::string line;
    for (int i = 0; i < meta_data_lines; ++i) {
-      std::getline(ifile, line);
-      Line pair = parse(line);
+      const char *line_end = std::find(cursor, end, '\n');
+      Line pair = parse(std::string(cursor, line_end));
+      cursor = line_end == end ? end : line_end + 1;
       if (!std::strcmp(pair.name.c_str(), "ncols")) {
-         xn = pair.value;
+         header.xn = pair.value;
          continue;
       }
       if (!std::strcmp(pair.name.c_str(), "nrows")) {
-         yn = pair.value;
+         header.yn = pair.value;
          continue;
       }
       if (!std::strcmp(pair.name.c_str(), "NODATA_value")) {
-         NODATA_value = pair.value;
+         header.NODATA_value = pair.value;
          continue;
       }
       if (!std::strcmp(pair.name.c_str(), "cellsize")) {
-         cellsize = pair.value;
+         header.cellsize = pair.value;
          continue;
       }
    }
-   std::vector<std::vector<glm::float32>> ret = {};
-   for (std::string line; std::getline(ifile, line);) {
-      std::vector<std::string> altitudeMapIn = tokenize(line);
-      std::vector<glm::float32> aux = {};
-      for (int x = 0; x < xn; ++x) {
-         int val = std::stof(altitudeMapIn[x]);
-         aux.push_back(val);
+   return header;
+}
+
+/**
+ * @brief Convierte un número en el lugar, sin copiar el token.
+ * @return Puntero al primer caracter después del token.
+ * @throws LexicalError Si el token no es un número.
+ */
+template <typename T>
+const char *parseNumber(const char *cursor, const char *end, T &value) {
+   if (cursor != end && *cursor == '+') ++cursor;
+   std::from_chars_result result = std::from_chars(cursor, end, value);
+   if (result.ec != std::errc()) {
+      LexicalError e;
+      throw e;
+   }
+   // Igual que stoi/stof, se ignora el resto del token.
+   cursor = result.ptr;
+   while (cursor != end && !isBlank(*cursor)) ++cursor;
+   return cursor;
+}
+
+/**
+ * @brief Procesa una fila del cuerpo del asc.
+ * @param cursor inicio de la fila, sin blancos previos.
+ * @param out destino de los xn valores de la fila.
+ * @return Puntero al inicio de la línea siguiente.
+ * @throws LexicalError Si la fila tiene menos de xn valores o un token
+ * no válido.
+ */
+template <typename T>
+const char *parseRow(const char *cursor, const char *end, T *out,
+                     uint32_t xn) {
+   for (uint32_t x = 0; x < xn; ++x) {
+      while (cursor != end && (*cursor == ' ' || *cursor == '\t' ||
+                               *cursor == '\r')) {
+         ++cursor;
       }
-      ret.push_back(aux);
+      if (cursor == end || *cursor == '\n') {
+         LexicalError e;
+         throw e;
+      }
+      cursor = parseNumber(cursor, end, out[x]);
    }
-   return Ascf{
-       .cellsize = cellsize,
-       .NODATA_value = NODATA_value,
-       .body = ret,
-   };
+   const char *line_end = std::find(cursor, end, '\n');
+   return line_end == end ? end : line_end + 1;
 }
 
-Asci loadi(const std::filesystem::path &path) {
-   std::ifstream ifile(path);
-   int32_t NODATA_value;
-   int cellsize;
-   uint32_t xn;
-   uint32_t yn;
+/**
+ * @brief Cuenta las filas no vacías entre cursor y end.
+ */
+size_t countRows(const char *cursor, const char *end) {
+   size_t rows = 0;
+   while (cursor != end) {
+      const char *line_end = std::find(cursor, end, '\n');
+      if (std::find_if_not(cursor, line_end, isBlank) != line_end) {
+         ++rows;
+      }
+      cursor = line_end == end ? end : line_end + 1;
+   }
+   return rows;
+}
+
+/**
+ * @brief Divide el cuerpo en rangos de bytes que empiezan a principio de
+ * línea.
+ * @return chunks + 1 límites; el rango i es [ret[i], ret[i + 1]).
+ */
+std::vector<const char *> splitLines(const char *begin, const char *end,
+                                     size_t chunks) {
+   std::vector<const char *> bounds{begin};
+   size_t bytes = end - begin;
+   for (size_t i = 1; i < chunks; ++i) {
+      const char *split =
+          std::max(begin + bytes * i / chunks, bounds.back());
+      const char *line_end = std::find(split, end, '\n');
+      bounds.push_back(line_end == end ? end : line_end + 1);
+   }
+   bounds.push_back(end);
+   return bounds;
+}
+
+/**
+ * @brief Aplica un Transform a cada fila recién procesada, mientras
+ * todavía está en caché, y acumula el rango de los valores.
+ */
+class CellPass {
+  public:
+   CellPass(const Transform &transform, int cellsize, int32_t NODATA_value)
+       : transform(transform),
+         nodata(static_cast<glm::float32>(NODATA_value)),
+         scale(transform.per_cell ? static_cast<glm::float32>(cellsize)
+                                  : 1.f) {
+   }
+
+   void operator()(glm::float32 *row, uint32_t xn) {
+      for (uint32_t x = 0; x < xn; ++x) {
+         glm::float32 cell = row[x];
+         if (cell == nodata) {
+            if (!transform.fill_nodata) continue;
+            cell = transform.nodata_fill;
+         }
+         cell /= scale;
+         row[x] = cell;
+         min = std::min(min, cell);
+         max = std::max(max, cell);
+      }
+   }
+
+   void merge(const CellPass &other) {
+      min = std::min(min, other.min);
+      max = std::max(max, other.max);
+   }
+
+   void store(Ascf &raster) const {
+      if (min <= max) {
+         raster.min = min;
+         raster.max = max;
+      }
+   }
+
+  private:
+   Transform transform;
+   glm::float32 nodata;
+   glm::float32 scale;
+   glm::float32 min = std::numeric_limits<glm::float32>::infinity();
+   glm::float32 max = -std::numeric_limits<glm::float32>::infinity();
+};
+
+/**
+ * @brief Pasada vacía para los rasters que se usan tal como vienen.
+ */
+class NoPass {
+  public:
+   void operator()(glm::int32 *, uint32_t) {
+   }
+   void merge(const NoPass &) {
+   }
+};
+
+/**
+ * @brief Procesa las filas de un rango a partir de la fila y.
+ * @param pass se aplica a cada fila apenas se procesa.
+ * @return La fila siguiente a la última procesada.
+ */
+template <typename T, typename Pass>
+uint32_t parseRows(const char *cursor, const char *end,
+                   lve::Raster<T> &raster, uint32_t y, Pass &pass) {
+   while (y < raster.height()) {
+      while (cursor != end && isBlank(*cursor)) ++cursor;
+      if (cursor == end) break;
+      T *row = raster.row(y).data();
+      cursor = parseRow(cursor, end, row, raster.width());
+      pass(row, raster.width());
+      ++y;
+   }
+   return y;
+}
+
+// Por debajo de este tamaño no vale la pena repartir el cuerpo entre
+// hilos.
+constexpr size_t min_chunk_bytes = 1 << 20;
+
+template <typename T, typename Pass>
+lve::Raster<T> parseBody(const char *cursor, const char *end,
+                         const Header &header, unsigned threads,
+                         Pass &pass) {
+   uint32_t yn = header.yn;
+   lve::Raster<T> ret(header.xn, yn);
+   ret.cellsize = header.cellsize;
+   ret.NODATA_value = header.NODATA_value;
+   size_t chunks = std::min<size_t>(
+       lve::workerCount(threads),
+       std::max<size_t>(1, (end - cursor) / min_chunk_bytes));
+   if (chunks == 1) {
+      if (parseRows(cursor, end, ret, 0, pass) < yn) {
+         LexicalError e;
+         throw e;
+      }
+      return ret;
+   }
+
+   // Cada hilo cuenta las filas de su rango para saber dónde empieza el
+   // siguiente, y después procesa las suyas directamente en su lugar.
+   std::vector<const char *> bounds = splitLines(cursor, end, chunks);
+   std::vector<size_t> first_row(chunks + 1, 0);
+   lve::parallelFor(chunks, chunks, [&](size_t first, size_t last) {
+      for (size_t i = first; i < last; ++i) {
+         first_row[i + 1] = countRows(bounds[i], bounds[i + 1]);
+      }
+   });
+   std::partial_sum(first_row.begin(), first_row.end(),
+                    first_row.begin());
+   if (first_row.back() < yn) {
+      LexicalError e;
+      throw e;
+   }
+   std::vector<Pass> passes(chunks, pass);
+   lve::parallelFor(chunks, chunks, [&](size_t first, size_t last) {
+      for (size_t i = first; i < last && first_row[i] < yn; ++i) {
+         parseRows(bounds[i], bounds[i + 1], ret, first_row[i], passes[i]);
+      }
+   });
+   for (const Pass &chunk_pass : passes) {
+      pass.merge(chunk_pass);
+   }
+   return ret;
+}
+
+}  // namespace
+
+Ascf::Ascf(lve::Raster<glm::float32> &&raster)
+    : lve::Raster<glm::float32>(std::move(raster)) {
+}
+
+void Ascf::offset(glm::float32 delta) {
+   glm::float32 *cell = data();
+   glm::float32 *last = cell + size();
+#if defined(__SSE2__)
+   __m128 step = _mm_set1_ps(delta);
+   for (; cell + 4 <= last; cell += 4) {
+      _mm_storeu_ps(cell, _mm_add_ps(_mm_loadu_ps(cell), step));
+   }
+#endif
+   for (; cell != last; ++cell) {
+      *cell += delta;
+   }
+   min += delta;
+   max += delta;
+}
+
+Ascf loadf(const std::filesystem::path &path, const Transform &transform,
+           unsigned threads) {
+   Ascf ret;
+   // Antes de leer el .asc, ver sourceStamp.
+   SourceStamp stamp = sourceStamp(path);
+   if (readCache(path, stamp, transform, ret)) return ret;
+   MappedFile file(path);
+   const char *cursor = file.begin();
+   Header header = parseHeader(cursor, file.end());
+   CellPass pass(transform, header.cellsize, header.NODATA_value);
+   ret = parseBody<glm::float32>(cursor, file.end(), header, threads,
+                                 pass);
+   pass.store(ret);
+   writeCache(path, stamp, transform, ret);
+   return ret;
+}
+
+Asci loadi(const std::filesystem::path &path, unsigned threads) {
+   Asci ret;
+   SourceStamp stamp = sourceStamp(path);
+   if (readCache(path, stamp, ret)) return ret;
+   MappedFile file(path);
+   const char *cursor = file.begin();
+   Header header = parseHeader(cursor, file.end());
+   NoPass pass;
+   ret = parseBody<glm::int32>(cursor, file.end(), header, threads, pass);
+   writeCache(path, stamp, ret);
+   return ret;
+}
+
+AscReader::AscReader(const std::filesystem::path &path, size_t budget)
+    : path(path), budget(budget) {
+   std::ifstream ifile(path, std::ios::binary);
+   if (!ifile) {
+      throw std::runtime_error("failed to open file: " + path.string());
+   }
+   std::string text;
    const int meta_data_lines = 6;
-   std::string line;
    for (int i = 0; i < meta_data_lines; ++i) {
+      std::string line;
       std::getline(ifile, line);
-      Line pair = parse(line);
-      if (!std::strcmp(pair.name.c_str(), "ncols")) {
-         xn = pair.value;
-         continue;
+      text += line + '\n';
+   }
+   const char *cursor = text.data();
+   Header header = parseHeader(cursor, text.data() + text.size());
+   xn = header.xn;
+   yn = header.yn;
+   cell_size = header.cellsize;
+   nodata = header.NODATA_value;
+}
+
+uint32_t AscReader::width() const {
+   return xn;
+}
+
+uint32_t AscReader::height() const {
+   return yn;
+}
+
+int AscReader::cellsize() const {
+   return cell_size;
+}
+
+int32_t AscReader::NODATA_value() const {
+   return nodata;
+}
+
+void AscReader::readf(
+    const std::function<void(uint32_t, const Block<glm::float32> &)> &fn)
+    const {
+   read<glm::float32>(fn);
+}
+
+void AscReader::readi(
+    const std::function<void(uint32_t, const Block<glm::int32> &)> &fn)
+    const {
+   read<glm::int32>(fn);
+}
+
+template <typename T>
+void AscReader::read(
+    const std::function<void(uint32_t, const Block<T> &)> &fn) const {
+   std::ifstream ifile(path, std::ios::binary);
+   if (!ifile) {
+      throw std::runtime_error("failed to open file: " + path.string());
+   }
+   // La mitad del presupuesto es para el texto y la otra mitad para el
+   // bloque de filas ya procesadas.
+   const size_t min_buffer = 1 << 16;
+   std::vector<char> buffer(std::max(min_buffer, budget / 2));
+   size_t row_bytes = std::max<size_t>(1, xn) * sizeof(T);
+   uint32_t block_rows = static_cast<uint32_t>(std::clamp<size_t>(
+       budget / 2 / row_bytes, 1, std::max<uint32_t>(1, yn)));
+   Block<T> block;
+
+   bool header_done = false;
+   size_t filled = 0;
+   uint32_t y = 0;
+   uint32_t in_block = 0;
+   while (y < yn) {
+      ifile.read(buffer.data() + filled, buffer.size() - filled);
+      filled += ifile.gcount();
+      bool eof = !ifile;
+      const char *cursor = buffer.data();
+      const char *end = cursor + filled;
+      if (!header_done) {
+         parseHeader(cursor, end);
+         header_done = true;
       }
-      if (!std::strcmp(pair.name.c_str(), "nrows")) {
-         yn = pair.value;
-         continue;
+
+      // Sólo se procesan líneas completas, salvo al final del archivo.
+      const char *last = end;
+      if (!eof) {
+         while (last != cursor && last[-1] != '\n') --last;
       }
-      if (!std::strcmp(pair.name.c_str(), "NODATA_value")) {
-         NODATA_value = pair.value;
+      if (last == cursor && !eof) {
+         // Una fila no entra en el buffer. Lo ya procesado (el
+         // encabezado, en la primera lectura) se descarta antes de
+         // agrandarlo, si no se volvería a leer como cuerpo.
+         filled = end - cursor;
+         std::memmove(buffer.data(), cursor, filled);
+         buffer.resize(buffer.size() * 2);
          continue;
       }
-      if (!std::strcmp(pair.name.c_str(), "cellsize")) {
-         cellsize = pair.value;
-         continue;
+
+      while (y < yn) {
+         while (cursor != last && isBlank(*cursor)) ++cursor;
+         if (cursor == last) break;
+         if (!in_block) {
+            uint32_t rows = std::min(block_rows, yn - y);
+            if (block.height() != rows) {
+               block = Block<T>(xn, rows);
+               block.cellsize = cell_size;
+               block.NODATA_value = nodata;
+            }
+         }
+         cursor = parseRow(cursor, last, block.row(in_block).data(), xn);
+         ++in_block;
+         ++y;
+         if (in_block == block.height()) {
+            fn(y - in_block, block);
+            in_block = 0;
+         }
       }
+
+      filled = end - cursor;
+      std::memmove(buffer.data(), cursor, filled);
+      if (eof) break;
    }
-   std::vector<std::vector<glm::int32>> ret = {};
-   for (std::string line; std::getline(ifile, line);) {
-      std::vector<std::string> altitudeMapIn = tokenize(line);
-      std::vector<glm::int32> aux = {};
-      for (int x = 0; x < xn; ++x) {
-         int val = std::stoi(altitudeMapIn[x]);
-         aux.push_back(val);
-      }
-      ret.push_back(aux);
-   }
-   return Asci{
-       .cellsize = cellsize,
-       .NODATA_value = NODATA_value,
-       .body = ret,
-   };
+   if (y < yn) {
+      LexicalError e;
+      throw e;
+   }
+}
+
+Ascf loadfReduced(const std::filesystem::path &path, uint32_t factor,
+                  const Transform &transform) {
+   AscReader reader(path);
+   factor = std::max(1u, factor);
+   uint32_t xn = reader.width();
+   uint32_t yn = reader.height();
+   Ascf ret((xn + factor - 1) / factor, (yn + factor - 1) / factor);
+   ret.cellsize = reader.cellsize() * factor;
+   ret.NODATA_value = reader.NODATA_value();
+   const glm::float32 nodata = reader.NODATA_value();
+   CellPass pass(transform, ret.cellsize, ret.NODATA_value);
+
+   // Se acumula una fila del resultado a la vez.
+   std::vector<double> sum(ret.width(), 0.);
+   std::vector<uint32_t> count(ret.width(), 0);
+   reader.readf([&](uint32_t first,
+                    const AscReader::Block<glm::float32> &block) {
+      for (uint32_t row = 0; row < block.height(); ++row) {
+         uint32_t y = first + row;
+         lve::Raster<glm::float32>::Span<const glm::float32> cells =
+             block.row(row);
+         for (uint32_t x = 0; x < xn; ++x) {
+            if (cells[x] == nodata) continue;
+            sum[x / factor] += cells[x];
+            ++count[x / factor];
+         }
+         if ((y + 1) % factor && y + 1 != yn) continue;
+         lve::Raster<glm::float32>::Span<glm::float32> out =
+             ret.row(y / factor);
+         for (uint32_t x = 0; x < ret.width(); ++x) {
+            out[x] = count[x] ? sum[x] / count[x] : nodata;
+         }
+         pass(out.data(), ret.width());
+         std::fill(sum.begin(), sum.end(), 0.);
+         std::fill(count.begin(), count.end(), 0);
+      }
+   });
+   pass.store(ret);
+   return ret;
+}
+
+Asci loadiReduced(const std::filesystem::path &path, uint32_t factor) {
+   AscReader reader(path);
+   factor = std::max(1u, factor);
+   uint32_t xn = reader.width();
+   uint32_t yn = reader.height();
+   Asci ret((xn + factor - 1) / factor, (yn + factor - 1) / factor);
+   ret.cellsize = reader.cellsize() * factor;
+   ret.NODATA_value = reader.NODATA_value();
+   reader.readi([&](uint32_t first,
+                    const AscReader::Block<glm::int32> &block) {
+      for (uint32_t row = 0; row < block.height(); ++row) {
+         uint32_t y = first + row;
+         if (y % factor) continue;
+         lve::Raster<glm::int32>::Span<const glm::int32> cells =
+             block.row(row);
+         lve::Raster<glm::int32>::Span<glm::int32> out =
+             ret.row(y / factor);
+         for (uint32_t x = 0; x < ret.width(); ++x) {
+            out[x] = cells[x * factor];
+         }
+      }
+   });
+   return ret;
 }
 
 Line parse(std::string line) {
@@ -1,7 +1,9 @@
 #pragma once
+#include <cmath>
 #include <cstdint>
 #include <cstdlib>
 #include <filesystem>
+#include <functional>
 #include <glm/fwd.hpp>
 #include <map>
 #include <string>
@@ -12,6 +14,8 @@
 #include <glm/glm.hpp>
 #include <glm/gtc/constants.hpp>
 
+#include "../lve/lve_raster.hpp"
+
 namespace Lexer {
 
 class Config {
@@ -35,40 +39,166 @@ class PaletDB {
 
    PaletDB(const std::filesystem::path &path);
 
-   Color color(int32_t type);
+   Color color(int32_t type) const;
+   // Tipos de vegetación de la paleta, en orden.
+   std::vector<int32_t> all_types() const;
 
   private:
    std::map<int32_t, uint32_t> types = {};
    std::map<uint32_t, Color> layer = {};
 };
 
+/**
+ * @brief Raster de float32 junto con el rango de sus valores.
+ */
+class Ascf : public lve::Raster<glm::float32> {
+  public:
+   using lve::Raster<glm::float32>::Raster;
+   Ascf() = default;
+   Ascf(lve::Raster<glm::float32> &&raster);
+
+   /**
+    * @brief Suma delta a todas las celdas y actualiza min y max.
+    */
+   void offset(glm::float32 delta);
+
+   // Menor y mayor valor, sin contar las celdas NODATA_value. NAN si
+   // no hay ninguna celda válida.
+   glm::float32 min = NAN;
+   glm::float32 max = NAN;
+};
+
+/**
+ * @brief Ajustes que se aplican a cada celda mientras se procesa un .asc,
+ * en el mismo recorrido que calcula el rango.
+ */
 typedef struct {
-   int cellsize;
-   int32_t NODATA_value;
-   std::vector<std::vector<glm::float32>> body;
-} Ascf;
+   // Reemplaza las celdas NODATA_value por nodata_fill.
+   bool fill_nodata = false;
+   glm::float32 nodata_fill = 0;
+   // Divide cada celda por cellsize, para llevarla a unidades de celda.
+   bool per_cell = false;
+} Transform;
 
 /**
  * @brief Procesa un archivo .asc y devuelve una matriz de float32.
  * @param path al archivo que se quiere procesar.
- * @return Una matriz de ncols x nrow con el cuerpo del .asc.
+ * @param transform ajustes que se aplican a cada celda.
+ * @param threads cantidad de hilos para procesar el cuerpo, 0 usa todos
+ * los núcleos.
+ * @return Un raster de ncols x nrows con el cuerpo del .asc.
+ * @note Usa y escribe un caché binario junto al .asc, ver readCache.
  * @throws LexicalError Si se encuentra un token no válido.
+ * @throws std::runtime_error Si el archivo no se puede abrir.
  */
-Ascf loadf(const std::filesystem::path &path);
+Ascf loadf(const std::filesystem::path &path,
+           const Transform &transform = {}, unsigned threads = 0);
 
-typedef struct {
-   int cellsize;
-   int32_t NODATA_value;
-   std::vector<std::vector<glm::int32>> body;
-} Asci;
+typedef lve::Raster<glm::int32> Asci;
 
 /**
  * @brief Procesa un archivo .asc y devuelve una matriz de int32.
  * @param path al archivo que se quiere prcesar.
- * @return Una matriz de ncols x nrow con el cuerpo del .asc.
+ * @param threads cantidad de hilos para procesar el cuerpo, 0 usa todos
+ * los núcleos.
+ * @return Un raster de ncols x nrows con el cuerpo del .asc.
+ * @note Usa y escribe un caché binario junto al .asc, ver readCache.
+ * @throws LexicalError Si se encuentra un token no válido.
+ * @throws std::runtime_error Si el archivo no se puede abrir.
+ */
+Asci loadi(const std::filesystem::path &path, unsigned threads = 0);
+
+/**
+ * @brief Lector secuencial de un .asc con memoria acotada: el cuerpo se
+ * entrega en bloques de filas consecutivas.
+ */
+class AscReader {
+  public:
+   template <typename T>
+   using Block = lve::Raster<T>;
+
+   /**
+    * @brief Abre el .asc y procesa sus metadatos.
+    * @param path al archivo que se quiere procesar.
+    * @param budget bytes de memoria que puede usar el lector, repartidos
+    * entre el texto leído y el bloque de filas.
+    * @throws LexicalError Si se encuentra un token no válido.
+    * @throws std::runtime_error Si el archivo no se puede abrir.
+    */
+   AscReader(const std::filesystem::path &path,
+             size_t budget = default_budget);
+
+   uint32_t width() const;
+   uint32_t height() const;
+   int cellsize() const;
+   int32_t NODATA_value() const;
+
+   /**
+    * @brief Recorre el cuerpo del .asc como float32.
+    * @param fn se llama con la primera fila de cada bloque y el bloque,
+    * que sólo es válido durante la llamada.
+    * @throws LexicalError Si se encuentra un token no válido.
+    * @throws std::runtime_error Si el archivo no se puede abrir.
+    */
+   void readf(
+       const std::function<void(uint32_t, const Block<glm::float32> &)>
+           &fn) const;
+
+   /**
+    * @brief Recorre el cuerpo del .asc como int32.
+    * @param fn se llama con la primera fila de cada bloque y el bloque,
+    * que sólo es válido durante la llamada.
+    * @throws LexicalError Si se encuentra un token no válido.
+    * @throws std::runtime_error Si el archivo no se puede abrir.
+    */
+   void readi(
+       const std::function<void(uint32_t, const Block<glm::int32> &)> &fn)
+       const;
+
+   static constexpr size_t default_budget = 64 << 20;
+
+  private:
+   template <typename T>
+   void read(
+       const std::function<void(uint32_t, const Block<T> &)> &fn) const;
+
+   std::filesystem::path path;
+   size_t budget;
+   uint32_t xn = 0;
+   uint32_t yn = 0;
+   int cell_size = 1;
+   int32_t nodata = -9999;
+};
+
+/**
+ * @brief Procesa un .asc a resolución reducida, sin cargarlo completo.
+ *
+ * Cada celda del resultado es el promedio de un bloque de factor x factor
+ * celdas del original, sin contar las celdas NODATA_value.
+ * @param path al archivo que se quiere procesar.
+ * @param factor cantidad de celdas del original por lado de cada celda.
+ * @param transform ajustes que se aplican a cada celda del resultado.
+ * @return Un raster de ceil(ncols / factor) x ceil(nrows / factor), con
+ * cellsize multiplicado por factor.
+ * @throws LexicalError Si se encuentra un token no válido.
+ * @throws std::runtime_error Si el archivo no se puede abrir.
+ */
+Ascf loadfReduced(const std::filesystem::path &path, uint32_t factor,
+                  const Transform &transform = {});
+
+/**
+ * @brief Procesa un .asc a resolución reducida, sin cargarlo completo.
+ *
+ * Los valores enteros son categorías, así que en lugar de promediar se
+ * toma la primera celda de cada bloque de factor x factor.
+ * @param path al archivo que se quiere procesar.
+ * @param factor cantidad de celdas del original por lado de cada celda.
+ * @return Un raster de ceil(ncols / factor) x ceil(nrows / factor), con
+ * cellsize multiplicado por factor.
  * @throws LexicalError Si se encuentra un token no válido.
+ * @throws std::runtime_error Si el archivo no se puede abrir.
  */
-Asci loadi(const std::filesystem::path &path);
+Asci loadiReduced(const std::filesystem::path &path, uint32_t factor);
 
 typedef struct {
    std::string name;
@@ -0,0 +1,62 @@
+#include "MappedFile.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <stdexcept>
+#include <utility>
+
+namespace Lexer {
+
+MappedFile::MappedFile(const std::filesystem::path &path) {
+   int fd = open(path.c_str(), O_RDONLY);
+   if (fd < 0) {
+      throw std::runtime_error("failed to open file: " + path.string());
+   }
+   struct stat info;
+   if (fstat(fd, &info) < 0) {
+      close(fd);
+      throw std::runtime_error("failed to stat file: " + path.string());
+   }
+   length = static_cast<size_t>(info.st_size);
+   if (length) {
+      void *mapped = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (mapped == MAP_FAILED) {
+         close(fd);
+         throw std::runtime_error("failed to map file: " + path.string());
+      }
+      madvise(mapped, length, MADV_SEQUENTIAL);
+      data = static_cast<const char *>(mapped);
+   }
+   close(fd);
+}
+
+MappedFile::~MappedFile() {
+   release();
+}
+
+MappedFile::MappedFile(MappedFile &&other) noexcept
+    : data(std::exchange(other.data, nullptr)),
+      length(std::exchange(other.length, 0)) {
+}
+
+MappedFile &MappedFile::operator=(MappedFile &&other) noexcept {
+   if (this != &other) {
+      release();
+      data = std::exchange(other.data, nullptr);
+      length = std::exchange(other.length, 0);
+   }
+   return *this;
+}
+
+void MappedFile::release() {
+   if (data) {
+      munmap(const_cast<char *>(data), length);
+   }
+   data = nullptr;
+   length = 0;
+}
+
+}  // namespace Lexer
@@ -0,0 +1,45 @@
+#pragma once
+#include <cstddef>
+#include <filesystem>
+
+namespace Lexer {
+
+/**
+ * @brief Proyección de solo lectura de un archivo completo en memoria.
+ *
+ * El contenido se accede en el lugar, sin copiarlo a buffers
+ * intermedios. La proyección se libera al destruir el objeto.
+ */
+class MappedFile {
+  public:
+   /**
+    * @brief Proyecta el archivo indicado en memoria.
+    * @param path al archivo que se quiere proyectar.
+    * @throws std::runtime_error Si el archivo no se puede abrir.
+    */
+   MappedFile(const std::filesystem::path &path);
+   ~MappedFile();
+
+   MappedFile(const MappedFile &) = delete;
+   MappedFile &operator=(const MappedFile &) = delete;
+   MappedFile(MappedFile &&other) noexcept;
+   MappedFile &operator=(MappedFile &&other) noexcept;
+
+   const char *begin() const {
+      return data;
+   }
+   const char *end() const {
+      return data + length;
+   }
+   size_t size() const {
+      return length;
+   }
+
+  private:
+   void release();
+
+   const char *data = nullptr;
+   size_t length = 0;
+};
+
+};  // namespace Lexer
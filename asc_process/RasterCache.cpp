@@ -0,0 +1,219 @@
+#include "RasterCache.hpp"
+
+#include <unistd.h>
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <utility>
+
+#include "MappedFile.hpp"
+
+namespace Lexer {
+
+namespace {
+
+constexpr char cache_magic[4] = {'L', 'V', 'R', 'C'};
+constexpr uint32_t cache_version = 2;
+
+enum class CellType : uint32_t {
+   float32 = 1,
+   int32 = 2,
+};
+
+template <typename T>
+constexpr CellType cellType();
+
+template <>
+constexpr CellType cellType<glm::float32>() {
+   return CellType::float32;
+}
+
+template <>
+constexpr CellType cellType<glm::int32>() {
+   return CellType::int32;
+}
+
+/**
+ * @brief Ruta del caché de un .asc, en el mismo directorio. Cada tipo de
+ * dato tiene su propio caché, porque el mismo .asc se puede leer de las
+ * dos formas.
+ */
+template <typename T>
+std::filesystem::path cachePath(const std::filesystem::path &source) {
+   std::filesystem::path ret = source;
+   ret += cellType<T>() == CellType::float32 ? ".f32.lvr" : ".i32.lvr";
+   return ret;
+}
+
+/**
+ * @brief Cabecera del caché, seguida de width * height celdas crudas en
+ * little-endian. Las celdas se guardan ya transformadas, así que el
+ * Transform con el que se procesó el .asc es parte de la clave.
+ */
+typedef struct {
+   char magic[4];
+   uint32_t version;
+   CellType type;
+   uint32_t width;
+   uint32_t height;
+   int32_t cellsize;
+   int32_t NODATA_value;
+   uint32_t fill_nodata;
+   glm::float32 nodata_fill;
+   uint32_t per_cell;
+   glm::float32 min;
+   glm::float32 max;
+   int64_t source_mtime;
+   uint64_t source_size;
+} CacheHeader;
+
+bool sameTransform(const CacheHeader &header, const Transform &transform) {
+   return header.fill_nodata == transform.fill_nodata &&
+          header.nodata_fill == transform.nodata_fill &&
+          header.per_cell == transform.per_cell;
+}
+
+void storeStats(Ascf &raster, const CacheHeader &header) {
+   raster.min = header.min;
+   raster.max = header.max;
+}
+
+void storeStats(Asci &, const CacheHeader &) {
+}
+
+void loadStats(CacheHeader &header, const Ascf &raster) {
+   header.min = raster.min;
+   header.max = raster.max;
+}
+
+void loadStats(CacheHeader &, const Asci &) {
+}
+
+// El contenido se escribe tal cual está en memoria.
+constexpr bool little_endian = __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__;
+
+template <typename T, typename R>
+bool readRaster(const std::filesystem::path &source,
+                const SourceStamp &stamp, const Transform &transform,
+                R &raster) {
+   if (!little_endian || !stamp.valid) return false;
+   std::filesystem::path cache = cachePath<T>(source);
+   std::error_code ec;
+   if (!std::filesystem::is_regular_file(cache, ec)) return false;
+   try {
+      MappedFile file(cache);
+      CacheHeader header;
+      if (file.size() < sizeof(header)) return false;
+      std::memcpy(&header, file.begin(), sizeof(header));
+      if (std::memcmp(header.magic, cache_magic, sizeof(cache_magic)) ||
+          header.version != cache_version ||
+          header.type != cellType<T>() ||
+          header.source_mtime != stamp.mtime ||
+          header.source_size != stamp.size ||
+          !sameTransform(header, transform)) {
+         return false;
+      }
+      size_t cells = static_cast<size_t>(header.width) * header.height;
+      if (file.size() != sizeof(header) + cells * sizeof(T)) return false;
+      R ret(header.width, header.height);
+      ret.cellsize = header.cellsize;
+      ret.NODATA_value = header.NODATA_value;
+      storeStats(ret, header);
+      std::memcpy(ret.data(), file.begin() + sizeof(header),
+                  cells * sizeof(T));
+      raster = std::move(ret);
+      return true;
+   } catch (const std::runtime_error &) {
+      return false;
+   }
+}
+
+template <typename T, typename R>
+void writeRaster(const std::filesystem::path &source,
+                 const SourceStamp &stamp, const Transform &transform,
+                 const R &raster) {
+   if (!little_endian || !stamp.valid) return;
+   CacheHeader header{};
+   std::memcpy(header.magic, cache_magic, sizeof(cache_magic));
+   header.version = cache_version;
+   header.type = cellType<T>();
+   header.width = raster.width();
+   header.height = raster.height();
+   header.cellsize = raster.cellsize;
+   header.NODATA_value = raster.NODATA_value;
+   header.fill_nodata = transform.fill_nodata;
+   header.nodata_fill = transform.nodata_fill;
+   header.per_cell = transform.per_cell;
+   loadStats(header, raster);
+   header.source_mtime = stamp.mtime;
+   header.source_size = stamp.size;
+
+   // Se escribe a un temporal y se renombra, para que nunca se lea un
+   // caché a medio escribir. El temporal es propio de este proceso e
+   // hilo: dos cargas del mismo .asc no se pisan, gana la última.
+   std::filesystem::path cache = cachePath<T>(source);
+   std::filesystem::path tmp = cache;
+   tmp += ".tmp." + std::to_string(getpid()) + "." +
+          std::to_string(std::hash<std::thread::id>{}(
+              std::this_thread::get_id()));
+   std::error_code ec;
+   {
+      std::ofstream ofile(tmp, std::ios::binary | std::ios::trunc);
+      ofile.write(reinterpret_cast<const char *>(&header), sizeof(header));
+      ofile.write(reinterpret_cast<const char *>(raster.data()),
+                  raster.size() * sizeof(T));
+      if (!ofile) {
+         ofile.close();
+         std::filesystem::remove(tmp, ec);
+         return;
+      }
+   }
+   std::filesystem::rename(tmp, cache, ec);
+   if (ec) std::filesystem::remove(tmp, ec);
+}
+
+}  // namespace
+
+SourceStamp sourceStamp(const std::filesystem::path &source) {
+   SourceStamp stamp;
+   std::error_code ec;
+   std::filesystem::file_time_type time =
+       std::filesystem::last_write_time(source, ec);
+   if (ec) return stamp;
+   uintmax_t bytes = std::filesystem::file_size(source, ec);
+   if (ec) return stamp;
+   stamp.mtime = time.time_since_epoch().count();
+   stamp.size = bytes;
+   stamp.valid = true;
+   return stamp;
+}
+
+bool readCache(const std::filesystem::path &source,
+               const SourceStamp &stamp, const Transform &transform,
+               Ascf &raster) {
+   return readRaster<glm::float32>(source, stamp, transform, raster);
+}
+
+bool readCache(const std::filesystem::path &source,
+               const SourceStamp &stamp, Asci &raster) {
+   return readRaster<glm::int32>(source, stamp, Transform{}, raster);
+}
+
+void writeCache(const std::filesystem::path &source,
+                const SourceStamp &stamp, const Transform &transform,
+                const Ascf &raster) {
+   writeRaster<glm::float32>(source, stamp, transform, raster);
+}
+
+void writeCache(const std::filesystem::path &source,
+                const SourceStamp &stamp, const Asci &raster) {
+   writeRaster<glm::int32>(source, stamp, Transform{}, raster);
+}
+
+}  // namespace Lexer
@@ -0,0 +1,53 @@
+#pragma once
+#include <cstdint>
+#include <filesystem>
+
+#include "Lexer.hpp"
+
+namespace Lexer {
+
+/**
+ * @brief Versión de un .asc: su fecha de modificación y su tamaño.
+ */
+struct SourceStamp {
+   int64_t mtime = 0;
+   uint64_t size = 0;
+   // false si no se pudo consultar el archivo.
+   bool valid = false;
+};
+
+/**
+ * @brief Versión actual de un .asc. Se toma antes de leerlo.
+ */
+SourceStamp sourceStamp(const std::filesystem::path &source);
+
+/**
+ * @brief Lee el caché binario de un .asc, .f32.lvr o .i32.lvr a su lado,
+ * si coinciden el stamp y, para float32, el Transform.
+ * @param source al archivo .asc original.
+ * @param stamp versión del .asc, de sourceStamp.
+ * @param transform ajustes con los que se quiere el raster.
+ * @param raster destino, sólo se modifica si el caché es válido.
+ * @return true si se leyó el caché, false si hay que procesar el .asc.
+ */
+bool readCache(const std::filesystem::path &source,
+               const SourceStamp &stamp, const Transform &transform,
+               Ascf &raster);
+bool readCache(const std::filesystem::path &source,
+               const SourceStamp &stamp, Asci &raster);
+
+/**
+ * @brief Escribe el caché binario de un .asc ya procesado. Los errores
+ * de escritura se ignoran.
+ * @param source al archivo .asc original.
+ * @param stamp versión del .asc tomada antes de leerlo.
+ * @param transform ajustes con los que se procesó el raster.
+ * @param raster el contenido procesado del .asc.
+ */
+void writeCache(const std::filesystem::path &source,
+                const SourceStamp &stamp, const Transform &transform,
+                const Ascf &raster);
+void writeCache(const std::filesystem::path &source,
+                const SourceStamp &stamp, const Asci &raster);
+
+};  // namespace Lexer
@@ -1,3861 +1,452 @@
 #include "colormaps.hpp"
 
+#include <array>
 #include <cstddef>
-#include <stdexcept>
-#include <sstream>
-
-#define GLM_FORCE_RADIANS
-#define GLM_FORCE_DEPTH_ZERO_TO_ONE
-#include <glm/glm.hpp>
+#include <cstdint>
+#include <iterator>
 
 namespace colormap {
 
-constexpr colormap_t spring = {
-    {1, 0, 1},
-    {1, 0.00392157, 0.996078},
-    {1, 0.00784314, 0.992157},
-    {1, 0.0117647, 0.988235},
-    {1, 0.0156863, 0.984314},
-    {1, 0.0196078, 0.980392},
-    {1, 0.0235294, 0.976471},
-    {1, 0.027451, 0.972549},
-    {1, 0.0313725, 0.968627},
-    {1, 0.0352941, 0.964706},
-    {1, 0.0392157, 0.960784},
-    {1, 0.0431373, 0.956863},
-    {1, 0.0470588, 0.952941},
-    {1, 0.0509804, 0.94902},
-    {1, 0.054902, 0.945098},
-    {1, 0.0588235, 0.941176},
-    {1, 0.0627451, 0.937255},
-    {1, 0.0666667, 0.933333},
-    {1, 0.0705882, 0.929412},
-    {1, 0.0745098, 0.92549},
-    {1, 0.0784314, 0.921569},
-    {1, 0.0823529, 0.917647},
-    {1, 0.0862745, 0.913725},
-    {1, 0.0901961, 0.909804},
-    {1, 0.0941176, 0.905882},
-    {1, 0.0980392, 0.901961},
-    {1, 0.101961, 0.898039},
-    {1, 0.105882, 0.894118},
-    {1, 0.109804, 0.890196},
-    {1, 0.113725, 0.886275},
-    {1, 0.117647, 0.882353},
-    {1, 0.121569, 0.878431},
-    {1, 0.12549, 0.87451},
-    {1, 0.129412, 0.870588},
-    {1, 0.133333, 0.866667},
-    {1, 0.137255, 0.862745},
-    {1, 0.141176, 0.858824},
-    {1, 0.145098, 0.854902},
-    {1, 0.14902, 0.85098},
-    {1, 0.152941, 0.847059},
-    {1, 0.156863, 0.843137},
-    {1, 0.160784, 0.839216},
-    {1, 0.164706, 0.835294},
-    {1, 0.168627, 0.831373},
-    {1, 0.172549, 0.827451},
-    {1, 0.176471, 0.823529},
-    {1, 0.180392, 0.819608},
-    {1, 0.184314, 0.815686},
-    {1, 0.188235, 0.811765},
-    {1, 0.192157, 0.807843},
-    {1, 0.196078, 0.803922},
-    {1, 0.2, 0.8},
-    {1, 0.203922, 0.796078},
-    {1, 0.207843, 0.792157},
-    {1, 0.211765, 0.788235},
-    {1, 0.215686, 0.784314},
-    {1, 0.219608, 0.780392},
-    {1, 0.223529, 0.776471},
-    {1, 0.227451, 0.772549},
-    {1, 0.231373, 0.768627},
-    {1, 0.235294, 0.764706},
-    {1, 0.239216, 0.760784},
-    {1, 0.243137, 0.756863},
-    {1, 0.247059, 0.752941},
-    {1, 0.25098, 0.74902},
-    {1, 0.254902, 0.745098},
-    {1, 0.258824, 0.741176},
-    {1, 0.262745, 0.737255},
-    {1, 0.266667, 0.733333},
-    {1, 0.270588, 0.729412},
-    {1, 0.27451, 0.72549},
-    {1, 0.278431, 0.721569},
-    {1, 0.282353, 0.717647},
-    {1, 0.286275, 0.713725},
-    {1, 0.290196, 0.709804},
-    {1, 0.294118, 0.705882},
-    {1, 0.298039, 0.701961},
-    {1, 0.301961, 0.698039},
-    {1, 0.305882, 0.694118},
-    {1, 0.309804, 0.690196},
-    {1, 0.313725, 0.686275},
-    {1, 0.317647, 0.682353},
-    {1, 0.321569, 0.678431},
-    {1, 0.32549, 0.67451},
-    {1, 0.329412, 0.670588},
-    {1, 0.333333, 0.666667},
-    {1, 0.337255, 0.662745},
-    {1, 0.341176, 0.658824},
-    {1, 0.345098, 0.654902},
-    {1, 0.34902, 0.65098},
-    {1, 0.352941, 0.647059},
-    {1, 0.356863, 0.643137},
-    {1, 0.360784, 0.639216},
-    {1, 0.364706, 0.635294},
-    {1, 0.368627, 0.631373},
-    {1, 0.372549, 0.627451},
-    {1, 0.376471, 0.623529},
-    {1, 0.380392, 0.619608},
-    {1, 0.384314, 0.615686},
-    {1, 0.388235, 0.611765},
-    {1, 0.392157, 0.607843},
-    {1, 0.396078, 0.603922},
-    {1, 0.4, 0.6},
-    {1, 0.403922, 0.596078},
-    {1, 0.407843, 0.592157},
-    {1, 0.411765, 0.588235},
-    {1, 0.415686, 0.584314},
-    {1, 0.419608, 0.580392},
-    {1, 0.423529, 0.576471},
-    {1, 0.427451, 0.572549},
-    {1, 0.431373, 0.568627},
-    {1, 0.435294, 0.564706},
-    {1, 0.439216, 0.560784},
-    {1, 0.443137, 0.556863},
-    {1, 0.447059, 0.552941},
-    {1, 0.45098, 0.54902},
-    {1, 0.454902, 0.545098},
-    {1, 0.458824, 0.541176},
-    {1, 0.462745, 0.537255},
-    {1, 0.466667, 0.533333},
-    {1, 0.470588, 0.529412},
-    {1, 0.47451, 0.52549},
-    {1, 0.478431, 0.521569},
-    {1, 0.482353, 0.517647},
-    {1, 0.486275, 0.513725},
-    {1, 0.490196, 0.509804},
-    {1, 0.494118, 0.505882},
-    {1, 0.498039, 0.501961},
-    {1, 0.501961, 0.498039},
-    {1, 0.505882, 0.494118},
-    {1, 0.509804, 0.490196},
-    {1, 0.513725, 0.486275},
-    {1, 0.517647, 0.482353},
-    {1, 0.521569, 0.478431},
-    {1, 0.52549, 0.47451},
-    {1, 0.529412, 0.470588},
-    {1, 0.533333, 0.466667},
-    {1, 0.537255, 0.462745},
-    {1, 0.541176, 0.458824},
-    {1, 0.545098, 0.454902},
-    {1, 0.54902, 0.45098},
-    {1, 0.552941, 0.447059},
-    {1, 0.556863, 0.443137},
-    {1, 0.560784, 0.439216},
-    {1, 0.564706, 0.435294},
-    {1, 0.568627, 0.431373},
-    {1, 0.572549, 0.427451},
-    {1, 0.576471, 0.423529},
-    {1, 0.580392, 0.419608},
-    {1, 0.584314, 0.415686},
-    {1, 0.588235, 0.411765},
-    {1, 0.592157, 0.407843},
-    {1, 0.596078, 0.403922},
-    {1, 0.6, 0.4},
-    {1, 0.603922, 0.396078},
-    {1, 0.607843, 0.392157},
-    {1, 0.611765, 0.388235},
-    {1, 0.615686, 0.384314},
-    {1, 0.619608, 0.380392},
-    {1, 0.623529, 0.376471},
-    {1, 0.627451, 0.372549},
-    {1, 0.631373, 0.368627},
-    {1, 0.635294, 0.364706},
-    {1, 0.639216, 0.360784},
-    {1, 0.643137, 0.356863},
-    {1, 0.647059, 0.352941},
-    {1, 0.65098, 0.34902},
-    {1, 0.654902, 0.345098},
-    {1, 0.658824, 0.341176},
-    {1, 0.662745, 0.337255},
-    {1, 0.666667, 0.333333},
-    {1, 0.670588, 0.329412},
-    {1, 0.67451, 0.32549},
-    {1, 0.678431, 0.321569},
-    {1, 0.682353, 0.317647},
-    {1, 0.686275, 0.313725},
-    {1, 0.690196, 0.309804},
-    {1, 0.694118, 0.305882},
-    {1, 0.698039, 0.301961},
-    {1, 0.701961, 0.298039},
-    {1, 0.705882, 0.294118},
-    {1, 0.709804, 0.290196},
-    {1, 0.713725, 0.286275},
-    {1, 0.717647, 0.282353},
-    {1, 0.721569, 0.278431},
-    {1, 0.72549, 0.27451},
-    {1, 0.729412, 0.270588},
-    {1, 0.733333, 0.266667},
-    {1, 0.737255, 0.262745},
-    {1, 0.741176, 0.258824},
-    {1, 0.745098, 0.254902},
-    {1, 0.74902, 0.25098},
-    {1, 0.752941, 0.247059},
-    {1, 0.756863, 0.243137},
-    {1, 0.760784, 0.239216},
-    {1, 0.764706, 0.235294},
-    {1, 0.768627, 0.231373},
-    {1, 0.772549, 0.227451},
-    {1, 0.776471, 0.223529},
-    {1, 0.780392, 0.219608},
-    {1, 0.784314, 0.215686},
-    {1, 0.788235, 0.211765},
-    {1, 0.792157, 0.207843},
-    {1, 0.796078, 0.203922},
-    {1, 0.8, 0.2},
-    {1, 0.803922, 0.196078},
-    {1, 0.807843, 0.192157},
-    {1, 0.811765, 0.188235},
-    {1, 0.815686, 0.184314},
-    {1, 0.819608, 0.180392},
-    {1, 0.823529, 0.176471},
-    {1, 0.827451, 0.172549},
-    {1, 0.831373, 0.168627},
-    {1, 0.835294, 0.164706},
-    {1, 0.839216, 0.160784},
-    {1, 0.843137, 0.156863},
-    {1, 0.847059, 0.152941},
-    {1, 0.85098, 0.14902},
-    {1, 0.854902, 0.145098},
-    {1, 0.858824, 0.141176},
-    {1, 0.862745, 0.137255},
-    {1, 0.866667, 0.133333},
-    {1, 0.870588, 0.129412},
-    {1, 0.87451, 0.12549},
-    {1, 0.878431, 0.121569},
-    {1, 0.882353, 0.117647},
-    {1, 0.886275, 0.113725},
-    {1, 0.890196, 0.109804},
-    {1, 0.894118, 0.105882},
-    {1, 0.898039, 0.101961},
-    {1, 0.901961, 0.0980392},
-    {1, 0.905882, 0.0941176},
-    {1, 0.909804, 0.0901961},
-    {1, 0.913725, 0.0862745},
-    {1, 0.917647, 0.0823529},
-    {1, 0.921569, 0.0784314},
-    {1, 0.92549, 0.0745098},
-    {1, 0.929412, 0.0705882},
-    {1, 0.933333, 0.0666667},
-    {1, 0.937255, 0.0627451},
-    {1, 0.941176, 0.0588235},
-    {1, 0.945098, 0.054902},
-    {1, 0.94902, 0.0509804},
-    {1, 0.952941, 0.0470588},
-    {1, 0.956863, 0.0431373},
-    {1, 0.960784, 0.0392157},
-    {1, 0.964706, 0.0352941},
-    {1, 0.968627, 0.0313725},
-    {1, 0.972549, 0.027451},
-    {1, 0.976471, 0.0235294},
-    {1, 0.980392, 0.0196078},
-    {1, 0.984314, 0.0156863},
-    {1, 0.988235, 0.0117647},
-    {1, 0.992157, 0.00784314},
-    {1, 0.996078, 0.00392157},
-    {1, 1, 0},
+namespace {
+
+// Color of a palette at position, a value linearly interpolated from
+// the two control points around it.
+struct ControlPoint {
+   float position;
+   Rgb color;
+};
+
+struct Palette {
+   const char* name;
+   const ControlPoint* points;
+   size_t count;
+};
+
+// matplotlib's palettes, sampled at the fewest positions that give
+// their 256 colors back within 0.001.
+constexpr ControlPoint spring[] = {
+    {0.f, {1.f, 0.f, 1.f}},
+    {1.f, {1.f, 1.f, 0.f}},
+};
+
+constexpr ControlPoint summer[] = {
+    {0.f, {0.f, 0.5f, 0.4f}},
+    {1.f, {1.f, 1.f, 0.4f}},
 };
 
-constexpr colormap_t summer = {
-    {0, 0.5, 0.4},
-    {0.00392157, 0.501961, 0.4},
-    {0.00784314, 0.503922, 0.4},
-    {0.0117647, 0.505882, 0.4},
-    {0.0156863, 0.507843, 0.4},
-    {0.0196078, 0.509804, 0.4},
-    {0.0235294, 0.511765, 0.4},
-    {0.027451, 0.513725, 0.4},
-    {0.0313725, 0.515686, 0.4},
-    {0.0352941, 0.517647, 0.4},
-    {0.0392157, 0.519608, 0.4},
-    {0.0431373, 0.521569, 0.4},
-    {0.0470588, 0.523529, 0.4},
-    {0.0509804, 0.52549, 0.4},
-    {0.054902, 0.527451, 0.4},
-    {0.0588235, 0.529412, 0.4},
-    {0.0627451, 0.531373, 0.4},
-    {0.0666667, 0.533333, 0.4},
-    {0.0705882, 0.535294, 0.4},
-    {0.0745098, 0.537255, 0.4},
-    {0.0784314, 0.539216, 0.4},
-    {0.0823529, 0.541176, 0.4},
-    {0.0862745, 0.543137, 0.4},
-    {0.0901961, 0.545098, 0.4},
-    {0.0941176, 0.547059, 0.4},
-    {0.0980392, 0.54902, 0.4},
-    {0.101961, 0.55098, 0.4},
-    {0.105882, 0.552941, 0.4},
-    {0.109804, 0.554902, 0.4},
-    {0.113725, 0.556863, 0.4},
-    {0.117647, 0.558824, 0.4},
-    {0.121569, 0.560784, 0.4},
-    {0.12549, 0.562745, 0.4},
-    {0.129412, 0.564706, 0.4},
-    {0.133333, 0.566667, 0.4},
-    {0.137255, 0.568627, 0.4},
-    {0.141176, 0.570588, 0.4},
-    {0.145098, 0.572549, 0.4},
-    {0.14902, 0.57451, 0.4},
-    {0.152941, 0.576471, 0.4},
-    {0.156863, 0.578431, 0.4},
-    {0.160784, 0.580392, 0.4},
-    {0.164706, 0.582353, 0.4},
-    {0.168627, 0.584314, 0.4},
-    {0.172549, 0.586275, 0.4},
-    {0.176471, 0.588235, 0.4},
-    {0.180392, 0.590196, 0.4},
-    {0.184314, 0.592157, 0.4},
-    {0.188235, 0.594118, 0.4},
-    {0.192157, 0.596078, 0.4},
-    {0.196078, 0.598039, 0.4},
-    {0.2, 0.6, 0.4},
-    {0.203922, 0.601961, 0.4},
-    {0.207843, 0.603922, 0.4},
-    {0.211765, 0.605882, 0.4},
-    {0.215686, 0.607843, 0.4},
-    {0.219608, 0.609804, 0.4},
-    {0.223529, 0.611765, 0.4},
-    {0.227451, 0.613725, 0.4},
-    {0.231373, 0.615686, 0.4},
-    {0.235294, 0.617647, 0.4},
-    {0.239216, 0.619608, 0.4},
-    {0.243137, 0.621569, 0.4},
-    {0.247059, 0.623529, 0.4},
-    {0.25098, 0.62549, 0.4},
-    {0.254902, 0.627451, 0.4},
-    {0.258824, 0.629412, 0.4},
-    {0.262745, 0.631373, 0.4},
-    {0.266667, 0.633333, 0.4},
-    {0.270588, 0.635294, 0.4},
-    {0.27451, 0.637255, 0.4},
-    {0.278431, 0.639216, 0.4},
-    {0.282353, 0.641176, 0.4},
-    {0.286275, 0.643137, 0.4},
-    {0.290196, 0.645098, 0.4},
-    {0.294118, 0.647059, 0.4},
-    {0.298039, 0.64902, 0.4},
-    {0.301961, 0.65098, 0.4},
-    {0.305882, 0.652941, 0.4},
-    {0.309804, 0.654902, 0.4},
-    {0.313725, 0.656863, 0.4},
-    {0.317647, 0.658824, 0.4},
-    {0.321569, 0.660784, 0.4},
-    {0.32549, 0.662745, 0.4},
-    {0.329412, 0.664706, 0.4},
-    {0.333333, 0.666667, 0.4},
-    {0.337255, 0.668627, 0.4},
-    {0.341176, 0.670588, 0.4},
-    {0.345098, 0.672549, 0.4},
-    {0.34902, 0.67451, 0.4},
-    {0.352941, 0.676471, 0.4},
-    {0.356863, 0.678431, 0.4},
-    {0.360784, 0.680392, 0.4},
-    {0.364706, 0.682353, 0.4},
-    {0.368627, 0.684314, 0.4},
-    {0.372549, 0.686275, 0.4},
-    {0.376471, 0.688235, 0.4},
-    {0.380392, 0.690196, 0.4},
-    {0.384314, 0.692157, 0.4},
-    {0.388235, 0.694118, 0.4},
-    {0.392157, 0.696078, 0.4},
-    {0.396078, 0.698039, 0.4},
-    {0.4, 0.7, 0.4},
-    {0.403922, 0.701961, 0.4},
-    {0.407843, 0.703922, 0.4},
-    {0.411765, 0.705882, 0.4},
-    {0.415686, 0.707843, 0.4},
-    {0.419608, 0.709804, 0.4},
-    {0.423529, 0.711765, 0.4},
-    {0.427451, 0.713725, 0.4},
-    {0.431373, 0.715686, 0.4},
-    {0.435294, 0.717647, 0.4},
-    {0.439216, 0.719608, 0.4},
-    {0.443137, 0.721569, 0.4},
-    {0.447059, 0.723529, 0.4},
-    {0.45098, 0.72549, 0.4},
-    {0.454902, 0.727451, 0.4},
-    {0.458824, 0.729412, 0.4},
-    {0.462745, 0.731373, 0.4},
-    {0.466667, 0.733333, 0.4},
-    {0.470588, 0.735294, 0.4},
-    {0.47451, 0.737255, 0.4},
-    {0.478431, 0.739216, 0.4},
-    {0.482353, 0.741176, 0.4},
-    {0.486275, 0.743137, 0.4},
-    {0.490196, 0.745098, 0.4},
-    {0.494118, 0.747059, 0.4},
-    {0.498039, 0.74902, 0.4},
-    {0.501961, 0.75098, 0.4},
-    {0.505882, 0.752941, 0.4},
-    {0.509804, 0.754902, 0.4},
-    {0.513725, 0.756863, 0.4},
-    {0.517647, 0.758824, 0.4},
-    {0.521569, 0.760784, 0.4},
-    {0.52549, 0.762745, 0.4},
-    {0.529412, 0.764706, 0.4},
-    {0.533333, 0.766667, 0.4},
-    {0.537255, 0.768627, 0.4},
-    {0.541176, 0.770588, 0.4},
-    {0.545098, 0.772549, 0.4},
-    {0.54902, 0.77451, 0.4},
-    {0.552941, 0.776471, 0.4},
-    {0.556863, 0.778431, 0.4},
-    {0.560784, 0.780392, 0.4},
-    {0.564706, 0.782353, 0.4},
-    {0.568627, 0.784314, 0.4},
-    {0.572549, 0.786275, 0.4},
-    {0.576471, 0.788235, 0.4},
-    {0.580392, 0.790196, 0.4},
-    {0.584314, 0.792157, 0.4},
-    {0.588235, 0.794118, 0.4},
-    {0.592157, 0.796078, 0.4},
-    {0.596078, 0.798039, 0.4},
-    {0.6, 0.8, 0.4},
-    {0.603922, 0.801961, 0.4},
-    {0.607843, 0.803922, 0.4},
-    {0.611765, 0.805882, 0.4},
-    {0.615686, 0.807843, 0.4},
-    {0.619608, 0.809804, 0.4},
-    {0.623529, 0.811765, 0.4},
-    {0.627451, 0.813725, 0.4},
-    {0.631373, 0.815686, 0.4},
-    {0.635294, 0.817647, 0.4},
-    {0.639216, 0.819608, 0.4},
-    {0.643137, 0.821569, 0.4},
-    {0.647059, 0.823529, 0.4},
-    {0.65098, 0.82549, 0.4},
-    {0.654902, 0.827451, 0.4},
-    {0.658824, 0.829412, 0.4},
-    {0.662745, 0.831373, 0.4},
-    {0.666667, 0.833333, 0.4},
-    {0.670588, 0.835294, 0.4},
-    {0.67451, 0.837255, 0.4},
-    {0.678431, 0.839216, 0.4},
-    {0.682353, 0.841176, 0.4},
-    {0.686275, 0.843137, 0.4},
-    {0.690196, 0.845098, 0.4},
-    {0.694118, 0.847059, 0.4},
-    {0.698039, 0.84902, 0.4},
-    {0.701961, 0.85098, 0.4},
-    {0.705882, 0.852941, 0.4},
-    {0.709804, 0.854902, 0.4},
-    {0.713725, 0.856863, 0.4},
-    {0.717647, 0.858824, 0.4},
-    {0.721569, 0.860784, 0.4},
-    {0.72549, 0.862745, 0.4},
-    {0.729412, 0.864706, 0.4},
-    {0.733333, 0.866667, 0.4},
-    {0.737255, 0.868627, 0.4},
-    {0.741176, 0.870588, 0.4},
-    {0.745098, 0.872549, 0.4},
-    {0.74902, 0.87451, 0.4},
-    {0.752941, 0.876471, 0.4},
-    {0.756863, 0.878431, 0.4},
-    {0.760784, 0.880392, 0.4},
-    {0.764706, 0.882353, 0.4},
-    {0.768627, 0.884314, 0.4},
-    {0.772549, 0.886275, 0.4},
-    {0.776471, 0.888235, 0.4},
-    {0.780392, 0.890196, 0.4},
-    {0.784314, 0.892157, 0.4},
-    {0.788235, 0.894118, 0.4},
-    {0.792157, 0.896078, 0.4},
-    {0.796078, 0.898039, 0.4},
-    {0.8, 0.9, 0.4},
-    {0.803922, 0.901961, 0.4},
-    {0.807843, 0.903922, 0.4},
-    {0.811765, 0.905882, 0.4},
-    {0.815686, 0.907843, 0.4},
-    {0.819608, 0.909804, 0.4},
-    {0.823529, 0.911765, 0.4},
-    {0.827451, 0.913725, 0.4},
-    {0.831373, 0.915686, 0.4},
-    {0.835294, 0.917647, 0.4},
-    {0.839216, 0.919608, 0.4},
-    {0.843137, 0.921569, 0.4},
-    {0.847059, 0.923529, 0.4},
-    {0.85098, 0.92549, 0.4},
-    {0.854902, 0.927451, 0.4},
-    {0.858824, 0.929412, 0.4},
-    {0.862745, 0.931373, 0.4},
-    {0.866667, 0.933333, 0.4},
-    {0.870588, 0.935294, 0.4},
-    {0.87451, 0.937255, 0.4},
-    {0.878431, 0.939216, 0.4},
-    {0.882353, 0.941176, 0.4},
-    {0.886275, 0.943137, 0.4},
-    {0.890196, 0.945098, 0.4},
-    {0.894118, 0.947059, 0.4},
-    {0.898039, 0.94902, 0.4},
-    {0.901961, 0.95098, 0.4},
-    {0.905882, 0.952941, 0.4},
-    {0.909804, 0.954902, 0.4},
-    {0.913725, 0.956863, 0.4},
-    {0.917647, 0.958824, 0.4},
-    {0.921569, 0.960784, 0.4},
-    {0.92549, 0.962745, 0.4},
-    {0.929412, 0.964706, 0.4},
-    {0.933333, 0.966667, 0.4},
-    {0.937255, 0.968627, 0.4},
-    {0.941176, 0.970588, 0.4},
-    {0.945098, 0.972549, 0.4},
-    {0.94902, 0.97451, 0.4},
-    {0.952941, 0.976471, 0.4},
-    {0.956863, 0.978431, 0.4},
-    {0.960784, 0.980392, 0.4},
-    {0.964706, 0.982353, 0.4},
-    {0.968627, 0.984314, 0.4},
-    {0.972549, 0.986275, 0.4},
-    {0.976471, 0.988235, 0.4},
-    {0.980392, 0.990196, 0.4},
-    {0.984314, 0.992157, 0.4},
-    {0.988235, 0.994118, 0.4},
-    {0.992157, 0.996078, 0.4},
-    {0.996078, 0.998039, 0.4},
-    {1, 1, 0.4},
+constexpr ControlPoint autumn[] = {
+    {0.f, {1.f, 0.f, 0.f}},
+    {1.f, {1.f, 1.f, 0.f}},
 };
 
-constexpr colormap_t autumn = {
-    {1, 0, 0},         {1, 0.00392157, 0}, {1, 0.00784314, 0},
-    {1, 0.0117647, 0}, {1, 0.0156863, 0},  {1, 0.0196078, 0},
-    {1, 0.0235294, 0}, {1, 0.027451, 0},   {1, 0.0313725, 0},
-    {1, 0.0352941, 0}, {1, 0.0392157, 0},  {1, 0.0431373, 0},
-    {1, 0.0470588, 0}, {1, 0.0509804, 0},  {1, 0.054902, 0},
-    {1, 0.0588235, 0}, {1, 0.0627451, 0},  {1, 0.0666667, 0},
-    {1, 0.0705882, 0}, {1, 0.0745098, 0},  {1, 0.0784314, 0},
-    {1, 0.0823529, 0}, {1, 0.0862745, 0},  {1, 0.0901961, 0},
-    {1, 0.0941176, 0}, {1, 0.0980392, 0},  {1, 0.101961, 0},
-    {1, 0.105882, 0},  {1, 0.109804, 0},   {1, 0.113725, 0},
-    {1, 0.117647, 0},  {1, 0.121569, 0},   {1, 0.12549, 0},
-    {1, 0.129412, 0},  {1, 0.133333, 0},   {1, 0.137255, 0},
-    {1, 0.141176, 0},  {1, 0.145098, 0},   {1, 0.14902, 0},
-    {1, 0.152941, 0},  {1, 0.156863, 0},   {1, 0.160784, 0},
-    {1, 0.164706, 0},  {1, 0.168627, 0},   {1, 0.172549, 0},
-    {1, 0.176471, 0},  {1, 0.180392, 0},   {1, 0.184314, 0},
-    {1, 0.188235, 0},  {1, 0.192157, 0},   {1, 0.196078, 0},
-    {1, 0.2, 0},       {1, 0.203922, 0},   {1, 0.207843, 0},
-    {1, 0.211765, 0},  {1, 0.215686, 0},   {1, 0.219608, 0},
-    {1, 0.223529, 0},  {1, 0.227451, 0},   {1, 0.231373, 0},
-    {1, 0.235294, 0},  {1, 0.239216, 0},   {1, 0.243137, 0},
-    {1, 0.247059, 0},  {1, 0.25098, 0},    {1, 0.254902, 0},
-    {1, 0.258824, 0},  {1, 0.262745, 0},   {1, 0.266667, 0},
-    {1, 0.270588, 0},  {1, 0.27451, 0},    {1, 0.278431, 0},
-    {1, 0.282353, 0},  {1, 0.286275, 0},   {1, 0.290196, 0},
-    {1, 0.294118, 0},  {1, 0.298039, 0},   {1, 0.301961, 0},
-    {1, 0.305882, 0},  {1, 0.309804, 0},   {1, 0.313725, 0},
-    {1, 0.317647, 0},  {1, 0.321569, 0},   {1, 0.32549, 0},
-    {1, 0.329412, 0},  {1, 0.333333, 0},   {1, 0.337255, 0},
-    {1, 0.341176, 0},  {1, 0.345098, 0},   {1, 0.34902, 0},
-    {1, 0.352941, 0},  {1, 0.356863, 0},   {1, 0.360784, 0},
-    {1, 0.364706, 0},  {1, 0.368627, 0},   {1, 0.372549, 0},
-    {1, 0.376471, 0},  {1, 0.380392, 0},   {1, 0.384314, 0},
-    {1, 0.388235, 0},  {1, 0.392157, 0},   {1, 0.396078, 0},
-    {1, 0.4, 0},       {1, 0.403922, 0},   {1, 0.407843, 0},
-    {1, 0.411765, 0},  {1, 0.415686, 0},   {1, 0.419608, 0},
-    {1, 0.423529, 0},  {1, 0.427451, 0},   {1, 0.431373, 0},
-    {1, 0.435294, 0},  {1, 0.439216, 0},   {1, 0.443137, 0},
-    {1, 0.447059, 0},  {1, 0.45098, 0},    {1, 0.454902, 0},
-    {1, 0.458824, 0},  {1, 0.462745, 0},   {1, 0.466667, 0},
-    {1, 0.470588, 0},  {1, 0.47451, 0},    {1, 0.478431, 0},
-    {1, 0.482353, 0},  {1, 0.486275, 0},   {1, 0.490196, 0},
-    {1, 0.494118, 0},  {1, 0.498039, 0},   {1, 0.501961, 0},
-    {1, 0.505882, 0},  {1, 0.509804, 0},   {1, 0.513725, 0},
-    {1, 0.517647, 0},  {1, 0.521569, 0},   {1, 0.52549, 0},
-    {1, 0.529412, 0},  {1, 0.533333, 0},   {1, 0.537255, 0},
-    {1, 0.541176, 0},  {1, 0.545098, 0},   {1, 0.54902, 0},
-    {1, 0.552941, 0},  {1, 0.556863, 0},   {1, 0.560784, 0},
-    {1, 0.564706, 0},  {1, 0.568627, 0},   {1, 0.572549, 0},
-    {1, 0.576471, 0},  {1, 0.580392, 0},   {1, 0.584314, 0},
-    {1, 0.588235, 0},  {1, 0.592157, 0},   {1, 0.596078, 0},
-    {1, 0.6, 0},       {1, 0.603922, 0},   {1, 0.607843, 0},
-    {1, 0.611765, 0},  {1, 0.615686, 0},   {1, 0.619608, 0},
-    {1, 0.623529, 0},  {1, 0.627451, 0},   {1, 0.631373, 0},
-    {1, 0.635294, 0},  {1, 0.639216, 0},   {1, 0.643137, 0},
-    {1, 0.647059, 0},  {1, 0.65098, 0},    {1, 0.654902, 0},
-    {1, 0.658824, 0},  {1, 0.662745, 0},   {1, 0.666667, 0},
-    {1, 0.670588, 0},  {1, 0.67451, 0},    {1, 0.678431, 0},
-    {1, 0.682353, 0},  {1, 0.686275, 0},   {1, 0.690196, 0},
-    {1, 0.694118, 0},  {1, 0.698039, 0},   {1, 0.701961, 0},
-    {1, 0.705882, 0},  {1, 0.709804, 0},   {1, 0.713725, 0},
-    {1, 0.717647, 0},  {1, 0.721569, 0},   {1, 0.72549, 0},
-    {1, 0.729412, 0},  {1, 0.733333, 0},   {1, 0.737255, 0},
-    {1, 0.741176, 0},  {1, 0.745098, 0},   {1, 0.74902, 0},
-    {1, 0.752941, 0},  {1, 0.756863, 0},   {1, 0.760784, 0},
-    {1, 0.764706, 0},  {1, 0.768627, 0},   {1, 0.772549, 0},
-    {1, 0.776471, 0},  {1, 0.780392, 0},   {1, 0.784314, 0},
-    {1, 0.788235, 0},  {1, 0.792157, 0},   {1, 0.796078, 0},
-    {1, 0.8, 0},       {1, 0.803922, 0},   {1, 0.807843, 0},
-    {1, 0.811765, 0},  {1, 0.815686, 0},   {1, 0.819608, 0},
-    {1, 0.823529, 0},  {1, 0.827451, 0},   {1, 0.831373, 0},
-    {1, 0.835294, 0},  {1, 0.839216, 0},   {1, 0.843137, 0},
-    {1, 0.847059, 0},  {1, 0.85098, 0},    {1, 0.854902, 0},
-    {1, 0.858824, 0},  {1, 0.862745, 0},   {1, 0.866667, 0},
-    {1, 0.870588, 0},  {1, 0.87451, 0},    {1, 0.878431, 0},
-    {1, 0.882353, 0},  {1, 0.886275, 0},   {1, 0.890196, 0},
-    {1, 0.894118, 0},  {1, 0.898039, 0},   {1, 0.901961, 0},
-    {1, 0.905882, 0},  {1, 0.909804, 0},   {1, 0.913725, 0},
-    {1, 0.917647, 0},  {1, 0.921569, 0},   {1, 0.92549, 0},
-    {1, 0.929412, 0},  {1, 0.933333, 0},   {1, 0.937255, 0},
-    {1, 0.941176, 0},  {1, 0.945098, 0},   {1, 0.94902, 0},
-    {1, 0.952941, 0},  {1, 0.956863, 0},   {1, 0.960784, 0},
-    {1, 0.964706, 0},  {1, 0.968627, 0},   {1, 0.972549, 0},
-    {1, 0.976471, 0},  {1, 0.980392, 0},   {1, 0.984314, 0},
-    {1, 0.988235, 0},  {1, 0.992157, 0},   {1, 0.996078, 0},
-    {1, 1, 0},
+constexpr ControlPoint winter[] = {
+    {0.f, {0.f, 0.f, 1.f}},
+    {1.f, {0.f, 1.f, 0.5f}},
 };
 
-constexpr colormap_t winter = {
-    {0, 0, 1},
-    {0, 0.00392157, 0.998039},
-    {0, 0.00784314, 0.996078},
-    {0, 0.0117647, 0.994118},
-    {0, 0.0156863, 0.992157},
-    {0, 0.0196078, 0.990196},
-    {0, 0.0235294, 0.988235},
-    {0, 0.027451, 0.986275},
-    {0, 0.0313725, 0.984314},
-    {0, 0.0352941, 0.982353},
-    {0, 0.0392157, 0.980392},
-    {0, 0.0431373, 0.978431},
-    {0, 0.0470588, 0.976471},
-    {0, 0.0509804, 0.97451},
-    {0, 0.054902, 0.972549},
-    {0, 0.0588235, 0.970588},
-    {0, 0.0627451, 0.968627},
-    {0, 0.0666667, 0.966667},
-    {0, 0.0705882, 0.964706},
-    {0, 0.0745098, 0.962745},
-    {0, 0.0784314, 0.960784},
-    {0, 0.0823529, 0.958824},
-    {0, 0.0862745, 0.956863},
-    {0, 0.0901961, 0.954902},
-    {0, 0.0941176, 0.952941},
-    {0, 0.0980392, 0.95098},
-    {0, 0.101961, 0.94902},
-    {0, 0.105882, 0.947059},
-    {0, 0.109804, 0.945098},
-    {0, 0.113725, 0.943137},
-    {0, 0.117647, 0.941176},
-    {0, 0.121569, 0.939216},
-    {0, 0.12549, 0.937255},
-    {0, 0.129412, 0.935294},
-    {0, 0.133333, 0.933333},
-    {0, 0.137255, 0.931373},
-    {0, 0.141176, 0.929412},
-    {0, 0.145098, 0.927451},
-    {0, 0.14902, 0.92549},
-    {0, 0.152941, 0.923529},
-    {0, 0.156863, 0.921569},
-    {0, 0.160784, 0.919608},
-    {0, 0.164706, 0.917647},
-    {0, 0.168627, 0.915686},
-    {0, 0.172549, 0.913725},
-    {0, 0.176471, 0.911765},
-    {0, 0.180392, 0.909804},
-    {0, 0.184314, 0.907843},
-    {0, 0.188235, 0.905882},
-    {0, 0.192157, 0.903922},
-    {0, 0.196078, 0.901961},
-    {0, 0.2, 0.9},
-    {0, 0.203922, 0.898039},
-    {0, 0.207843, 0.896078},
-    {0, 0.211765, 0.894118},
-    {0, 0.215686, 0.892157},
-    {0, 0.219608, 0.890196},
-    {0, 0.223529, 0.888235},
-    {0, 0.227451, 0.886275},
-    {0, 0.231373, 0.884314},
-    {0, 0.235294, 0.882353},
-    {0, 0.239216, 0.880392},
-    {0, 0.243137, 0.878431},
-    {0, 0.247059, 0.876471},
-    {0, 0.25098, 0.87451},
-    {0, 0.254902, 0.872549},
-    {0, 0.258824, 0.870588},
-    {0, 0.262745, 0.868627},
-    {0, 0.266667, 0.866667},
-    {0, 0.270588, 0.864706},
-    {0, 0.27451, 0.862745},
-    {0, 0.278431, 0.860784},
-    {0, 0.282353, 0.858824},
-    {0, 0.286275, 0.856863},
-    {0, 0.290196, 0.854902},
-    {0, 0.294118, 0.852941},
-    {0, 0.298039, 0.85098},
-    {0, 0.301961, 0.84902},
-    {0, 0.305882, 0.847059},
-    {0, 0.309804, 0.845098},
-    {0, 0.313725, 0.843137},
-    {0, 0.317647, 0.841176},
-    {0, 0.321569, 0.839216},
-    {0, 0.32549, 0.837255},
-    {0, 0.329412, 0.835294},
-    {0, 0.333333, 0.833333},
-    {0, 0.337255, 0.831373},
-    {0, 0.341176, 0.829412},
-    {0, 0.345098, 0.827451},
-    {0, 0.34902, 0.82549},
-    {0, 0.352941, 0.823529},
-    {0, 0.356863, 0.821569},
-    {0, 0.360784, 0.819608},
-    {0, 0.364706, 0.817647},
-    {0, 0.368627, 0.815686},
-    {0, 0.372549, 0.813725},
-    {0, 0.376471, 0.811765},
-    {0, 0.380392, 0.809804},
-    {0, 0.384314, 0.807843},
-    {0, 0.388235, 0.805882},
-    {0, 0.392157, 0.803922},
-    {0, 0.396078, 0.801961},
-    {0, 0.4, 0.8},
-    {0, 0.403922, 0.798039},
-    {0, 0.407843, 0.796078},
-    {0, 0.411765, 0.794118},
-    {0, 0.415686, 0.792157},
-    {0, 0.419608, 0.790196},
-    {0, 0.423529, 0.788235},
-    {0, 0.427451, 0.786275},
-    {0, 0.431373, 0.784314},
-    {0, 0.435294, 0.782353},
-    {0, 0.439216, 0.780392},
-    {0, 0.443137, 0.778431},
-    {0, 0.447059, 0.776471},
-    {0, 0.45098, 0.77451},
-    {0, 0.454902, 0.772549},
-    {0, 0.458824, 0.770588},
-    {0, 0.462745, 0.768627},
-    {0, 0.466667, 0.766667},
-    {0, 0.470588, 0.764706},
-    {0, 0.47451, 0.762745},
-    {0, 0.478431, 0.760784},
-    {0, 0.482353, 0.758824},
-    {0, 0.486275, 0.756863},
-    {0, 0.490196, 0.754902},
-    {0, 0.494118, 0.752941},
-    {0, 0.498039, 0.75098},
-    {0, 0.501961, 0.74902},
-    {0, 0.505882, 0.747059},
-    {0, 0.509804, 0.745098},
-    {0, 0.513725, 0.743137},
-    {0, 0.517647, 0.741176},
-    {0, 0.521569, 0.739216},
-    {0, 0.52549, 0.737255},
-    {0, 0.529412, 0.735294},
-    {0, 0.533333, 0.733333},
-    {0, 0.537255, 0.731373},
-    {0, 0.541176, 0.729412},
-    {0, 0.545098, 0.727451},
-    {0, 0.54902, 0.72549},
-    {0, 0.552941, 0.723529},
-    {0, 0.556863, 0.721569},
-    {0, 0.560784, 0.719608},
-    {0, 0.564706, 0.717647},
-    {0, 0.568627, 0.715686},
-    {0, 0.572549, 0.713725},
-    {0, 0.576471, 0.711765},
-    {0, 0.580392, 0.709804},
-    {0, 0.584314, 0.707843},
-    {0, 0.588235, 0.705882},
-    {0, 0.592157, 0.703922},
-    {0, 0.596078, 0.701961},
-    {0, 0.6, 0.7},
-    {0, 0.603922, 0.698039},
-    {0, 0.607843, 0.696078},
-    {0, 0.611765, 0.694118},
-    {0, 0.615686, 0.692157},
-    {0, 0.619608, 0.690196},
-    {0, 0.623529, 0.688235},
-    {0, 0.627451, 0.686275},
-    {0, 0.631373, 0.684314},
-    {0, 0.635294, 0.682353},
-    {0, 0.639216, 0.680392},
-    {0, 0.643137, 0.678431},
-    {0, 0.647059, 0.676471},
-    {0, 0.65098, 0.67451},
-    {0, 0.654902, 0.672549},
-    {0, 0.658824, 0.670588},
-    {0, 0.662745, 0.668627},
-    {0, 0.666667, 0.666667},
-    {0, 0.670588, 0.664706},
-    {0, 0.67451, 0.662745},
-    {0, 0.678431, 0.660784},
-    {0, 0.682353, 0.658824},
-    {0, 0.686275, 0.656863},
-    {0, 0.690196, 0.654902},
-    {0, 0.694118, 0.652941},
-    {0, 0.698039, 0.65098},
-    {0, 0.701961, 0.64902},
-    {0, 0.705882, 0.647059},
-    {0, 0.709804, 0.645098},
-    {0, 0.713725, 0.643137},
-    {0, 0.717647, 0.641176},
-    {0, 0.721569, 0.639216},
-    {0, 0.72549, 0.637255},
-    {0, 0.729412, 0.635294},
-    {0, 0.733333, 0.633333},
-    {0, 0.737255, 0.631373},
-    {0, 0.741176, 0.629412},
-    {0, 0.745098, 0.627451},
-    {0, 0.74902, 0.62549},
-    {0, 0.752941, 0.623529},
-    {0, 0.756863, 0.621569},
-    {0, 0.760784, 0.619608},
-    {0, 0.764706, 0.617647},
-    {0, 0.768627, 0.615686},
-    {0, 0.772549, 0.613725},
-    {0, 0.776471, 0.611765},
-    {0, 0.780392, 0.609804},
-    {0, 0.784314, 0.607843},
-    {0, 0.788235, 0.605882},
-    {0, 0.792157, 0.603922},
-    {0, 0.796078, 0.601961},
-    {0, 0.8, 0.6},
-    {0, 0.803922, 0.598039},
-    {0, 0.807843, 0.596078},
-    {0, 0.811765, 0.594118},
-    {0, 0.815686, 0.592157},
-    {0, 0.819608, 0.590196},
-    {0, 0.823529, 0.588235},
-    {0, 0.827451, 0.586275},
-    {0, 0.831373, 0.584314},
-    {0, 0.835294, 0.582353},
-    {0, 0.839216, 0.580392},
-    {0, 0.843137, 0.578431},
-    {0, 0.847059, 0.576471},
-    {0, 0.85098, 0.57451},
-    {0, 0.854902, 0.572549},
-    {0, 0.858824, 0.570588},
-    {0, 0.862745, 0.568627},
-    {0, 0.866667, 0.566667},
-    {0, 0.870588, 0.564706},
-    {0, 0.87451, 0.562745},
-    {0, 0.878431, 0.560784},
-    {0, 0.882353, 0.558824},
-    {0, 0.886275, 0.556863},
-    {0, 0.890196, 0.554902},
-    {0, 0.894118, 0.552941},
-    {0, 0.898039, 0.55098},
-    {0, 0.901961, 0.54902},
-    {0, 0.905882, 0.547059},
-    {0, 0.909804, 0.545098},
-    {0, 0.913725, 0.543137},
-    {0, 0.917647, 0.541176},
-    {0, 0.921569, 0.539216},
-    {0, 0.92549, 0.537255},
-    {0, 0.929412, 0.535294},
-    {0, 0.933333, 0.533333},
-    {0, 0.937255, 0.531373},
-    {0, 0.941176, 0.529412},
-    {0, 0.945098, 0.527451},
-    {0, 0.94902, 0.52549},
-    {0, 0.952941, 0.523529},
-    {0, 0.956863, 0.521569},
-    {0, 0.960784, 0.519608},
-    {0, 0.964706, 0.517647},
-    {0, 0.968627, 0.515686},
-    {0, 0.972549, 0.513725},
-    {0, 0.976471, 0.511765},
-    {0, 0.980392, 0.509804},
-    {0, 0.984314, 0.507843},
-    {0, 0.988235, 0.505882},
-    {0, 0.992157, 0.503922},
-    {0, 0.996078, 0.501961},
-    {0, 1, 0.5},
+constexpr ControlPoint bone[] = {
+    {0.f, {0.f, 0.f, 0.f}},
+    {0.360784f, {0.317754f, 0.319444f, 0.444444f}},
+    {0.364706f, {0.321208f, 0.319444f, 0.444444f}},
+    {0.741176f, {0.652778f, 0.777778f, 0.773662f}},
+    {0.745098f, {0.652778f, 0.777778f, 0.777092f}},
+    {1.f, {1.f, 1.f, 1.f}},
 };
 
-constexpr colormap_t bone = {
-    {0, 0, 0},
-    {0.00345385, 0.00347222, 0.00483091},
-    {0.0069077, 0.00694443, 0.00966183},
-    {0.0103616, 0.0104167, 0.0144927},
-    {0.0138154, 0.0138889, 0.0193237},
-    {0.0172693, 0.0173611, 0.0241546},
-    {0.0207231, 0.0208333, 0.0289855},
-    {0.024177, 0.0243055, 0.0338164},
-    {0.0276308, 0.0277777, 0.0386473},
-    {0.0310847, 0.03125, 0.0434782},
-    {0.0345385, 0.0347222, 0.0483091},
-    {0.0379924, 0.0381944, 0.05314},
-    {0.0414462, 0.0416666, 0.057971},
-    {0.0449001, 0.0451388, 0.0628019},
-    {0.0483539, 0.048611, 0.0676328},
-    {0.0518078, 0.0520833, 0.0724637},
-    {0.0552616, 0.0555555, 0.0772946},
-    {0.0587155, 0.0590277, 0.0821255},
-    {0.0621693, 0.0624999, 0.0869564},
-    {0.0656232, 0.0659721, 0.0917873},
-    {0.069077, 0.0694443, 0.0966183},
-    {0.0725309, 0.0729166, 0.101449},
-    {0.0759847, 0.0763888, 0.10628},
-    {0.0794386, 0.079861, 0.111111},
-    {0.0828924, 0.0833332, 0.115942},
-    {0.0863463, 0.0868054, 0.120773},
-    {0.0898001, 0.0902777, 0.125604},
-    {0.093254, 0.0937499, 0.130435},
-    {0.0967079, 0.0972221, 0.135266},
-    {0.100162, 0.100694, 0.140096},
-    {0.103616, 0.104167, 0.144927},
-    {0.107069, 0.107639, 0.149758},
-    {0.110523, 0.111111, 0.154589},
-    {0.113977, 0.114583, 0.15942},
-    {0.117431, 0.118055, 0.164251},
-    {0.120885, 0.121528, 0.169082},
-    {0.124339, 0.125, 0.173913},
-    {0.127793, 0.128472, 0.178744},
-    {0.131246, 0.131944, 0.183575},
-    {0.1347, 0.135416, 0.188406},
-    {0.138154, 0.138889, 0.193237},
-    {0.141608, 0.142361, 0.198067},
-    {0.145062, 0.145833, 0.202898},
-    {0.148516, 0.149305, 0.207729},
-    {0.151969, 0.152778, 0.21256},
-    {0.155423, 0.15625, 0.217391},
-    {0.158877, 0.159722, 0.222222},
-    {0.162331, 0.163194, 0.227053},
-    {0.165785, 0.166666, 0.231884},
-    {0.169239, 0.170139, 0.236715},
-    {0.172693, 0.173611, 0.241546},
-    {0.176146, 0.177083, 0.246377},
-    {0.1796, 0.180555, 0.251207},
-    {0.183054, 0.184028, 0.256038},
-    {0.186508, 0.1875, 0.260869},
-    {0.189962, 0.190972, 0.2657},
-    {0.193416, 0.194444, 0.270531},
-    {0.19687, 0.197916, 0.275362},
-    {0.200323, 0.201389, 0.280193},
-    {0.203777, 0.204861, 0.285024},
-    {0.207231, 0.208333, 0.289855},
-    {0.210685, 0.211805, 0.294686},
-    {0.214139, 0.215277, 0.299517},
-    {0.217593, 0.21875, 0.304348},
-    {0.221047, 0.222222, 0.309178},
-    {0.2245, 0.225694, 0.314009},
-    {0.227954, 0.229166, 0.31884},
-    {0.231408, 0.232639, 0.323671},
-    {0.234862, 0.236111, 0.328502},
-    {0.238316, 0.239583, 0.333333},
-    {0.24177, 0.243055, 0.338164},
-    {0.245223, 0.246527, 0.342995},
-    {0.248677, 0.25, 0.347826},
-    {0.252131, 0.253472, 0.352657},
-    {0.255585, 0.256944, 0.357488},
-    {0.259039, 0.260416, 0.362318},
-    {0.262493, 0.263889, 0.367149},
-    {0.265947, 0.267361, 0.37198},
-    {0.2694, 0.270833, 0.376811},
-    {0.272854, 0.274305, 0.381642},
-    {0.276308, 0.277777, 0.386473},
-    {0.279762, 0.28125, 0.391304},
-    {0.283216, 0.284722, 0.396135},
-    {0.28667, 0.288194, 0.400966},
-    {0.290124, 0.291666, 0.405797},
-    {0.293577, 0.295138, 0.410628},
-    {0.297031, 0.298611, 0.415459},
-    {0.300485, 0.302083, 0.420289},
-    {0.303939, 0.305555, 0.42512},
-    {0.307393, 0.309027, 0.429951},
-    {0.310847, 0.3125, 0.434782},
-    {0.314301, 0.315972, 0.439613},
-    {0.317754, 0.319444, 0.444444},
-    {0.321208, 0.319444, 0.444444},
-    {0.324662, 0.324218, 0.447873},
-    {0.328116, 0.328993, 0.451303},
-    {0.33157, 0.333767, 0.454732},
-    {0.335024, 0.338541, 0.458161},
-    {0.338477, 0.343316, 0.461591},
-    {0.341931, 0.34809, 0.46502},
-    {0.345385, 0.352864, 0.46845},
-    {0.348839, 0.357638, 0.471879},
-    {0.352293, 0.362413, 0.475308},
-    {0.355747, 0.367187, 0.478738},
-    {0.359201, 0.371961, 0.482167},
-    {0.362654, 0.376736, 0.485596},
-    {0.366108, 0.38151, 0.489026},
-    {0.369562, 0.386284, 0.492455},
-    {0.373016, 0.391059, 0.495884},
-    {0.37647, 0.395833, 0.499314},
-    {0.379924, 0.400607, 0.502743},
-    {0.383378, 0.405382, 0.506172},
-    {0.386831, 0.410156, 0.509602},
-    {0.390285, 0.41493, 0.513031},
-    {0.393739, 0.419705, 0.516461},
-    {0.397193, 0.424479, 0.51989},
-    {0.400647, 0.429253, 0.523319},
-    {0.404101, 0.434028, 0.526749},
-    {0.407555, 0.438802, 0.530178},
-    {0.411008, 0.443576, 0.533607},
-    {0.414462, 0.44835, 0.537037},
-    {0.417916, 0.453125, 0.540466},
-    {0.42137, 0.457899, 0.543895},
-    {0.424824, 0.462673, 0.547325},
-    {0.428278, 0.467448, 0.550754},
-    {0.431731, 0.472222, 0.554183},
-    {0.435185, 0.476996, 0.557613},
-    {0.438639, 0.481771, 0.561042},
-    {0.442093, 0.486545, 0.564472},
-    {0.445547, 0.491319, 0.567901},
-    {0.449001, 0.496094, 0.57133},
-    {0.452455, 0.500868, 0.57476},
-    {0.455908, 0.505642, 0.578189},
-    {0.459362, 0.510416, 0.581618},
-    {0.462816, 0.515191, 0.585048},
-    {0.46627, 0.519965, 0.588477},
-    {0.469724, 0.524739, 0.591906},
-    {0.473178, 0.529514, 0.595336},
-    {0.476632, 0.534288, 0.598765},
-    {0.480085, 0.539062, 0.602194},
-    {0.483539, 0.543837, 0.605624},
-    {0.486993, 0.548611, 0.609053},
-    {0.490447, 0.553385, 0.612483},
-    {0.493901, 0.55816, 0.615912},
-    {0.497355, 0.562934, 0.619341},
-    {0.500809, 0.567708, 0.622771},
-    {0.504262, 0.572483, 0.6262},
-    {0.507716, 0.577257, 0.629629},
-    {0.51117, 0.582031, 0.633059},
-    {0.514624, 0.586805, 0.636488},
-    {0.518078, 0.59158, 0.639917},
-    {0.521532, 0.596354, 0.643347},
-    {0.524985, 0.601128, 0.646776},
-    {0.528439, 0.605903, 0.650205},
-    {0.531893, 0.610677, 0.653635},
-    {0.535347, 0.615451, 0.657064},
-    {0.538801, 0.620226, 0.660494},
-    {0.542255, 0.625, 0.663923},
-    {0.545709, 0.629774, 0.667352},
-    {0.549162, 0.634549, 0.670782},
-    {0.552616, 0.639323, 0.674211},
-    {0.55607, 0.644097, 0.67764},
-    {0.559524, 0.648872, 0.68107},
-    {0.562978, 0.653646, 0.684499},
-    {0.566432, 0.65842, 0.687928},
-    {0.569886, 0.663194, 0.691358},
-    {0.573339, 0.667969, 0.694787},
-    {0.576793, 0.672743, 0.698216},
-    {0.580247, 0.677517, 0.701646},
-    {0.583701, 0.682292, 0.705075},
-    {0.587155, 0.687066, 0.708505},
-    {0.590609, 0.69184, 0.711934},
-    {0.594063, 0.696615, 0.715363},
-    {0.597516, 0.701389, 0.718793},
-    {0.60097, 0.706163, 0.722222},
-    {0.604424, 0.710938, 0.725651},
-    {0.607878, 0.715712, 0.729081},
-    {0.611332, 0.720486, 0.73251},
-    {0.614786, 0.725261, 0.735939},
-    {0.618239, 0.730035, 0.739369},
-    {0.621693, 0.734809, 0.742798},
-    {0.625147, 0.739583, 0.746228},
-    {0.628601, 0.744358, 0.749657},
-    {0.632055, 0.749132, 0.753086},
-    {0.635509, 0.753906, 0.756516},
-    {0.638963, 0.758681, 0.759945},
-    {0.642416, 0.763455, 0.763374},
-    {0.64587, 0.768229, 0.766804},
-    {0.649324, 0.773004, 0.770233},
-    {0.652778, 0.777778, 0.773662},
-    {0.652778, 0.777778, 0.777092},
-    {0.65812, 0.781197, 0.780521},
-    {0.663462, 0.784616, 0.78395},
-    {0.668804, 0.788034, 0.78738},
-    {0.674146, 0.791453, 0.790809},
-    {0.679487, 0.794872, 0.794239},
-    {0.684829, 0.798291, 0.797668},
-    {0.690171, 0.80171, 0.801097},
-    {0.695513, 0.805128, 0.804527},
-    {0.700855, 0.808547, 0.807956},
-    {0.706197, 0.811966, 0.811385},
-    {0.711539, 0.815385, 0.814815},
-    {0.716881, 0.818804, 0.818244},
-    {0.722222, 0.822222, 0.821673},
-    {0.727564, 0.825641, 0.825103},
-    {0.732906, 0.82906, 0.828532},
-    {0.738248, 0.832479, 0.831961},
-    {0.74359, 0.835898, 0.835391},
-    {0.748932, 0.839316, 0.83882},
-    {0.754274, 0.842735, 0.84225},
-    {0.759616, 0.846154, 0.845679},
-    {0.764957, 0.849573, 0.849108},
-    {0.770299, 0.852992, 0.852538},
-    {0.775641, 0.85641, 0.855967},
-    {0.780983, 0.859829, 0.859396},
-    {0.786325, 0.863248, 0.862826},
-    {0.791667, 0.866667, 0.866255},
-    {0.797009, 0.870086, 0.869684},
-    {0.802351, 0.873504, 0.873114},
-    {0.807692, 0.876923, 0.876543},
-    {0.813034, 0.880342, 0.879972},
-    {0.818376, 0.883761, 0.883402},
-    {0.823718, 0.88718, 0.886831},
-    {0.82906, 0.890598, 0.890261},
-    {0.834402, 0.894017, 0.89369},
-    {0.839744, 0.897436, 0.897119},
-    {0.845086, 0.900855, 0.900549},
-    {0.850427, 0.904274, 0.903978},
-    {0.855769, 0.907692, 0.907407},
-    {0.861111, 0.911111, 0.910837},
-    {0.866453, 0.91453, 0.914266},
-    {0.871795, 0.917949, 0.917695},
-    {0.877137, 0.921368, 0.921125},
-    {0.882479, 0.924786, 0.924554},
-    {0.887821, 0.928205, 0.927983},
-    {0.893162, 0.931624, 0.931413},
-    {0.898504, 0.935043, 0.934842},
-    {0.903846, 0.938462, 0.938272},
-    {0.909188, 0.94188, 0.941701},
-    {0.91453, 0.945299, 0.94513},
-    {0.919872, 0.948718, 0.94856},
-    {0.925214, 0.952137, 0.951989},
-    {0.930556, 0.955556, 0.955418},
-    {0.935897, 0.958974, 0.958848},
-    {0.941239, 0.962393, 0.962277},
-    {0.946581, 0.965812, 0.965706},
-    {0.951923, 0.969231, 0.969136},
-    {0.957265, 0.97265, 0.972565},
-    {0.962607, 0.976068, 0.975994},
-    {0.967949, 0.979487, 0.979424},
-    {0.973291, 0.982906, 0.982853},
-    {0.978632, 0.986325, 0.986283},
-    {0.983974, 0.989744, 0.989712},
-    {0.989316, 0.993162, 0.993141},
-    {0.994658, 0.996581, 0.996571},
-    {1, 1, 1},
+constexpr ControlPoint cool[] = {
+    {0.f, {0.f, 1.f, 1.f}},
+    {1.f, {1.f, 0.f, 1.f}},
 };
 
-constexpr colormap_t cool = {
-    {0, 1, 1},
-    {0.00392157, 0.996078, 1},
-    {0.00784314, 0.992157, 1},
-    {0.0117647, 0.988235, 1},
-    {0.0156863, 0.984314, 1},
-    {0.0196078, 0.980392, 1},
-    {0.0235294, 0.976471, 1},
-    {0.027451, 0.972549, 1},
-    {0.0313725, 0.968627, 1},
-    {0.0352941, 0.964706, 1},
-    {0.0392157, 0.960784, 1},
-    {0.0431373, 0.956863, 1},
-    {0.0470588, 0.952941, 1},
-    {0.0509804, 0.94902, 1},
-    {0.054902, 0.945098, 1},
-    {0.0588235, 0.941176, 1},
-    {0.0627451, 0.937255, 1},
-    {0.0666667, 0.933333, 1},
-    {0.0705882, 0.929412, 1},
-    {0.0745098, 0.92549, 1},
-    {0.0784314, 0.921569, 1},
-    {0.0823529, 0.917647, 1},
-    {0.0862745, 0.913725, 1},
-    {0.0901961, 0.909804, 1},
-    {0.0941176, 0.905882, 1},
-    {0.0980392, 0.901961, 1},
-    {0.101961, 0.898039, 1},
-    {0.105882, 0.894118, 1},
-    {0.109804, 0.890196, 1},
-    {0.113725, 0.886275, 1},
-    {0.117647, 0.882353, 1},
-    {0.121569, 0.878431, 1},
-    {0.12549, 0.87451, 1},
-    {0.129412, 0.870588, 1},
-    {0.133333, 0.866667, 1},
-    {0.137255, 0.862745, 1},
-    {0.141176, 0.858824, 1},
-    {0.145098, 0.854902, 1},
-    {0.14902, 0.85098, 1},
-    {0.152941, 0.847059, 1},
-    {0.156863, 0.843137, 1},
-    {0.160784, 0.839216, 1},
-    {0.164706, 0.835294, 1},
-    {0.168627, 0.831373, 1},
-    {0.172549, 0.827451, 1},
-    {0.176471, 0.823529, 1},
-    {0.180392, 0.819608, 1},
-    {0.184314, 0.815686, 1},
-    {0.188235, 0.811765, 1},
-    {0.192157, 0.807843, 1},
-    {0.196078, 0.803922, 1},
-    {0.2, 0.8, 1},
-    {0.203922, 0.796078, 1},
-    {0.207843, 0.792157, 1},
-    {0.211765, 0.788235, 1},
-    {0.215686, 0.784314, 1},
-    {0.219608, 0.780392, 1},
-    {0.223529, 0.776471, 1},
-    {0.227451, 0.772549, 1},
-    {0.231373, 0.768627, 1},
-    {0.235294, 0.764706, 1},
-    {0.239216, 0.760784, 1},
-    {0.243137, 0.756863, 1},
-    {0.247059, 0.752941, 1},
-    {0.25098, 0.74902, 1},
-    {0.254902, 0.745098, 1},
-    {0.258824, 0.741176, 1},
-    {0.262745, 0.737255, 1},
-    {0.266667, 0.733333, 1},
-    {0.270588, 0.729412, 1},
-    {0.27451, 0.72549, 1},
-    {0.278431, 0.721569, 1},
-    {0.282353, 0.717647, 1},
-    {0.286275, 0.713725, 1},
-    {0.290196, 0.709804, 1},
-    {0.294118, 0.705882, 1},
-    {0.298039, 0.701961, 1},
-    {0.301961, 0.698039, 1},
-    {0.305882, 0.694118, 1},
-    {0.309804, 0.690196, 1},
-    {0.313725, 0.686275, 1},
-    {0.317647, 0.682353, 1},
-    {0.321569, 0.678431, 1},
-    {0.32549, 0.67451, 1},
-    {0.329412, 0.670588, 1},
-    {0.333333, 0.666667, 1},
-    {0.337255, 0.662745, 1},
-    {0.341176, 0.658824, 1},
-    {0.345098, 0.654902, 1},
-    {0.34902, 0.65098, 1},
-    {0.352941, 0.647059, 1},
-    {0.356863, 0.643137, 1},
-    {0.360784, 0.639216, 1},
-    {0.364706, 0.635294, 1},
-    {0.368627, 0.631373, 1},
-    {0.372549, 0.627451, 1},
-    {0.376471, 0.623529, 1},
-    {0.380392, 0.619608, 1},
-    {0.384314, 0.615686, 1},
-    {0.388235, 0.611765, 1},
-    {0.392157, 0.607843, 1},
-    {0.396078, 0.603922, 1},
-    {0.4, 0.6, 1},
-    {0.403922, 0.596078, 1},
-    {0.407843, 0.592157, 1},
-    {0.411765, 0.588235, 1},
-    {0.415686, 0.584314, 1},
-    {0.419608, 0.580392, 1},
-    {0.423529, 0.576471, 1},
-    {0.427451, 0.572549, 1},
-    {0.431373, 0.568627, 1},
-    {0.435294, 0.564706, 1},
-    {0.439216, 0.560784, 1},
-    {0.443137, 0.556863, 1},
-    {0.447059, 0.552941, 1},
-    {0.45098, 0.54902, 1},
-    {0.454902, 0.545098, 1},
-    {0.458824, 0.541176, 1},
-    {0.462745, 0.537255, 1},
-    {0.466667, 0.533333, 1},
-    {0.470588, 0.529412, 1},
-    {0.47451, 0.52549, 1},
-    {0.478431, 0.521569, 1},
-    {0.482353, 0.517647, 1},
-    {0.486275, 0.513725, 1},
-    {0.490196, 0.509804, 1},
-    {0.494118, 0.505882, 1},
-    {0.498039, 0.501961, 1},
-    {0.501961, 0.498039, 1},
-    {0.505882, 0.494118, 1},
-    {0.509804, 0.490196, 1},
-    {0.513725, 0.486275, 1},
-    {0.517647, 0.482353, 1},
-    {0.521569, 0.478431, 1},
-    {0.52549, 0.47451, 1},
-    {0.529412, 0.470588, 1},
-    {0.533333, 0.466667, 1},
-    {0.537255, 0.462745, 1},
-    {0.541176, 0.458824, 1},
-    {0.545098, 0.454902, 1},
-    {0.54902, 0.45098, 1},
-    {0.552941, 0.447059, 1},
-    {0.556863, 0.443137, 1},
-    {0.560784, 0.439216, 1},
-    {0.564706, 0.435294, 1},
-    {0.568627, 0.431373, 1},
-    {0.572549, 0.427451, 1},
-    {0.576471, 0.423529, 1},
-    {0.580392, 0.419608, 1},
-    {0.584314, 0.415686, 1},
-    {0.588235, 0.411765, 1},
-    {0.592157, 0.407843, 1},
-    {0.596078, 0.403922, 1},
-    {0.6, 0.4, 1},
-    {0.603922, 0.396078, 1},
-    {0.607843, 0.392157, 1},
-    {0.611765, 0.388235, 1},
-    {0.615686, 0.384314, 1},
-    {0.619608, 0.380392, 1},
-    {0.623529, 0.376471, 1},
-    {0.627451, 0.372549, 1},
-    {0.631373, 0.368627, 1},
-    {0.635294, 0.364706, 1},
-    {0.639216, 0.360784, 1},
-    {0.643137, 0.356863, 1},
-    {0.647059, 0.352941, 1},
-    {0.65098, 0.34902, 1},
-    {0.654902, 0.345098, 1},
-    {0.658824, 0.341176, 1},
-    {0.662745, 0.337255, 1},
-    {0.666667, 0.333333, 1},
-    {0.670588, 0.329412, 1},
-    {0.67451, 0.32549, 1},
-    {0.678431, 0.321569, 1},
-    {0.682353, 0.317647, 1},
-    {0.686275, 0.313725, 1},
-    {0.690196, 0.309804, 1},
-    {0.694118, 0.305882, 1},
-    {0.698039, 0.301961, 1},
-    {0.701961, 0.298039, 1},
-    {0.705882, 0.294118, 1},
-    {0.709804, 0.290196, 1},
-    {0.713725, 0.286275, 1},
-    {0.717647, 0.282353, 1},
-    {0.721569, 0.278431, 1},
-    {0.72549, 0.27451, 1},
-    {0.729412, 0.270588, 1},
-    {0.733333, 0.266667, 1},
-    {0.737255, 0.262745, 1},
-    {0.741176, 0.258824, 1},
-    {0.745098, 0.254902, 1},
-    {0.74902, 0.25098, 1},
-    {0.752941, 0.247059, 1},
-    {0.756863, 0.243137, 1},
-    {0.760784, 0.239216, 1},
-    {0.764706, 0.235294, 1},
-    {0.768627, 0.231373, 1},
-    {0.772549, 0.227451, 1},
-    {0.776471, 0.223529, 1},
-    {0.780392, 0.219608, 1},
-    {0.784314, 0.215686, 1},
-    {0.788235, 0.211765, 1},
-    {0.792157, 0.207843, 1},
-    {0.796078, 0.203922, 1},
-    {0.8, 0.2, 1},
-    {0.803922, 0.196078, 1},
-    {0.807843, 0.192157, 1},
-    {0.811765, 0.188235, 1},
-    {0.815686, 0.184314, 1},
-    {0.819608, 0.180392, 1},
-    {0.823529, 0.176471, 1},
-    {0.827451, 0.172549, 1},
-    {0.831373, 0.168627, 1},
-    {0.835294, 0.164706, 1},
-    {0.839216, 0.160784, 1},
-    {0.843137, 0.156863, 1},
-    {0.847059, 0.152941, 1},
-    {0.85098, 0.14902, 1},
-    {0.854902, 0.145098, 1},
-    {0.858824, 0.141176, 1},
-    {0.862745, 0.137255, 1},
-    {0.866667, 0.133333, 1},
-    {0.870588, 0.129412, 1},
-    {0.87451, 0.12549, 1},
-    {0.878431, 0.121569, 1},
-    {0.882353, 0.117647, 1},
-    {0.886275, 0.113725, 1},
-    {0.890196, 0.109804, 1},
-    {0.894118, 0.105882, 1},
-    {0.898039, 0.101961, 1},
-    {0.901961, 0.0980392, 1},
-    {0.905882, 0.0941176, 1},
-    {0.909804, 0.0901961, 1},
-    {0.913725, 0.0862745, 1},
-    {0.917647, 0.0823529, 1},
-    {0.921569, 0.0784314, 1},
-    {0.92549, 0.0745098, 1},
-    {0.929412, 0.0705882, 1},
-    {0.933333, 0.0666667, 1},
-    {0.937255, 0.0627451, 1},
-    {0.941176, 0.0588235, 1},
-    {0.945098, 0.054902, 1},
-    {0.94902, 0.0509804, 1},
-    {0.952941, 0.0470588, 1},
-    {0.956863, 0.0431373, 1},
-    {0.960784, 0.0392157, 1},
-    {0.964706, 0.0352941, 1},
-    {0.968627, 0.0313725, 1},
-    {0.972549, 0.027451, 1},
-    {0.976471, 0.0235294, 1},
-    {0.980392, 0.0196078, 1},
-    {0.984314, 0.0156863, 1},
-    {0.988235, 0.0117647, 1},
-    {0.992157, 0.00784314, 1},
-    {0.996078, 0.00392157, 1},
-    {1, 0, 1},
+constexpr ControlPoint hot[] = {
+    {0.f, {0.0416f, 0.f, 0.f}},
+    {0.360784f, {1.f, 0.f, 0.f}},
+    {0.364706f, {1.f, 0.f, 0.f}},
+    {0.741176f, {1.f, 1.f, 0.f}},
+    {0.745098f, {1.f, 1.f, 0.f}},
+    {1.f, {1.f, 1.f, 1.f}},
 };
 
-constexpr colormap_t hot = {
-    {0.0416, 0, 0},    {0.0520174, 0, 0}, {0.0624348, 0, 0},
-    {0.0728522, 0, 0}, {0.0832696, 0, 0}, {0.093687, 0, 0},
-    {0.104104, 0, 0},  {0.114522, 0, 0},  {0.124939, 0, 0},
-    {0.135357, 0, 0},  {0.145774, 0, 0},  {0.156191, 0, 0},
-    {0.166609, 0, 0},  {0.177026, 0, 0},  {0.187443, 0, 0},
-    {0.197861, 0, 0},  {0.208278, 0, 0},  {0.218696, 0, 0},
-    {0.229113, 0, 0},  {0.23953, 0, 0},   {0.249948, 0, 0},
-    {0.260365, 0, 0},  {0.270783, 0, 0},  {0.2812, 0, 0},
-    {0.291617, 0, 0},  {0.302035, 0, 0},  {0.312452, 0, 0},
-    {0.32287, 0, 0},   {0.333287, 0, 0},  {0.343704, 0, 0},
-    {0.354122, 0, 0},  {0.364539, 0, 0},  {0.374957, 0, 0},
-    {0.385374, 0, 0},  {0.395791, 0, 0},  {0.406209, 0, 0},
-    {0.416626, 0, 0},  {0.427043, 0, 0},  {0.437461, 0, 0},
-    {0.447878, 0, 0},  {0.458296, 0, 0},  {0.468713, 0, 0},
-    {0.47913, 0, 0},   {0.489548, 0, 0},  {0.499965, 0, 0},
-    {0.510383, 0, 0},  {0.5208, 0, 0},    {0.531217, 0, 0},
-    {0.541635, 0, 0},  {0.552052, 0, 0},  {0.56247, 0, 0},
-    {0.572887, 0, 0},  {0.583304, 0, 0},  {0.593722, 0, 0},
-    {0.604139, 0, 0},  {0.614557, 0, 0},  {0.624974, 0, 0},
-    {0.635391, 0, 0},  {0.645809, 0, 0},  {0.656226, 0, 0},
-    {0.666643, 0, 0},  {0.677061, 0, 0},  {0.687478, 0, 0},
-    {0.697896, 0, 0},  {0.708313, 0, 0},  {0.71873, 0, 0},
-    {0.729148, 0, 0},  {0.739565, 0, 0},  {0.749983, 0, 0},
-    {0.7604, 0, 0},    {0.770817, 0, 0},  {0.781235, 0, 0},
-    {0.791652, 0, 0},  {0.80207, 0, 0},   {0.812487, 0, 0},
-    {0.822904, 0, 0},  {0.833322, 0, 0},  {0.843739, 0, 0},
-    {0.854157, 0, 0},  {0.864574, 0, 0},  {0.874991, 0, 0},
-    {0.885409, 0, 0},  {0.895826, 0, 0},  {0.906243, 0, 0},
-    {0.916661, 0, 0},  {0.927078, 0, 0},  {0.937496, 0, 0},
-    {0.947913, 0, 0},  {0.95833, 0, 0},   {0.968748, 0, 0},
-    {0.979165, 0, 0},  {0.989583, 0, 0},  {1, 0, 0},
-    {1, 0, 0},         {1, 0.0104167, 0}, {1, 0.0208333, 0},
-    {1, 0.03125, 0},   {1, 0.0416667, 0}, {1, 0.0520833, 0},
-    {1, 0.0625, 0},    {1, 0.0729167, 0}, {1, 0.0833333, 0},
-    {1, 0.09375, 0},   {1, 0.104167, 0},  {1, 0.114583, 0},
-    {1, 0.125, 0},     {1, 0.135417, 0},  {1, 0.145833, 0},
-    {1, 0.15625, 0},   {1, 0.166667, 0},  {1, 0.177083, 0},
-    {1, 0.1875, 0},    {1, 0.197917, 0},  {1, 0.208333, 0},
-    {1, 0.21875, 0},   {1, 0.229167, 0},  {1, 0.239583, 0},
-    {1, 0.25, 0},      {1, 0.260417, 0},  {1, 0.270833, 0},
-    {1, 0.28125, 0},   {1, 0.291667, 0},  {1, 0.302083, 0},
-    {1, 0.3125, 0},    {1, 0.322917, 0},  {1, 0.333333, 0},
-    {1, 0.34375, 0},   {1, 0.354167, 0},  {1, 0.364583, 0},
-    {1, 0.375, 0},     {1, 0.385417, 0},  {1, 0.395833, 0},
-    {1, 0.40625, 0},   {1, 0.416667, 0},  {1, 0.427083, 0},
-    {1, 0.4375, 0},    {1, 0.447917, 0},  {1, 0.458333, 0},
-    {1, 0.46875, 0},   {1, 0.479167, 0},  {1, 0.489583, 0},
-    {1, 0.5, 0},       {1, 0.510417, 0},  {1, 0.520833, 0},
-    {1, 0.53125, 0},   {1, 0.541667, 0},  {1, 0.552083, 0},
-    {1, 0.5625, 0},    {1, 0.572917, 0},  {1, 0.583333, 0},
-    {1, 0.59375, 0},   {1, 0.604167, 0},  {1, 0.614583, 0},
-    {1, 0.625, 0},     {1, 0.635417, 0},  {1, 0.645833, 0},
-    {1, 0.65625, 0},   {1, 0.666667, 0},  {1, 0.677083, 0},
-    {1, 0.6875, 0},    {1, 0.697917, 0},  {1, 0.708333, 0},
-    {1, 0.71875, 0},   {1, 0.729167, 0},  {1, 0.739583, 0},
-    {1, 0.75, 0},      {1, 0.760417, 0},  {1, 0.770833, 0},
-    {1, 0.78125, 0},   {1, 0.791667, 0},  {1, 0.802083, 0},
-    {1, 0.8125, 0},    {1, 0.822917, 0},  {1, 0.833333, 0},
-    {1, 0.84375, 0},   {1, 0.854167, 0},  {1, 0.864583, 0},
-    {1, 0.875, 0},     {1, 0.885417, 0},  {1, 0.895833, 0},
-    {1, 0.90625, 0},   {1, 0.916667, 0},  {1, 0.927083, 0},
-    {1, 0.9375, 0},    {1, 0.947917, 0},  {1, 0.958333, 0},
-    {1, 0.96875, 0},   {1, 0.979167, 0},  {1, 0.989583, 0},
-    {1, 1, 0},         {1, 1, 0},         {1, 1, 0.0153846},
-    {1, 1, 0.0307692}, {1, 1, 0.0461538}, {1, 1, 0.0615385},
-    {1, 1, 0.0769231}, {1, 1, 0.0923077}, {1, 1, 0.107692},
-    {1, 1, 0.123077},  {1, 1, 0.138462},  {1, 1, 0.153846},
-    {1, 1, 0.169231},  {1, 1, 0.184615},  {1, 1, 0.2},
-    {1, 1, 0.215385},  {1, 1, 0.230769},  {1, 1, 0.246154},
-    {1, 1, 0.261538},  {1, 1, 0.276923},  {1, 1, 0.292308},
-    {1, 1, 0.307692},  {1, 1, 0.323077},  {1, 1, 0.338462},
-    {1, 1, 0.353846},  {1, 1, 0.369231},  {1, 1, 0.384615},
-    {1, 1, 0.4},       {1, 1, 0.415385},  {1, 1, 0.430769},
-    {1, 1, 0.446154},  {1, 1, 0.461538},  {1, 1, 0.476923},
-    {1, 1, 0.492308},  {1, 1, 0.507692},  {1, 1, 0.523077},
-    {1, 1, 0.538462},  {1, 1, 0.553846},  {1, 1, 0.569231},
-    {1, 1, 0.584615},  {1, 1, 0.6},       {1, 1, 0.615385},
-    {1, 1, 0.630769},  {1, 1, 0.646154},  {1, 1, 0.661538},
-    {1, 1, 0.676923},  {1, 1, 0.692308},  {1, 1, 0.707692},
-    {1, 1, 0.723077},  {1, 1, 0.738462},  {1, 1, 0.753846},
-    {1, 1, 0.769231},  {1, 1, 0.784615},  {1, 1, 0.8},
-    {1, 1, 0.815385},  {1, 1, 0.830769},  {1, 1, 0.846154},
-    {1, 1, 0.861538},  {1, 1, 0.876923},  {1, 1, 0.892308},
-    {1, 1, 0.907692},  {1, 1, 0.923077},  {1, 1, 0.938462},
-    {1, 1, 0.953846},  {1, 1, 0.969231},  {1, 1, 0.984615},
-    {1, 1, 1},
+constexpr ControlPoint copper[] = {
+    {0.f, {0.f, 0.f, 0.f}},
+    {0.807843f, {1.f, 0.631087f, 0.401902f}},
+    {1.f, {1.f, 0.7812f, 0.4975f}},
 };
 
-constexpr colormap_t copper = {
-    {0, 0, 0},
-    {0.00485437, 0.00306353, 0.00195098},
-    {0.00970874, 0.00612706, 0.00390196},
-    {0.0145631, 0.00919059, 0.00585294},
-    {0.0194175, 0.0122541, 0.00780392},
-    {0.0242718, 0.0153176, 0.0097549},
-    {0.0291262, 0.0183812, 0.0117059},
-    {0.0339806, 0.0214447, 0.0136569},
-    {0.038835, 0.0245082, 0.0156078},
-    {0.0436893, 0.0275718, 0.0175588},
-    {0.0485437, 0.0306353, 0.0195098},
-    {0.0533981, 0.0336988, 0.0214608},
-    {0.0582524, 0.0367624, 0.0234118},
-    {0.0631068, 0.0398259, 0.0253627},
-    {0.0679612, 0.0428894, 0.0273137},
-    {0.0728155, 0.0459529, 0.0292647},
-    {0.0776699, 0.0490165, 0.0312157},
-    {0.0825243, 0.05208, 0.0331667},
-    {0.0873786, 0.0551435, 0.0351176},
-    {0.092233, 0.0582071, 0.0370686},
-    {0.0970874, 0.0612706, 0.0390196},
-    {0.101942, 0.0643341, 0.0409706},
-    {0.106796, 0.0673976, 0.0429216},
-    {0.11165, 0.0704612, 0.0448725},
-    {0.116505, 0.0735247, 0.0468235},
-    {0.121359, 0.0765882, 0.0487745},
-    {0.126214, 0.0796518, 0.0507255},
-    {0.131068, 0.0827153, 0.0526765},
-    {0.135922, 0.0857788, 0.0546275},
-    {0.140777, 0.0888424, 0.0565784},
-    {0.145631, 0.0919059, 0.0585294},
-    {0.150485, 0.0949694, 0.0604804},
-    {0.15534, 0.0980329, 0.0624314},
-    {0.160194, 0.101096, 0.0643824},
-    {0.165049, 0.10416, 0.0663333},
-    {0.169903, 0.107224, 0.0682843},
-    {0.174757, 0.110287, 0.0702353},
-    {0.179612, 0.113351, 0.0721863},
-    {0.184466, 0.116414, 0.0741373},
-    {0.18932, 0.119478, 0.0760882},
-    {0.194175, 0.122541, 0.0780392},
-    {0.199029, 0.125605, 0.0799902},
-    {0.203883, 0.128668, 0.0819412},
-    {0.208738, 0.131732, 0.0838922},
-    {0.213592, 0.134795, 0.0858431},
-    {0.218447, 0.137859, 0.0877941},
-    {0.223301, 0.140922, 0.0897451},
-    {0.228155, 0.143986, 0.0916961},
-    {0.23301, 0.147049, 0.0936471},
-    {0.237864, 0.150113, 0.095598},
-    {0.242718, 0.153176, 0.097549},
-    {0.247573, 0.15624, 0.0995},
-    {0.252427, 0.159304, 0.101451},
-    {0.257282, 0.162367, 0.103402},
-    {0.262136, 0.165431, 0.105353},
-    {0.26699, 0.168494, 0.107304},
-    {0.271845, 0.171558, 0.109255},
-    {0.276699, 0.174621, 0.111206},
-    {0.281553, 0.177685, 0.113157},
-    {0.286408, 0.180748, 0.115108},
-    {0.291262, 0.183812, 0.117059},
-    {0.296117, 0.186875, 0.11901},
-    {0.300971, 0.189939, 0.120961},
-    {0.305825, 0.193002, 0.122912},
-    {0.31068, 0.196066, 0.124863},
-    {0.315534, 0.199129, 0.126814},
-    {0.320388, 0.202193, 0.128765},
-    {0.325243, 0.205256, 0.130716},
-    {0.330097, 0.20832, 0.132667},
-    {0.334951, 0.211384, 0.134618},
-    {0.339806, 0.214447, 0.136569},
-    {0.34466, 0.217511, 0.13852},
-    {0.349515, 0.220574, 0.140471},
-    {0.354369, 0.223638, 0.142422},
-    {0.359223, 0.226701, 0.144373},
-    {0.364078, 0.229765, 0.146324},
-    {0.368932, 0.232828, 0.148275},
-    {0.373786, 0.235892, 0.150225},
-    {0.378641, 0.238955, 0.152176},
-    {0.383495, 0.242019, 0.154127},
-    {0.38835, 0.245082, 0.156078},
-    {0.393204, 0.248146, 0.158029},
-    {0.398058, 0.251209, 0.15998},
-    {0.402913, 0.254273, 0.161931},
-    {0.407767, 0.257336, 0.163882},
-    {0.412621, 0.2604, 0.165833},
-    {0.417476, 0.263464, 0.167784},
-    {0.42233, 0.266527, 0.169735},
-    {0.427184, 0.269591, 0.171686},
-    {0.432039, 0.272654, 0.173637},
-    {0.436893, 0.275718, 0.175588},
-    {0.441748, 0.278781, 0.177539},
-    {0.446602, 0.281845, 0.17949},
-    {0.451456, 0.284908, 0.181441},
-    {0.456311, 0.287972, 0.183392},
-    {0.461165, 0.291035, 0.185343},
-    {0.466019, 0.294099, 0.187294},
-    {0.470874, 0.297162, 0.189245},
-    {0.475728, 0.300226, 0.191196},
-    {0.480583, 0.303289, 0.193147},
-    {0.485437, 0.306353, 0.195098},
-    {0.490291, 0.309416, 0.197049},
-    {0.495146, 0.31248, 0.199},
-    {0.5, 0.315544, 0.200951},
-    {0.504854, 0.318607, 0.202902},
-    {0.509709, 0.321671, 0.204853},
-    {0.514563, 0.324734, 0.206804},
-    {0.519417, 0.327798, 0.208755},
-    {0.524272, 0.330861, 0.210706},
-    {0.529126, 0.333925, 0.212657},
-    {0.533981, 0.336988, 0.214608},
-    {0.538835, 0.340052, 0.216559},
-    {0.543689, 0.343115, 0.21851},
-    {0.548544, 0.346179, 0.220461},
-    {0.553398, 0.349242, 0.222412},
-    {0.558252, 0.352306, 0.224363},
-    {0.563107, 0.355369, 0.226314},
-    {0.567961, 0.358433, 0.228265},
-    {0.572816, 0.361496, 0.230216},
-    {0.57767, 0.36456, 0.232167},
-    {0.582524, 0.367624, 0.234118},
-    {0.587379, 0.370687, 0.236069},
-    {0.592233, 0.373751, 0.23802},
-    {0.597087, 0.376814, 0.239971},
-    {0.601942, 0.379878, 0.241922},
-    {0.606796, 0.382941, 0.243873},
-    {0.61165, 0.386005, 0.245824},
-    {0.616505, 0.389068, 0.247775},
-    {0.621359, 0.392132, 0.249725},
-    {0.626214, 0.395195, 0.251676},
-    {0.631068, 0.398259, 0.253627},
-    {0.635922, 0.401322, 0.255578},
-    {0.640777, 0.404386, 0.257529},
-    {0.645631, 0.407449, 0.25948},
-    {0.650485, 0.410513, 0.261431},
-    {0.65534, 0.413576, 0.263382},
-    {0.660194, 0.41664, 0.265333},
-    {0.665049, 0.419704, 0.267284},
-    {0.669903, 0.422767, 0.269235},
-    {0.674757, 0.425831, 0.271186},
-    {0.679612, 0.428894, 0.273137},
-    {0.684466, 0.431958, 0.275088},
-    {0.68932, 0.435021, 0.277039},
-    {0.694175, 0.438085, 0.27899},
-    {0.699029, 0.441148, 0.280941},
-    {0.703883, 0.444212, 0.282892},
-    {0.708738, 0.447275, 0.284843},
-    {0.713592, 0.450339, 0.286794},
-    {0.718447, 0.453402, 0.288745},
-    {0.723301, 0.456466, 0.290696},
-    {0.728155, 0.459529, 0.292647},
-    {0.73301, 0.462593, 0.294598},
-    {0.737864, 0.465656, 0.296549},
-    {0.742718, 0.46872, 0.2985},
-    {0.747573, 0.471784, 0.300451},
-    {0.752427, 0.474847, 0.302402},
-    {0.757282, 0.477911, 0.304353},
-    {0.762136, 0.480974, 0.306304},
-    {0.76699, 0.484038, 0.308255},
-    {0.771845, 0.487101, 0.310206},
-    {0.776699, 0.490165, 0.312157},
-    {0.781553, 0.493228, 0.314108},
-    {0.786408, 0.496292, 0.316059},
-    {0.791262, 0.499355, 0.31801},
-    {0.796117, 0.502419, 0.319961},
-    {0.800971, 0.505482, 0.321912},
-    {0.805825, 0.508546, 0.323863},
-    {0.81068, 0.511609, 0.325814},
-    {0.815534, 0.514673, 0.327765},
-    {0.820388, 0.517736, 0.329716},
-    {0.825243, 0.5208, 0.331667},
-    {0.830097, 0.523864, 0.333618},
-    {0.834951, 0.526927, 0.335569},
-    {0.839806, 0.529991, 0.33752},
-    {0.84466, 0.533054, 0.339471},
-    {0.849515, 0.536118, 0.341422},
-    {0.854369, 0.539181, 0.343373},
-    {0.859223, 0.542245, 0.345324},
-    {0.864078, 0.545308, 0.347275},
-    {0.868932, 0.548372, 0.349225},
-    {0.873786, 0.551435, 0.351176},
-    {0.878641, 0.554499, 0.353127},
-    {0.883495, 0.557562, 0.355078},
-    {0.88835, 0.560626, 0.357029},
-    {0.893204, 0.563689, 0.35898},
-    {0.898058, 0.566753, 0.360931},
-    {0.902913, 0.569816, 0.362882},
-    {0.907767, 0.57288, 0.364833},
-    {0.912621, 0.575944, 0.366784},
-    {0.917476, 0.579007, 0.368735},
-    {0.92233, 0.582071, 0.370686},
-    {0.927184, 0.585134, 0.372637},
-    {0.932039, 0.588198, 0.374588},
-    {0.936893, 0.591261, 0.376539},
-    {0.941748, 0.594325, 0.37849},
-    {0.946602, 0.597388, 0.380441},
-    {0.951456, 0.600452, 0.382392},
-    {0.956311, 0.603515, 0.384343},
-    {0.961165, 0.606579, 0.386294},
-    {0.966019, 0.609642, 0.388245},
-    {0.970874, 0.612706, 0.390196},
-    {0.975728, 0.615769, 0.392147},
-    {0.980583, 0.618833, 0.394098},
-    {0.985437, 0.621896, 0.396049},
-    {0.990291, 0.62496, 0.398},
-    {0.995146, 0.628024, 0.399951},
-    {1, 0.631087, 0.401902},
-    {1, 0.634151, 0.403853},
-    {1, 0.637214, 0.405804},
-    {1, 0.640278, 0.407755},
-    {1, 0.643341, 0.409706},
-    {1, 0.646405, 0.411657},
-    {1, 0.649468, 0.413608},
-    {1, 0.652532, 0.415559},
-    {1, 0.655595, 0.41751},
-    {1, 0.658659, 0.419461},
-    {1, 0.661722, 0.421412},
-    {1, 0.664786, 0.423363},
-    {1, 0.667849, 0.425314},
-    {1, 0.670913, 0.427265},
-    {1, 0.673976, 0.429216},
-    {1, 0.67704, 0.431167},
-    {1, 0.680104, 0.433118},
-    {1, 0.683167, 0.435069},
-    {1, 0.686231, 0.43702},
-    {1, 0.689294, 0.438971},
-    {1, 0.692358, 0.440922},
-    {1, 0.695421, 0.442873},
-    {1, 0.698485, 0.444824},
-    {1, 0.701548, 0.446775},
-    {1, 0.704612, 0.448725},
-    {1, 0.707675, 0.450676},
-    {1, 0.710739, 0.452627},
-    {1, 0.713802, 0.454578},
-    {1, 0.716866, 0.456529},
-    {1, 0.719929, 0.45848},
-    {1, 0.722993, 0.460431},
-    {1, 0.726056, 0.462382},
-    {1, 0.72912, 0.464333},
-    {1, 0.732184, 0.466284},
-    {1, 0.735247, 0.468235},
-    {1, 0.738311, 0.470186},
-    {1, 0.741374, 0.472137},
-    {1, 0.744438, 0.474088},
-    {1, 0.747501, 0.476039},
-    {1, 0.750565, 0.47799},
-    {1, 0.753628, 0.479941},
-    {1, 0.756692, 0.481892},
-    {1, 0.759755, 0.483843},
-    {1, 0.762819, 0.485794},
-    {1, 0.765882, 0.487745},
-    {1, 0.768946, 0.489696},
-    {1, 0.772009, 0.491647},
-    {1, 0.775073, 0.493598},
-    {1, 0.778136, 0.495549},
-    {1, 0.7812, 0.4975},
+constexpr ControlPoint hsv[] = {
+    {0.f, {1.f, 0.f, 0.f}},
+    {0.152941f, {1.f, 0.9375f, 0.f}},
+    {0.156863f, {1.f, 0.9375f, 0.f}},
+    {0.168627f, {0.96875f, 1.f, 0.f}},
+    {0.172549f, {0.96875f, 1.f, 0.f}},
+    {0.329412f, {0.03125f, 1.f, 0.f}},
+    {0.333333f, {0.03125f, 1.f, 0.f}},
+    {0.345098f, {0.f, 1.f, 0.0625f}},
+    {0.34902f, {0.f, 1.f, 0.0625f}},
+    {0.505882f, {0.f, 1.f, 1.f}},
+    {0.509804f, {0.f, 1.f, 1.f}},
+    {0.662745f, {0.f, 0.0625f, 1.f}},
+    {0.666667f, {0.f, 0.0625f, 1.f}},
+    {0.678431f, {0.03125f, 0.f, 1.f}},
+    {0.682353f, {0.03125f, 0.f, 1.f}},
+    {0.839216f, {0.96875f, 0.f, 1.f}},
+    {0.843137f, {0.96875f, 0.f, 1.f}},
+    {0.854902f, {1.f, 0.f, 0.9375f}},
+    {0.858824f, {1.f, 0.f, 0.9375f}},
+    {1.f, {1.f, 0.f, 0.09375f}},
 };
 
-constexpr colormap_t hsv = {
-    {1, 0, 0},
-    {1, 0.0240385, 0},
-    {1, 0.0480769, 0},
-    {1, 0.0721154, 0},
-    {1, 0.0961538, 0},
-    {1, 0.120192, 0},
-    {1, 0.144231, 0},
-    {1, 0.168269, 0},
-    {1, 0.192308, 0},
-    {1, 0.216346, 0},
-    {1, 0.240385, 0},
-    {1, 0.264423, 0},
-    {1, 0.288462, 0},
-    {1, 0.3125, 0},
-    {1, 0.336538, 0},
-    {1, 0.360577, 0},
-    {1, 0.384615, 0},
-    {1, 0.408654, 0},
-    {1, 0.432692, 0},
-    {1, 0.456731, 0},
-    {1, 0.480769, 0},
-    {1, 0.504808, 0},
-    {1, 0.528846, 0},
-    {1, 0.552885, 0},
-    {1, 0.576923, 0},
-    {1, 0.600962, 0},
-    {1, 0.625, 0},
-    {1, 0.649038, 0},
-    {1, 0.673077, 0},
-    {1, 0.697115, 0},
-    {1, 0.721154, 0},
-    {1, 0.745192, 0},
-    {1, 0.769231, 0},
-    {1, 0.793269, 0},
-    {1, 0.817308, 0},
-    {1, 0.841346, 0},
-    {1, 0.865385, 0},
-    {1, 0.889423, 0},
-    {1, 0.913462, 0},
-    {1, 0.9375, 0},
-    {1, 0.9375, 0},
-    {0.989583, 0.958333, 0},
-    {0.979167, 0.979167, 0},
-    {0.96875, 1, 0},
-    {0.96875, 1, 0},
-    {0.945312, 1, 0},
-    {0.921875, 1, 0},
-    {0.898438, 1, 0},
-    {0.875, 1, 0},
-    {0.851562, 1, 0},
-    {0.828125, 1, 0},
-    {0.804688, 1, 0},
-    {0.78125, 1, 0},
-    {0.757812, 1, 0},
-    {0.734375, 1, 0},
-    {0.710938, 1, 0},
-    {0.6875, 1, 0},
-    {0.664062, 1, 0},
-    {0.640625, 1, 0},
-    {0.617188, 1, 0},
-    {0.59375, 1, 0},
-    {0.570312, 1, 0},
-    {0.546875, 1, 0},
-    {0.523438, 1, 0},
-    {0.5, 1, 0},
-    {0.476562, 1, 0},
-    {0.453125, 1, 0},
-    {0.429687, 1, 0},
-    {0.40625, 1, 0},
-    {0.382812, 1, 0},
-    {0.359375, 1, 0},
-    {0.335938, 1, 0},
-    {0.3125, 1, 0},
-    {0.289062, 1, 0},
-    {0.265625, 1, 0},
-    {0.242188, 1, 0},
-    {0.21875, 1, 0},
-    {0.195312, 1, 0},
-    {0.171875, 1, 0},
-    {0.148438, 1, 0},
-    {0.125, 1, 0},
-    {0.101562, 1, 0},
-    {0.078125, 1, 0},
-    {0.0546875, 1, 0},
-    {0.03125, 1, 0},
-    {0.03125, 1, 0},
-    {0.0208333, 1, 0.0208333},
-    {0.0104167, 1, 0.0416667},
-    {0, 1, 0.0625},
-    {0, 1, 0.0625},
-    {0, 1, 0.0859375},
-    {0, 1, 0.109375},
-    {0, 1, 0.132812},
-    {0, 1, 0.15625},
-    {0, 1, 0.179688},
-    {0, 1, 0.203125},
-    {0, 1, 0.226563},
-    {0, 1, 0.25},
-    {0, 1, 0.273438},
-    {0, 1, 0.296875},
-    {0, 1, 0.320312},
-    {0, 1, 0.34375},
-    {0, 1, 0.367188},
-    {0, 1, 0.390625},
-    {0, 1, 0.414062},
-    {0, 1, 0.4375},
-    {0, 1, 0.460938},
-    {0, 1, 0.484375},
-    {0, 1, 0.507812},
-    {0, 1, 0.53125},
-    {0, 1, 0.554688},
-    {0, 1, 0.578125},
-    {0, 1, 0.601563},
-    {0, 1, 0.625},
-    {0, 1, 0.648438},
-    {0, 1, 0.671875},
-    {0, 1, 0.695312},
-    {0, 1, 0.71875},
-    {0, 1, 0.742188},
-    {0, 1, 0.765625},
-    {0, 1, 0.789062},
-    {0, 1, 0.8125},
-    {0, 1, 0.835938},
-    {0, 1, 0.859375},
-    {0, 1, 0.882812},
-    {0, 1, 0.90625},
-    {0, 1, 0.929688},
-    {0, 1, 0.953125},
-    {0, 1, 0.976563},
-    {0, 1, 1},
-    {0, 1, 1},
-    {0, 0.975962, 1},
-    {0, 0.951923, 1},
-    {0, 0.927885, 1},
-    {0, 0.903846, 1},
-    {0, 0.879808, 1},
-    {0, 0.855769, 1},
-    {0, 0.831731, 1},
-    {0, 0.807692, 1},
-    {0, 0.783654, 1},
-    {0, 0.759615, 1},
-    {0, 0.735577, 1},
-    {0, 0.711538, 1},
-    {0, 0.6875, 1},
-    {0, 0.663462, 1},
-    {0, 0.639423, 1},
-    {0, 0.615385, 1},
-    {0, 0.591346, 1},
-    {0, 0.567308, 1},
-    {0, 0.543269, 1},
-    {0, 0.519231, 1},
-    {0, 0.495192, 1},
-    {0, 0.471154, 1},
-    {0, 0.447115, 1},
-    {0, 0.423077, 1},
-    {0, 0.399038, 1},
-    {0, 0.375, 1},
-    {0, 0.350962, 1},
-    {0, 0.326923, 1},
-    {0, 0.302885, 1},
-    {0, 0.278846, 1},
-    {0, 0.254808, 1},
-    {0, 0.230769, 1},
-    {0, 0.206731, 1},
-    {0, 0.182692, 1},
-    {0, 0.158654, 1},
-    {0, 0.134615, 1},
-    {0, 0.110577, 1},
-    {0, 0.0865385, 1},
-    {0, 0.0625, 1},
-    {0, 0.0625, 1},
-    {0.0104167, 0.0416667, 1},
-    {0.0208333, 0.0208333, 1},
-    {0.03125, 0, 1},
-    {0.03125, 0, 1},
-    {0.0546875, 0, 1},
-    {0.078125, 0, 1},
-    {0.101563, 0, 1},
-    {0.125, 0, 1},
-    {0.148438, 0, 1},
-    {0.171875, 0, 1},
-    {0.195313, 0, 1},
-    {0.21875, 0, 1},
-    {0.242188, 0, 1},
-    {0.265625, 0, 1},
-    {0.289062, 0, 1},
-    {0.3125, 0, 1},
-    {0.335938, 0, 1},
-    {0.359375, 0, 1},
-    {0.382812, 0, 1},
-    {0.40625, 0, 1},
-    {0.429688, 0, 1},
-    {0.453125, 0, 1},
-    {0.476563, 0, 1},
-    {0.5, 0, 1},
-    {0.523438, 0, 1},
-    {0.546875, 0, 1},
-    {0.570313, 0, 1},
-    {0.59375, 0, 1},
-    {0.617188, 0, 1},
-    {0.640625, 0, 1},
-    {0.664062, 0, 1},
-    {0.6875, 0, 1},
-    {0.710938, 0, 1},
-    {0.734375, 0, 1},
-    {0.757812, 0, 1},
-    {0.78125, 0, 1},
-    {0.804688, 0, 1},
-    {0.828125, 0, 1},
-    {0.851562, 0, 1},
-    {0.875, 0, 1},
-    {0.898438, 0, 1},
-    {0.921875, 0, 1},
-    {0.945313, 0, 1},
-    {0.96875, 0, 1},
-    {0.96875, 0, 1},
-    {0.979167, 0, 0.979167},
-    {0.989583, 0, 0.958333},
-    {1, 0, 0.9375},
-    {1, 0, 0.9375},
-    {1, 0, 0.914062},
-    {1, 0, 0.890625},
-    {1, 0, 0.867188},
-    {1, 0, 0.84375},
-    {1, 0, 0.820312},
-    {1, 0, 0.796875},
-    {1, 0, 0.773438},
-    {1, 0, 0.75},
-    {1, 0, 0.726562},
-    {1, 0, 0.703125},
-    {1, 0, 0.679688},
-    {1, 0, 0.65625},
-    {1, 0, 0.632812},
-    {1, 0, 0.609375},
-    {1, 0, 0.585938},
-    {1, 0, 0.5625},
-    {1, 0, 0.539062},
-    {1, 0, 0.515625},
-    {1, 0, 0.492188},
-    {1, 0, 0.46875},
-    {1, 0, 0.445313},
-    {1, 0, 0.421875},
-    {1, 0, 0.398438},
-    {1, 0, 0.375},
-    {1, 0, 0.351562},
-    {1, 0, 0.328125},
-    {1, 0, 0.304688},
-    {1, 0, 0.28125},
-    {1, 0, 0.257813},
-    {1, 0, 0.234375},
-    {1, 0, 0.210938},
-    {1, 0, 0.1875},
-    {1, 0, 0.164062},
-    {1, 0, 0.140625},
-    {1, 0, 0.117188},
-    {1, 0, 0.09375},
+constexpr ControlPoint nipy_spectral[] = {
+    {0.f, {0.f, 0.f, 0.f}},
+    {0.0431373f, {0.4667f, 0.f, 0.5333f}},
+    {0.0470588f, {0.4667f, 0.f, 0.5333f}},
+    {0.0941176f, {0.5333f, 0.f, 0.6f}},
+    {0.0980392f, {0.5333f, 0.f, 0.6f}},
+    {0.145098f, {0.f, 0.f, 0.6667f}},
+    {0.14902f, {0.f, 0.f, 0.6667f}},
+    {0.196078f, {0.f, 0.f, 0.8667f}},
+    {0.2f, {0.f, 0.f, 0.8667f}},
+    {0.247059f, {0.f, 0.4667f, 0.8667f}},
+    {0.25098f, {0.f, 0.4667f, 0.8667f}},
+    {0.294118f, {0.f, 0.6f, 0.8667f}},
+    {0.298039f, {0.f, 0.6f, 0.8667f}},
+    {0.345098f, {0.f, 0.6667f, 0.6667f}},
+    {0.34902f, {0.f, 0.6667f, 0.6667f}},
+    {0.396078f, {0.f, 0.6667f, 0.5333f}},
+    {0.4f, {0.f, 0.6667f, 0.5333f}},
+    {0.447059f, {0.f, 0.6f, 0.f}},
+    {0.45098f, {0.f, 0.6f, 0.f}},
+    {0.498039f, {0.f, 0.7333f, 0.f}},
+    {0.501961f, {0.f, 0.7333f, 0.f}},
+    {0.545098f, {0.f, 0.8667f, 0.f}},
+    {0.54902f, {0.f, 0.8667f, 0.f}},
+    {0.596078f, {0.f, 1.f, 0.f}},
+    {0.6f, {0.f, 1.f, 0.f}},
+    {0.647059f, {0.7333f, 1.f, 0.f}},
+    {0.65098f, {0.7333f, 1.f, 0.f}},
+    {0.698039f, {0.9333f, 0.9333f, 0.f}},
+    {0.701961f, {0.9333f, 0.9333f, 0.f}},
+    {0.74902f, {1.f, 0.8f, 0.f}},
+    {0.752941f, {1.f, 0.8f, 0.f}},
+    {0.796078f, {1.f, 0.6f, 0.f}},
+    {0.8f, {1.f, 0.6f, 0.f}},
+    {0.847059f, {1.f, 0.f, 0.f}},
+    {0.85098f, {1.f, 0.f, 0.f}},
+    {0.898039f, {0.8667f, 0.f, 0.f}},
+    {0.901961f, {0.8667f, 0.f, 0.f}},
+    {0.94902f, {0.8f, 0.f, 0.f}},
+    {0.952941f, {0.8f, 0.f, 0.f}},
+    {1.f, {0.8f, 0.8f, 0.8f}},
 };
 
-constexpr colormap_t nipy_spectral = {
-    {0, 0, 0},
-    {0.0424273, 0, 0.0484818},
-    {0.0848545, 0, 0.0969636},
-    {0.127282, 0, 0.145445},
-    {0.169709, 0, 0.193927},
-    {0.212136, 0, 0.242409},
-    {0.254564, 0, 0.290891},
-    {0.296991, 0, 0.339373},
-    {0.339418, 0, 0.387855},
-    {0.381845, 0, 0.436336},
-    {0.424273, 0, 0.484818},
-    {0.4667, 0, 0.5333},
-    {0.4667, 0, 0.5333},
-    {0.47225, 0, 0.538858},
-    {0.4778, 0, 0.544417},
-    {0.48335, 0, 0.549975},
-    {0.4889, 0, 0.555533},
-    {0.49445, 0, 0.561092},
-    {0.5, 0, 0.56665},
-    {0.50555, 0, 0.572208},
-    {0.5111, 0, 0.577767},
-    {0.51665, 0, 0.583325},
-    {0.5222, 0, 0.588883},
-    {0.52775, 0, 0.594442},
-    {0.5333, 0, 0.6},
-    {0.5333, 0, 0.6},
-    {0.488858, 0, 0.605558},
-    {0.444417, 0, 0.611117},
-    {0.399975, 0, 0.616675},
-    {0.355533, 0, 0.622233},
-    {0.311092, 0, 0.627792},
-    {0.26665, 0, 0.63335},
-    {0.222208, 0, 0.638908},
-    {0.177767, 0, 0.644467},
-    {0.133325, 0, 0.650025},
-    {0.0888833, 0, 0.655583},
-    {0.0444417, 0, 0.661142},
-    {0, 0, 0.6667},
-    {0, 0, 0.6667},
-    {0, 0, 0.683367},
-    {0, 0, 0.700033},
-    {0, 0, 0.7167},
-    {0, 0, 0.733367},
-    {0, 0, 0.750033},
-    {0, 0, 0.7667},
-    {0, 0, 0.783367},
-    {0, 0, 0.800033},
-    {0, 0, 0.8167},
-    {0, 0, 0.833367},
-    {0, 0, 0.850033},
-    {0, 0, 0.8667},
-    {0, 0, 0.8667},
-    {0, 0.0388917, 0.8667},
-    {0, 0.0777833, 0.8667},
-    {0, 0.116675, 0.8667},
-    {0, 0.155567, 0.8667},
-    {0, 0.194458, 0.8667},
-    {0, 0.23335, 0.8667},
-    {0, 0.272242, 0.8667},
-    {0, 0.311133, 0.8667},
-    {0, 0.350025, 0.8667},
-    {0, 0.388917, 0.8667},
-    {0, 0.427808, 0.8667},
-    {0, 0.4667, 0.8667},
-    {0, 0.4667, 0.8667},
-    {0, 0.478818, 0.8667},
-    {0, 0.490936, 0.8667},
-    {0, 0.503055, 0.8667},
-    {0, 0.515173, 0.8667},
-    {0, 0.527291, 0.8667},
-    {0, 0.539409, 0.8667},
-    {0, 0.551527, 0.8667},
-    {0, 0.563645, 0.8667},
-    {0, 0.575764, 0.8667},
-    {0, 0.587882, 0.8667},
-    {0, 0.6, 0.8667},
-    {0, 0.6, 0.8667},
-    {0, 0.605558, 0.850033},
-    {0, 0.611117, 0.833367},
-    {0, 0.616675, 0.8167},
-    {0, 0.622233, 0.800033},
-    {0, 0.627792, 0.783367},
-    {0, 0.63335, 0.7667},
-    {0, 0.638908, 0.750033},
-    {0, 0.644467, 0.733367},
-    {0, 0.650025, 0.7167},
-    {0, 0.655583, 0.700033},
-    {0, 0.661142, 0.683367},
-    {0, 0.6667, 0.6667},
-    {0, 0.6667, 0.6667},
-    {0, 0.6667, 0.655583},
-    {0, 0.6667, 0.644467},
-    {0, 0.6667, 0.63335},
-    {0, 0.6667, 0.622233},
-    {0, 0.6667, 0.611117},
-    {0, 0.6667, 0.6},
-    {0, 0.6667, 0.588883},
-    {0, 0.6667, 0.577767},
-    {0, 0.6667, 0.56665},
-    {0, 0.6667, 0.555533},
-    {0, 0.6667, 0.544417},
-    {0, 0.6667, 0.5333},
-    {0, 0.6667, 0.5333},
-    {0, 0.661142, 0.488858},
-    {0, 0.655583, 0.444417},
-    {0, 0.650025, 0.399975},
-    {0, 0.644467, 0.355533},
-    {0, 0.638908, 0.311092},
-    {0, 0.63335, 0.26665},
-    {0, 0.627792, 0.222208},
-    {0, 0.622233, 0.177767},
-    {0, 0.616675, 0.133325},
-    {0, 0.611117, 0.0888833},
-    {0, 0.605558, 0.0444417},
-    {0, 0.6, 0},
-    {0, 0.6, 0},
-    {0, 0.611108, 0},
-    {0, 0.622217, 0},
-    {0, 0.633325, 0},
-    {0, 0.644433, 0},
-    {0, 0.655542, 0},
-    {0, 0.66665, 0},
-    {0, 0.677758, 0},
-    {0, 0.688867, 0},
-    {0, 0.699975, 0},
-    {0, 0.711083, 0},
-    {0, 0.722192, 0},
-    {0, 0.7333, 0},
-    {0, 0.7333, 0},
-    {0, 0.745427, 0},
-    {0, 0.757555, 0},
-    {0, 0.769682, 0},
-    {0, 0.781809, 0},
-    {0, 0.793936, 0},
-    {0, 0.806064, 0},
-    {0, 0.818191, 0},
-    {0, 0.830318, 0},
-    {0, 0.842445, 0},
-    {0, 0.854573, 0},
-    {0, 0.8667, 0},
-    {0, 0.8667, 0},
-    {0, 0.877808, 0},
-    {0, 0.888917, 0},
-    {0, 0.900025, 0},
-    {0, 0.911133, 0},
-    {0, 0.922242, 0},
-    {0, 0.93335, 0},
-    {0, 0.944458, 0},
-    {0, 0.955567, 0},
-    {0, 0.966675, 0},
-    {0, 0.977783, 0},
-    {0, 0.988892, 0},
-    {0, 1, 0},
-    {0, 1, 0},
-    {0.0611083, 1, 0},
-    {0.122217, 1, 0},
-    {0.183325, 1, 0},
-    {0.244433, 1, 0},
-    {0.305542, 1, 0},
-    {0.36665, 1, 0},
-    {0.427758, 1, 0},
-    {0.488867, 1, 0},
-    {0.549975, 1, 0},
-    {0.611083, 1, 0},
-    {0.672192, 1, 0},
-    {0.7333, 1, 0},
-    {0.7333, 1, 0},
-    {0.749967, 0.994442, 0},
-    {0.766633, 0.988883, 0},
-    {0.7833, 0.983325, 0},
-    {0.799967, 0.977767, 0},
-    {0.816633, 0.972208, 0},
-    {0.8333, 0.96665, 0},
-    {0.849967, 0.961092, 0},
-    {0.866633, 0.955533, 0},
-    {0.8833, 0.949975, 0},
-    {0.899967, 0.944417, 0},
-    {0.916633, 0.938858, 0},
-    {0.9333, 0.9333, 0},
-    {0.9333, 0.9333, 0},
-    {0.938858, 0.922192, 0},
-    {0.944417, 0.911083, 0},
-    {0.949975, 0.899975, 0},
-    {0.955533, 0.888867, 0},
-    {0.961092, 0.877758, 0},
-    {0.96665, 0.86665, 0},
-    {0.972208, 0.855542, 0},
-    {0.977767, 0.844433, 0},
-    {0.983325, 0.833325, 0},
-    {0.988883, 0.822217, 0},
-    {0.994442, 0.811108, 0},
-    {1, 0.8, 0},
-    {1, 0.8, 0},
-    {1, 0.781818, 0},
-    {1, 0.763636, 0},
-    {1, 0.745455, 0},
-    {1, 0.727273, 0},
-    {1, 0.709091, 0},
-    {1, 0.690909, 0},
-    {1, 0.672727, 0},
-    {1, 0.654545, 0},
-    {1, 0.636364, 0},
-    {1, 0.618182, 0},
-    {1, 0.6, 0},
-    {1, 0.6, 0},
-    {1, 0.55, 0},
-    {1, 0.5, 0},
-    {1, 0.45, 0},
-    {1, 0.4, 0},
-    {1, 0.35, 0},
-    {1, 0.3, 0},
-    {1, 0.25, 0},
-    {1, 0.2, 0},
-    {1, 0.15, 0},
-    {1, 0.1, 0},
-    {1, 0.05, 0},
-    {1, 0, 0},
-    {1, 0, 0},
-    {0.988892, 0, 0},
-    {0.977783, 0, 0},
-    {0.966675, 0, 0},
-    {0.955567, 0, 0},
-    {0.944458, 0, 0},
-    {0.93335, 0, 0},
-    {0.922242, 0, 0},
-    {0.911133, 0, 0},
-    {0.900025, 0, 0},
-    {0.888917, 0, 0},
-    {0.877808, 0, 0},
-    {0.8667, 0, 0},
-    {0.8667, 0, 0},
-    {0.861142, 0, 0},
-    {0.855583, 0, 0},
-    {0.850025, 0, 0},
-    {0.844467, 0, 0},
-    {0.838908, 0, 0},
-    {0.83335, 0, 0},
-    {0.827792, 0, 0},
-    {0.822233, 0, 0},
-    {0.816675, 0, 0},
-    {0.811117, 0, 0},
-    {0.805558, 0, 0},
-    {0.8, 0, 0},
-    {0.8, 0, 0},
-    {0.8, 0.0666667, 0.0666667},
-    {0.8, 0.133333, 0.133333},
-    {0.8, 0.2, 0.2},
-    {0.8, 0.266667, 0.266667},
-    {0.8, 0.333333, 0.333333},
-    {0.8, 0.4, 0.4},
-    {0.8, 0.466667, 0.466667},
-    {0.8, 0.533333, 0.533333},
-    {0.8, 0.6, 0.6},
-    {0.8, 0.666667, 0.666667},
-    {0.8, 0.733333, 0.733333},
-    {0.8, 0.8, 0.8},
+constexpr ControlPoint jet[] = {
+    {0.f, {0.f, 0.f, 0.5f}},
+    {0.105882f, {0.f, 0.f, 1.f}},
+    {0.12549f, {0.f, 0.f, 1.f}},
+    {0.341176f, {0.f, 0.873016f, 1.f}},
+    {0.34902f, {0.f, 0.904762f, 0.974359f}},
+    {0.372549f, {0.0769231f, 1.f, 0.897436f}},
+    {0.639216f, {0.948718f, 1.f, 0.025641f}},
+    {0.647059f, {0.974359f, 0.970588f, 0.f}},
+    {0.654902f, {1.f, 0.941176f, 0.f}},
+    {0.890196f, {1.f, 0.0588235f, 0.f}},
+    {0.905882f, {0.928571f, 0.f, 0.f}},
+    {1.f, {0.5f, 0.f, 0.f}},
 };
 
-constexpr colormap_t jet = {
-    {0, 0, 0.5},
-    {0, 0, 0.518519},
-    {0, 0, 0.537037},
-    {0, 0, 0.555556},
-    {0, 0, 0.574074},
-    {0, 0, 0.592593},
-    {0, 0, 0.611111},
-    {0, 0, 0.62963},
-    {0, 0, 0.648148},
-    {0, 0, 0.666667},
-    {0, 0, 0.685185},
-    {0, 0, 0.703704},
-    {0, 0, 0.722222},
-    {0, 0, 0.740741},
-    {0, 0, 0.759259},
-    {0, 0, 0.777778},
-    {0, 0, 0.796296},
-    {0, 0, 0.814815},
-    {0, 0, 0.833333},
-    {0, 0, 0.851852},
-    {0, 0, 0.87037},
-    {0, 0, 0.888889},
-    {0, 0, 0.907407},
-    {0, 0, 0.925926},
-    {0, 0, 0.944444},
-    {0, 0, 0.962963},
-    {0, 0, 0.981481},
-    {0, 0, 1},
-    {0, 0, 1},
-    {0, 0, 1},
-    {0, 0, 1},
-    {0, 0, 1},
-    {0, 0, 1},
-    {0, 0.015873, 1},
-    {0, 0.031746, 1},
-    {0, 0.047619, 1},
-    {0, 0.0634921, 1},
-    {0, 0.0793651, 1},
-    {0, 0.0952381, 1},
-    {0, 0.111111, 1},
-    {0, 0.126984, 1},
-    {0, 0.142857, 1},
-    {0, 0.15873, 1},
-    {0, 0.174603, 1},
-    {0, 0.190476, 1},
-    {0, 0.206349, 1},
-    {0, 0.222222, 1},
-    {0, 0.238095, 1},
-    {0, 0.253968, 1},
-    {0, 0.269841, 1},
-    {0, 0.285714, 1},
-    {0, 0.301587, 1},
-    {0, 0.31746, 1},
-    {0, 0.333333, 1},
-    {0, 0.349206, 1},
-    {0, 0.365079, 1},
-    {0, 0.380952, 1},
-    {0, 0.396825, 1},
-    {0, 0.412698, 1},
-    {0, 0.428571, 1},
-    {0, 0.444444, 1},
-    {0, 0.460317, 1},
-    {0, 0.47619, 1},
-    {0, 0.492063, 1},
-    {0, 0.507937, 1},
-    {0, 0.52381, 1},
-    {0, 0.539683, 1},
-    {0, 0.555556, 1},
-    {0, 0.571429, 1},
-    {0, 0.587302, 1},
-    {0, 0.603175, 1},
-    {0, 0.619048, 1},
-    {0, 0.634921, 1},
-    {0, 0.650794, 1},
-    {0, 0.666667, 1},
-    {0, 0.68254, 1},
-    {0, 0.698413, 1},
-    {0, 0.714286, 1},
-    {0, 0.730159, 1},
-    {0, 0.746032, 1},
-    {0, 0.761905, 1},
-    {0, 0.777778, 1},
-    {0, 0.793651, 1},
-    {0, 0.809524, 1},
-    {0, 0.825397, 1},
-    {0, 0.84127, 1},
-    {0, 0.857143, 1},
-    {0, 0.873016, 1},
-    {0, 0.888889, 0.987179},
-    {0, 0.904762, 0.974359},
-    {0.0128205, 0.920635, 0.961538},
-    {0.025641, 0.936508, 0.948718},
-    {0.0384615, 0.952381, 0.935897},
-    {0.0512821, 0.968254, 0.923077},
-    {0.0641026, 0.984127, 0.910256},
-    {0.0769231, 1, 0.897436},
-    {0.0897436, 1, 0.884615},
-    {0.102564, 1, 0.871795},
-    {0.115385, 1, 0.858974},
-    {0.128205, 1, 0.846154},
-    {0.141026, 1, 0.833333},
-    {0.153846, 1, 0.820513},
-    {0.166667, 1, 0.807692},
-    {0.179487, 1, 0.794872},
-    {0.192308, 1, 0.782051},
-    {0.205128, 1, 0.769231},
-    {0.217949, 1, 0.75641},
-    {0.230769, 1, 0.74359},
-    {0.24359, 1, 0.730769},
-    {0.25641, 1, 0.717949},
-    {0.269231, 1, 0.705128},
-    {0.282051, 1, 0.692308},
-    {0.294872, 1, 0.679487},
-    {0.307692, 1, 0.666667},
-    {0.320513, 1, 0.653846},
-    {0.333333, 1, 0.641026},
-    {0.346154, 1, 0.628205},
-    {0.358974, 1, 0.615385},
-    {0.371795, 1, 0.602564},
-    {0.384615, 1, 0.589744},
-    {0.397436, 1, 0.576923},
-    {0.410256, 1, 0.564103},
-    {0.423077, 1, 0.551282},
-    {0.435897, 1, 0.538462},
-    {0.448718, 1, 0.525641},
-    {0.461538, 1, 0.512821},
-    {0.474359, 1, 0.5},
-    {0.487179, 1, 0.487179},
-    {0.5, 1, 0.474359},
-    {0.512821, 1, 0.461538},
-    {0.525641, 1, 0.448718},
-    {0.538462, 1, 0.435897},
-    {0.551282, 1, 0.423077},
-    {0.564103, 1, 0.410256},
-    {0.576923, 1, 0.397436},
-    {0.589744, 1, 0.384615},
-    {0.602564, 1, 0.371795},
-    {0.615385, 1, 0.358974},
-    {0.628205, 1, 0.346154},
-    {0.641026, 1, 0.333333},
-    {0.653846, 1, 0.320513},
-    {0.666667, 1, 0.307692},
-    {0.679487, 1, 0.294872},
-    {0.692308, 1, 0.282051},
-    {0.705128, 1, 0.269231},
-    {0.717949, 1, 0.25641},
-    {0.730769, 1, 0.24359},
-    {0.74359, 1, 0.230769},
-    {0.75641, 1, 0.217949},
-    {0.769231, 1, 0.205128},
-    {0.782051, 1, 0.192308},
-    {0.794872, 1, 0.179487},
-    {0.807692, 1, 0.166667},
-    {0.820513, 1, 0.153846},
-    {0.833333, 1, 0.141026},
-    {0.846154, 1, 0.128205},
-    {0.858974, 1, 0.115385},
-    {0.871795, 1, 0.102564},
-    {0.884615, 1, 0.0897436},
-    {0.897436, 1, 0.0769231},
-    {0.910256, 1, 0.0641026},
-    {0.923077, 1, 0.0512821},
-    {0.935897, 1, 0.0384615},
-    {0.948718, 1, 0.025641},
-    {0.961538, 0.985294, 0.0128205},
-    {0.974359, 0.970588, 0},
-    {0.987179, 0.955882, 0},
-    {1, 0.941176, 0},
-    {1, 0.926471, 0},
-    {1, 0.911765, 0},
-    {1, 0.897059, 0},
-    {1, 0.882353, 0},
-    {1, 0.867647, 0},
-    {1, 0.852941, 0},
-    {1, 0.838235, 0},
-    {1, 0.823529, 0},
-    {1, 0.808824, 0},
-    {1, 0.794118, 0},
-    {1, 0.779412, 0},
-    {1, 0.764706, 0},
-    {1, 0.75, 0},
-    {1, 0.735294, 0},
-    {1, 0.720588, 0},
-    {1, 0.705882, 0},
-    {1, 0.691176, 0},
-    {1, 0.676471, 0},
-    {1, 0.661765, 0},
-    {1, 0.647059, 0},
-    {1, 0.632353, 0},
-    {1, 0.617647, 0},
-    {1, 0.602941, 0},
-    {1, 0.588235, 0},
-    {1, 0.573529, 0},
-    {1, 0.558824, 0},
-    {1, 0.544118, 0},
-    {1, 0.529412, 0},
-    {1, 0.514706, 0},
-    {1, 0.5, 0},
-    {1, 0.485294, 0},
-    {1, 0.470588, 0},
-    {1, 0.455882, 0},
-    {1, 0.441176, 0},
-    {1, 0.426471, 0},
-    {1, 0.411765, 0},
-    {1, 0.397059, 0},
-    {1, 0.382353, 0},
-    {1, 0.367647, 0},
-    {1, 0.352941, 0},
-    {1, 0.338235, 0},
-    {1, 0.323529, 0},
-    {1, 0.308824, 0},
-    {1, 0.294118, 0},
-    {1, 0.279412, 0},
-    {1, 0.264706, 0},
-    {1, 0.25, 0},
-    {1, 0.235294, 0},
-    {1, 0.220588, 0},
-    {1, 0.205882, 0},
-    {1, 0.191176, 0},
-    {1, 0.176471, 0},
-    {1, 0.161765, 0},
-    {1, 0.147059, 0},
-    {1, 0.132353, 0},
-    {1, 0.117647, 0},
-    {1, 0.102941, 0},
-    {1, 0.0882353, 0},
-    {1, 0.0735294, 0},
-    {1, 0.0588235, 0},
-    {0.982143, 0.0441176, 0},
-    {0.964286, 0.0294118, 0},
-    {0.946429, 0.0147059, 0},
-    {0.928571, 0, 0},
-    {0.910714, 0, 0},
-    {0.892857, 0, 0},
-    {0.875, 0, 0},
-    {0.857143, 0, 0},
-    {0.839286, 0, 0},
-    {0.821429, 0, 0},
-    {0.803571, 0, 0},
-    {0.785714, 0, 0},
-    {0.767857, 0, 0},
-    {0.75, 0, 0},
-    {0.732143, 0, 0},
-    {0.714286, 0, 0},
-    {0.696429, 0, 0},
-    {0.678571, 0, 0},
-    {0.660714, 0, 0},
-    {0.642857, 0, 0},
-    {0.625, 0, 0},
-    {0.607143, 0, 0},
-    {0.589286, 0, 0},
-    {0.571429, 0, 0},
-    {0.553571, 0, 0},
-    {0.535714, 0, 0},
-    {0.517857, 0, 0},
-    {0.5, 0, 0},
+constexpr ControlPoint terrain[] = {
+    {0.f, {0.2f, 0.2f, 0.6f}},
+    {0.145098f, {0.f, 0.6f, 1.f}},
+    {0.14902f, {0.f, 0.6f, 1.f}},
+    {0.247059f, {0.f, 0.8f, 0.4f}},
+    {0.25098f, {0.f, 0.8f, 0.4f}},
+    {0.498039f, {1.f, 1.f, 0.6f}},
+    {0.501961f, {1.f, 1.f, 0.6f}},
+    {0.74902f, {0.5f, 0.36f, 0.33f}},
+    {0.752941f, {0.5f, 0.36f, 0.33f}},
+    {1.f, {1.f, 1.f, 1.f}},
 };
 
-constexpr colormap_t terrain = {
-    {0.2, 0.2, 0.6},
-    {0.194595, 0.210811, 0.610811},
-    {0.189189, 0.221622, 0.621622},
-    {0.183784, 0.232432, 0.632432},
-    {0.178378, 0.243243, 0.643243},
-    {0.172973, 0.254054, 0.654054},
-    {0.167568, 0.264865, 0.664865},
-    {0.162162, 0.275676, 0.675676},
-    {0.156757, 0.286486, 0.686486},
-    {0.151351, 0.297297, 0.697297},
-    {0.145946, 0.308108, 0.708108},
-    {0.140541, 0.318919, 0.718919},
-    {0.135135, 0.32973, 0.72973},
-    {0.12973, 0.340541, 0.740541},
-    {0.124324, 0.351351, 0.751351},
-    {0.118919, 0.362162, 0.762162},
-    {0.113514, 0.372973, 0.772973},
-    {0.108108, 0.383784, 0.783784},
-    {0.102703, 0.394595, 0.794595},
-    {0.0972973, 0.405405, 0.805405},
-    {0.0918919, 0.416216, 0.816216},
-    {0.0864865, 0.427027, 0.827027},
-    {0.0810811, 0.437838, 0.837838},
-    {0.0756757, 0.448649, 0.848649},
-    {0.0702703, 0.459459, 0.859459},
-    {0.0648649, 0.47027, 0.87027},
-    {0.0594595, 0.481081, 0.881081},
-    {0.0540541, 0.491892, 0.891892},
-    {0.0486486, 0.502703, 0.902703},
-    {0.0432432, 0.513514, 0.913514},
-    {0.0378378, 0.524324, 0.924324},
-    {0.0324324, 0.535135, 0.935135},
-    {0.027027, 0.545946, 0.945946},
-    {0.0216216, 0.556757, 0.956757},
-    {0.0162162, 0.567568, 0.967568},
-    {0.0108108, 0.578378, 0.978378},
-    {0.00540541, 0.589189, 0.989189},
-    {0, 0.6, 1},
-    {0, 0.6, 1},
-    {0, 0.608, 0.976},
-    {0, 0.616, 0.952},
-    {0, 0.624, 0.928},
-    {0, 0.632, 0.904},
-    {0, 0.64, 0.88},
-    {0, 0.648, 0.856},
-    {0, 0.656, 0.832},
-    {0, 0.664, 0.808},
-    {0, 0.672, 0.784},
-    {0, 0.68, 0.76},
-    {0, 0.688, 0.736},
-    {0, 0.696, 0.712},
-    {0, 0.704, 0.688},
-    {0, 0.712, 0.664},
-    {0, 0.72, 0.64},
-    {0, 0.728, 0.616},
-    {0, 0.736, 0.592},
-    {0, 0.744, 0.568},
-    {0, 0.752, 0.544},
-    {0, 0.76, 0.52},
-    {0, 0.768, 0.496},
-    {0, 0.776, 0.472},
-    {0, 0.784, 0.448},
-    {0, 0.792, 0.424},
-    {0, 0.8, 0.4},
-    {0, 0.8, 0.4},
-    {0.015873, 0.803175, 0.403175},
-    {0.031746, 0.806349, 0.406349},
-    {0.047619, 0.809524, 0.409524},
-    {0.0634921, 0.812698, 0.412698},
-    {0.0793651, 0.815873, 0.415873},
-    {0.0952381, 0.819048, 0.419048},
-    {0.111111, 0.822222, 0.422222},
-    {0.126984, 0.825397, 0.425397},
-    {0.142857, 0.828571, 0.428571},
-    {0.15873, 0.831746, 0.431746},
-    {0.174603, 0.834921, 0.434921},
-    {0.190476, 0.838095, 0.438095},
-    {0.206349, 0.84127, 0.44127},
-    {0.222222, 0.844444, 0.444444},
-    {0.238095, 0.847619, 0.447619},
-    {0.253968, 0.850794, 0.450794},
-    {0.269841, 0.853968, 0.453968},
-    {0.285714, 0.857143, 0.457143},
-    {0.301587, 0.860317, 0.460317},
-    {0.31746, 0.863492, 0.463492},
-    {0.333333, 0.866667, 0.466667},
-    {0.349206, 0.869841, 0.469841},
-    {0.365079, 0.873016, 0.473016},
-    {0.380952, 0.87619, 0.47619},
-    {0.396825, 0.879365, 0.479365},
-    {0.412698, 0.88254, 0.48254},
-    {0.428571, 0.885714, 0.485714},
-    {0.444444, 0.888889, 0.488889},
-    {0.460317, 0.892063, 0.492063},
-    {0.47619, 0.895238, 0.495238},
-    {0.492063, 0.898413, 0.498413},
-    {0.507937, 0.901587, 0.501587},
-    {0.52381, 0.904762, 0.504762},
-    {0.539683, 0.907937, 0.507937},
-    {0.555556, 0.911111, 0.511111},
-    {0.571429, 0.914286, 0.514286},
-    {0.587302, 0.91746, 0.51746},
-    {0.603175, 0.920635, 0.520635},
-    {0.619048, 0.92381, 0.52381},
-    {0.634921, 0.926984, 0.526984},
-    {0.650794, 0.930159, 0.530159},
-    {0.666667, 0.933333, 0.533333},
-    {0.68254, 0.936508, 0.536508},
-    {0.698413, 0.939683, 0.539683},
-    {0.714286, 0.942857, 0.542857},
-    {0.730159, 0.946032, 0.546032},
-    {0.746032, 0.949206, 0.549206},
-    {0.761905, 0.952381, 0.552381},
-    {0.777778, 0.955556, 0.555556},
-    {0.793651, 0.95873, 0.55873},
-    {0.809524, 0.961905, 0.561905},
-    {0.825397, 0.965079, 0.565079},
-    {0.84127, 0.968254, 0.568254},
-    {0.857143, 0.971429, 0.571429},
-    {0.873016, 0.974603, 0.574603},
-    {0.888889, 0.977778, 0.577778},
-    {0.904762, 0.980952, 0.580952},
-    {0.920635, 0.984127, 0.584127},
-    {0.936508, 0.987302, 0.587302},
-    {0.952381, 0.990476, 0.590476},
-    {0.968254, 0.993651, 0.593651},
-    {0.984127, 0.996825, 0.596825},
-    {1, 1, 0.6},
-    {1, 1, 0.6},
-    {0.992063, 0.989841, 0.595714},
-    {0.984127, 0.979683, 0.591429},
-    {0.97619, 0.969524, 0.587143},
-    {0.968254, 0.959365, 0.582857},
-    {0.960317, 0.949206, 0.578571},
-    {0.952381, 0.939048, 0.574286},
-    {0.944444, 0.928889, 0.57},
-    {0.936508, 0.91873, 0.565714},
-    {0.928571, 0.908571, 0.561429},
-    {0.920635, 0.898413, 0.557143},
-    {0.912698, 0.888254, 0.552857},
-    {0.904762, 0.878095, 0.548571},
-    {0.896825, 0.867937, 0.544286},
-    {0.888889, 0.857778, 0.54},
-    {0.880952, 0.847619, 0.535714},
-    {0.873016, 0.83746, 0.531429},
-    {0.865079, 0.827302, 0.527143},
-    {0.857143, 0.817143, 0.522857},
-    {0.849206, 0.806984, 0.518571},
-    {0.84127, 0.796825, 0.514286},
-    {0.833333, 0.786667, 0.51},
-    {0.825397, 0.776508, 0.505714},
-    {0.81746, 0.766349, 0.501429},
-    {0.809524, 0.75619, 0.497143},
-    {0.801587, 0.746032, 0.492857},
-    {0.793651, 0.735873, 0.488571},
-    {0.785714, 0.725714, 0.484286},
-    {0.777778, 0.715556, 0.48},
-    {0.769841, 0.705397, 0.475714},
-    {0.761905, 0.695238, 0.471429},
-    {0.753968, 0.685079, 0.467143},
-    {0.746032, 0.674921, 0.462857},
-    {0.738095, 0.664762, 0.458571},
-    {0.730159, 0.654603, 0.454286},
-    {0.722222, 0.644444, 0.45},
-    {0.714286, 0.634286, 0.445714},
-    {0.706349, 0.624127, 0.441429},
-    {0.698413, 0.613968, 0.437143},
-    {0.690476, 0.60381, 0.432857},
-    {0.68254, 0.593651, 0.428571},
-    {0.674603, 0.583492, 0.424286},
-    {0.666667, 0.573333, 0.42},
-    {0.65873, 0.563175, 0.415714},
-    {0.650794, 0.553016, 0.411429},
-    {0.642857, 0.542857, 0.407143},
-    {0.634921, 0.532698, 0.402857},
-    {0.626984, 0.52254, 0.398571},
-    {0.619048, 0.512381, 0.394286},
-    {0.611111, 0.502222, 0.39},
-    {0.603175, 0.492063, 0.385714},
-    {0.595238, 0.481905, 0.381429},
-    {0.587302, 0.471746, 0.377143},
-    {0.579365, 0.461587, 0.372857},
-    {0.571429, 0.451429, 0.368571},
-    {0.563492, 0.44127, 0.364286},
-    {0.555556, 0.431111, 0.36},
-    {0.547619, 0.420952, 0.355714},
-    {0.539683, 0.410794, 0.351429},
-    {0.531746, 0.400635, 0.347143},
-    {0.52381, 0.390476, 0.342857},
-    {0.515873, 0.380317, 0.338571},
-    {0.507937, 0.370159, 0.334286},
-    {0.5, 0.36, 0.33},
-    {0.5, 0.36, 0.33},
-    {0.507937, 0.370159, 0.340635},
-    {0.515873, 0.380317, 0.35127},
-    {0.52381, 0.390476, 0.361905},
-    {0.531746, 0.400635, 0.37254},
-    {0.539683, 0.410794, 0.383175},
-    {0.547619, 0.420952, 0.39381},
-    {0.555556, 0.431111, 0.404444},
-    {0.563492, 0.44127, 0.415079},
-    {0.571429, 0.451429, 0.425714},
-    {0.579365, 0.461587, 0.436349},
-    {0.587302, 0.471746, 0.446984},
-    {0.595238, 0.481905, 0.457619},
-    {0.603175, 0.492063, 0.468254},
-    {0.611111, 0.502222, 0.478889},
-    {0.619048, 0.512381, 0.489524},
-    {0.626984, 0.52254, 0.500159},
-    {0.634921, 0.532698, 0.510794},
-    {0.642857, 0.542857, 0.521429},
-    {0.650794, 0.553016, 0.532063},
-    {0.65873, 0.563175, 0.542698},
-    {0.666667, 0.573333, 0.553333},
-    {0.674603, 0.583492, 0.563968},
-    {0.68254, 0.593651, 0.574603},
-    {0.690476, 0.60381, 0.585238},
-    {0.698413, 0.613968, 0.595873},
-    {0.706349, 0.624127, 0.606508},
-    {0.714286, 0.634286, 0.617143},
-    {0.722222, 0.644444, 0.627778},
-    {0.730159, 0.654603, 0.638413},
-    {0.738095, 0.664762, 0.649048},
-    {0.746032, 0.674921, 0.659683},
-    {0.753968, 0.685079, 0.670317},
-    {0.761905, 0.695238, 0.680952},
-    {0.769841, 0.705397, 0.691587},
-    {0.777778, 0.715556, 0.702222},
-    {0.785714, 0.725714, 0.712857},
-    {0.793651, 0.735873, 0.723492},
-    {0.801587, 0.746032, 0.734127},
-    {0.809524, 0.75619, 0.744762},
-    {0.81746, 0.766349, 0.755397},
-    {0.825397, 0.776508, 0.766032},
-    {0.833333, 0.786667, 0.776667},
-    {0.84127, 0.796825, 0.787302},
-    {0.849206, 0.806984, 0.797937},
-    {0.857143, 0.817143, 0.808571},
-    {0.865079, 0.827302, 0.819206},
-    {0.873016, 0.83746, 0.829841},
-    {0.880952, 0.847619, 0.840476},
-    {0.888889, 0.857778, 0.851111},
-    {0.896825, 0.867937, 0.861746},
-    {0.904762, 0.878095, 0.872381},
-    {0.912698, 0.888254, 0.883016},
-    {0.920635, 0.898413, 0.893651},
-    {0.928571, 0.908571, 0.904286},
-    {0.936508, 0.91873, 0.914921},
-    {0.944444, 0.928889, 0.925556},
-    {0.952381, 0.939048, 0.93619},
-    {0.960317, 0.949206, 0.946825},
-    {0.968254, 0.959365, 0.95746},
-    {0.97619, 0.969524, 0.968095},
-    {0.984127, 0.979683, 0.97873},
-    {0.992063, 0.989841, 0.989365},
-    {1, 1, 1},
+constexpr ControlPoint seismic[] = {
+    {0.f, {0.f, 0.f, 0.3f}},
+    {0.247059f, {0.f, 0.f, 0.991765f}},
+    {0.25098f, {0.00392157f, 0.00392157f, 1.f}},
+    {0.498039f, {0.992157f, 0.992157f, 1.f}},
+    {0.501961f, {1.f, 0.992157f, 0.992157f}},
+    {0.74902f, {1.f, 0.00392157f, 0.00392157f}},
+    {0.752941f, {0.994118f, 0.f, 0.f}},
+    {1.f, {0.5f, 0.f, 0.f}},
 };
 
-constexpr colormap_t seismic = {
-    {0, 0, 0.3},
-    {0, 0, 0.31098},
-    {0, 0, 0.321961},
-    {0, 0, 0.332941},
-    {0, 0, 0.343922},
-    {0, 0, 0.354902},
-    {0, 0, 0.365882},
-    {0, 0, 0.376863},
-    {0, 0, 0.387843},
-    {0, 0, 0.398824},
-    {0, 0, 0.409804},
-    {0, 0, 0.420784},
-    {0, 0, 0.431765},
-    {0, 0, 0.442745},
-    {0, 0, 0.453725},
-    {0, 0, 0.464706},
-    {0, 0, 0.475686},
-    {0, 0, 0.486667},
-    {0, 0, 0.497647},
-    {0, 0, 0.508627},
-    {0, 0, 0.519608},
-    {0, 0, 0.530588},
-    {0, 0, 0.541569},
-    {0, 0, 0.552549},
-    {0, 0, 0.563529},
-    {0, 0, 0.57451},
-    {0, 0, 0.58549},
-    {0, 0, 0.596471},
-    {0, 0, 0.607451},
-    {0, 0, 0.618431},
-    {0, 0, 0.629412},
-    {0, 0, 0.640392},
-    {0, 0, 0.651373},
-    {0, 0, 0.662353},
-    {0, 0, 0.673333},
-    {0, 0, 0.684314},
-    {0, 0, 0.695294},
-    {0, 0, 0.706275},
-    {0, 0, 0.717255},
-    {0, 0, 0.728235},
-    {0, 0, 0.739216},
-    {0, 0, 0.750196},
-    {0, 0, 0.761176},
-    {0, 0, 0.772157},
-    {0, 0, 0.783137},
-    {0, 0, 0.794118},
-    {0, 0, 0.805098},
-    {0, 0, 0.816078},
-    {0, 0, 0.827059},
-    {0, 0, 0.838039},
-    {0, 0, 0.84902},
-    {0, 0, 0.86},
-    {0, 0, 0.87098},
-    {0, 0, 0.881961},
-    {0, 0, 0.892941},
-    {0, 0, 0.903922},
-    {0, 0, 0.914902},
-    {0, 0, 0.925882},
-    {0, 0, 0.936863},
-    {0, 0, 0.947843},
-    {0, 0, 0.958824},
-    {0, 0, 0.969804},
-    {0, 0, 0.980784},
-    {0, 0, 0.991765},
-    {0.00392157, 0.00392157, 1},
-    {0.0196078, 0.0196078, 1},
-    {0.0352941, 0.0352941, 1},
-    {0.0509804, 0.0509804, 1},
-    {0.0666667, 0.0666667, 1},
-    {0.0823529, 0.0823529, 1},
-    {0.0980392, 0.0980392, 1},
-    {0.113725, 0.113725, 1},
-    {0.129412, 0.129412, 1},
-    {0.145098, 0.145098, 1},
-    {0.160784, 0.160784, 1},
-    {0.176471, 0.176471, 1},
-    {0.192157, 0.192157, 1},
-    {0.207843, 0.207843, 1},
-    {0.223529, 0.223529, 1},
-    {0.239216, 0.239216, 1},
-    {0.254902, 0.254902, 1},
-    {0.270588, 0.270588, 1},
-    {0.286275, 0.286275, 1},
-    {0.301961, 0.301961, 1},
-    {0.317647, 0.317647, 1},
-    {0.333333, 0.333333, 1},
-    {0.34902, 0.34902, 1},
-    {0.364706, 0.364706, 1},
-    {0.380392, 0.380392, 1},
-    {0.396078, 0.396078, 1},
-    {0.411765, 0.411765, 1},
-    {0.427451, 0.427451, 1},
-    {0.443137, 0.443137, 1},
-    {0.458824, 0.458824, 1},
-    {0.47451, 0.47451, 1},
-    {0.490196, 0.490196, 1},
-    {0.505882, 0.505882, 1},
-    {0.521569, 0.521569, 1},
-    {0.537255, 0.537255, 1},
-    {0.552941, 0.552941, 1},
-    {0.568627, 0.568627, 1},
-    {0.584314, 0.584314, 1},
-    {0.6, 0.6, 1},
-    {0.615686, 0.615686, 1},
-    {0.631373, 0.631373, 1},
-    {0.647059, 0.647059, 1},
-    {0.662745, 0.662745, 1},
-    {0.678431, 0.678431, 1},
-    {0.694118, 0.694118, 1},
-    {0.709804, 0.709804, 1},
-    {0.72549, 0.72549, 1},
-    {0.741176, 0.741176, 1},
-    {0.756863, 0.756863, 1},
-    {0.772549, 0.772549, 1},
-    {0.788235, 0.788235, 1},
-    {0.803922, 0.803922, 1},
-    {0.819608, 0.819608, 1},
-    {0.835294, 0.835294, 1},
-    {0.85098, 0.85098, 1},
-    {0.866667, 0.866667, 1},
-    {0.882353, 0.882353, 1},
-    {0.898039, 0.898039, 1},
-    {0.913725, 0.913725, 1},
-    {0.929412, 0.929412, 1},
-    {0.945098, 0.945098, 1},
-    {0.960784, 0.960784, 1},
-    {0.976471, 0.976471, 1},
-    {0.992157, 0.992157, 1},
-    {1, 0.992157, 0.992157},
-    {1, 0.976471, 0.976471},
-    {1, 0.960784, 0.960784},
-    {1, 0.945098, 0.945098},
-    {1, 0.929412, 0.929412},
-    {1, 0.913725, 0.913725},
-    {1, 0.898039, 0.898039},
-    {1, 0.882353, 0.882353},
-    {1, 0.866667, 0.866667},
-    {1, 0.85098, 0.85098},
-    {1, 0.835294, 0.835294},
-    {1, 0.819608, 0.819608},
-    {1, 0.803922, 0.803922},
-    {1, 0.788235, 0.788235},
-    {1, 0.772549, 0.772549},
-    {1, 0.756863, 0.756863},
-    {1, 0.741176, 0.741176},
-    {1, 0.72549, 0.72549},
-    {1, 0.709804, 0.709804},
-    {1, 0.694118, 0.694118},
-    {1, 0.678431, 0.678431},
-    {1, 0.662745, 0.662745},
-    {1, 0.647059, 0.647059},
-    {1, 0.631373, 0.631373},
-    {1, 0.615686, 0.615686},
-    {1, 0.6, 0.6},
-    {1, 0.584314, 0.584314},
-    {1, 0.568627, 0.568627},
-    {1, 0.552941, 0.552941},
-    {1, 0.537255, 0.537255},
-    {1, 0.521569, 0.521569},
-    {1, 0.505882, 0.505882},
-    {1, 0.490196, 0.490196},
-    {1, 0.47451, 0.47451},
-    {1, 0.458824, 0.458824},
-    {1, 0.443137, 0.443137},
-    {1, 0.427451, 0.427451},
-    {1, 0.411765, 0.411765},
-    {1, 0.396078, 0.396078},
-    {1, 0.380392, 0.380392},
-    {1, 0.364706, 0.364706},
-    {1, 0.34902, 0.34902},
-    {1, 0.333333, 0.333333},
-    {1, 0.317647, 0.317647},
-    {1, 0.301961, 0.301961},
-    {1, 0.286275, 0.286275},
-    {1, 0.270588, 0.270588},
-    {1, 0.254902, 0.254902},
-    {1, 0.239216, 0.239216},
-    {1, 0.223529, 0.223529},
-    {1, 0.207843, 0.207843},
-    {1, 0.192157, 0.192157},
-    {1, 0.176471, 0.176471},
-    {1, 0.160784, 0.160784},
-    {1, 0.145098, 0.145098},
-    {1, 0.129412, 0.129412},
-    {1, 0.113725, 0.113725},
-    {1, 0.0980392, 0.0980392},
-    {1, 0.0823529, 0.0823529},
-    {1, 0.0666667, 0.0666667},
-    {1, 0.0509804, 0.0509804},
-    {1, 0.0352941, 0.0352941},
-    {1, 0.0196078, 0.0196078},
-    {1, 0.00392157, 0.00392157},
-    {0.994118, 0, 0},
-    {0.986275, 0, 0},
-    {0.978431, 0, 0},
-    {0.970588, 0, 0},
-    {0.962745, 0, 0},
-    {0.954902, 0, 0},
-    {0.947059, 0, 0},
-    {0.939216, 0, 0},
-    {0.931373, 0, 0},
-    {0.923529, 0, 0},
-    {0.915686, 0, 0},
-    {0.907843, 0, 0},
-    {0.9, 0, 0},
-    {0.892157, 0, 0},
-    {0.884314, 0, 0},
-    {0.876471, 0, 0},
-    {0.868627, 0, 0},
-    {0.860784, 0, 0},
-    {0.852941, 0, 0},
-    {0.845098, 0, 0},
-    {0.837255, 0, 0},
-    {0.829412, 0, 0},
-    {0.821569, 0, 0},
-    {0.813725, 0, 0},
-    {0.805882, 0, 0},
-    {0.798039, 0, 0},
-    {0.790196, 0, 0},
-    {0.782353, 0, 0},
-    {0.77451, 0, 0},
-    {0.766667, 0, 0},
-    {0.758824, 0, 0},
-    {0.75098, 0, 0},
-    {0.743137, 0, 0},
-    {0.735294, 0, 0},
-    {0.727451, 0, 0},
-    {0.719608, 0, 0},
-    {0.711765, 0, 0},
-    {0.703922, 0, 0},
-    {0.696078, 0, 0},
-    {0.688235, 0, 0},
-    {0.680392, 0, 0},
-    {0.672549, 0, 0},
-    {0.664706, 0, 0},
-    {0.656863, 0, 0},
-    {0.64902, 0, 0},
-    {0.641176, 0, 0},
-    {0.633333, 0, 0},
-    {0.62549, 0, 0},
-    {0.617647, 0, 0},
-    {0.609804, 0, 0},
-    {0.601961, 0, 0},
-    {0.594118, 0, 0},
-    {0.586275, 0, 0},
-    {0.578431, 0, 0},
-    {0.570588, 0, 0},
-    {0.562745, 0, 0},
-    {0.554902, 0, 0},
-    {0.547059, 0, 0},
-    {0.539216, 0, 0},
-    {0.531373, 0, 0},
-    {0.523529, 0, 0},
-    {0.515686, 0, 0},
-    {0.507843, 0, 0},
-    {0.5, 0, 0},
+constexpr ControlPoint afmhot[] = {
+    {0.f, {0.f, 0.f, 0.f}},
+    {0.247059f, {0.494118f, 0.f, 0.f}},
+    {0.25098f, {0.501961f, 0.00196078f, 0.f}},
+    {0.498039f, {0.996078f, 0.496078f, 0.f}},
+    {0.501961f, {1.f, 0.503922f, 0.00392157f}},
+    {0.74902f, {1.f, 0.998039f, 0.498039f}},
+    {0.756863f, {1.f, 1.f, 0.513725f}},
+    {1.f, {1.f, 1.f, 1.f}},
 };
 
-constexpr colormap_t afmhot = {
-    {0, 0, 0},
-    {0.00784314, 0, 0},
-    {0.0156863, 0, 0},
-    {0.0235294, 0, 0},
-    {0.0313725, 0, 0},
-    {0.0392157, 0, 0},
-    {0.0470588, 0, 0},
-    {0.054902, 0, 0},
-    {0.0627451, 0, 0},
-    {0.0705882, 0, 0},
-    {0.0784314, 0, 0},
-    {0.0862745, 0, 0},
-    {0.0941176, 0, 0},
-    {0.101961, 0, 0},
-    {0.109804, 0, 0},
-    {0.117647, 0, 0},
-    {0.12549, 0, 0},
-    {0.133333, 0, 0},
-    {0.141176, 0, 0},
-    {0.14902, 0, 0},
-    {0.156863, 0, 0},
-    {0.164706, 0, 0},
-    {0.172549, 0, 0},
-    {0.180392, 0, 0},
-    {0.188235, 0, 0},
-    {0.196078, 0, 0},
-    {0.203922, 0, 0},
-    {0.211765, 0, 0},
-    {0.219608, 0, 0},
-    {0.227451, 0, 0},
-    {0.235294, 0, 0},
-    {0.243137, 0, 0},
-    {0.25098, 0, 0},
-    {0.258824, 0, 0},
-    {0.266667, 0, 0},
-    {0.27451, 0, 0},
-    {0.282353, 0, 0},
-    {0.290196, 0, 0},
-    {0.298039, 0, 0},
-    {0.305882, 0, 0},
-    {0.313725, 0, 0},
-    {0.321569, 0, 0},
-    {0.329412, 0, 0},
-    {0.337255, 0, 0},
-    {0.345098, 0, 0},
-    {0.352941, 0, 0},
-    {0.360784, 0, 0},
-    {0.368627, 0, 0},
-    {0.376471, 0, 0},
-    {0.384314, 0, 0},
-    {0.392157, 0, 0},
-    {0.4, 0, 0},
-    {0.407843, 0, 0},
-    {0.415686, 0, 0},
-    {0.423529, 0, 0},
-    {0.431373, 0, 0},
-    {0.439216, 0, 0},
-    {0.447059, 0, 0},
-    {0.454902, 0, 0},
-    {0.462745, 0, 0},
-    {0.470588, 0, 0},
-    {0.478431, 0, 0},
-    {0.486275, 0, 0},
-    {0.494118, 0, 0},
-    {0.501961, 0.00196078, 0},
-    {0.509804, 0.00980392, 0},
-    {0.517647, 0.0176471, 0},
-    {0.52549, 0.0254902, 0},
-    {0.533333, 0.0333333, 0},
-    {0.541176, 0.0411765, 0},
-    {0.54902, 0.0490196, 0},
-    {0.556863, 0.0568627, 0},
-    {0.564706, 0.0647059, 0},
-    {0.572549, 0.072549, 0},
-    {0.580392, 0.0803922, 0},
-    {0.588235, 0.0882353, 0},
-    {0.596078, 0.0960784, 0},
-    {0.603922, 0.103922, 0},
-    {0.611765, 0.111765, 0},
-    {0.619608, 0.119608, 0},
-    {0.627451, 0.127451, 0},
-    {0.635294, 0.135294, 0},
-    {0.643137, 0.143137, 0},
-    {0.65098, 0.15098, 0},
-    {0.658824, 0.158824, 0},
-    {0.666667, 0.166667, 0},
-    {0.67451, 0.17451, 0},
-    {0.682353, 0.182353, 0},
-    {0.690196, 0.190196, 0},
-    {0.698039, 0.198039, 0},
-    {0.705882, 0.205882, 0},
-    {0.713725, 0.213725, 0},
-    {0.721569, 0.221569, 0},
-    {0.729412, 0.229412, 0},
-    {0.737255, 0.237255, 0},
-    {0.745098, 0.245098, 0},
-    {0.752941, 0.252941, 0},
-    {0.760784, 0.260784, 0},
-    {0.768627, 0.268627, 0},
-    {0.776471, 0.276471, 0},
-    {0.784314, 0.284314, 0},
-    {0.792157, 0.292157, 0},
-    {0.8, 0.3, 0},
-    {0.807843, 0.307843, 0},
-    {0.815686, 0.315686, 0},
-    {0.823529, 0.323529, 0},
-    {0.831373, 0.331373, 0},
-    {0.839216, 0.339216, 0},
-    {0.847059, 0.347059, 0},
-    {0.854902, 0.354902, 0},
-    {0.862745, 0.362745, 0},
-    {0.870588, 0.370588, 0},
-    {0.878431, 0.378431, 0},
-    {0.886275, 0.386275, 0},
-    {0.894118, 0.394118, 0},
-    {0.901961, 0.401961, 0},
-    {0.909804, 0.409804, 0},
-    {0.917647, 0.417647, 0},
-    {0.92549, 0.42549, 0},
-    {0.933333, 0.433333, 0},
-    {0.941176, 0.441176, 0},
-    {0.94902, 0.44902, 0},
-    {0.956863, 0.456863, 0},
-    {0.964706, 0.464706, 0},
-    {0.972549, 0.472549, 0},
-    {0.980392, 0.480392, 0},
-    {0.988235, 0.488235, 0},
-    {0.996078, 0.496078, 0},
-    {1, 0.503922, 0.00392157},
-    {1, 0.511765, 0.0117647},
-    {1, 0.519608, 0.0196078},
-    {1, 0.527451, 0.027451},
-    {1, 0.535294, 0.0352941},
-    {1, 0.543137, 0.0431373},
-    {1, 0.55098, 0.0509804},
-    {1, 0.558824, 0.0588235},
-    {1, 0.566667, 0.0666667},
-    {1, 0.57451, 0.0745098},
-    {1, 0.582353, 0.0823529},
-    {1, 0.590196, 0.0901961},
-    {1, 0.598039, 0.0980392},
-    {1, 0.605882, 0.105882},
-    {1, 0.613725, 0.113725},
-    {1, 0.621569, 0.121569},
-    {1, 0.629412, 0.129412},
-    {1, 0.637255, 0.137255},
-    {1, 0.645098, 0.145098},
-    {1, 0.652941, 0.152941},
-    {1, 0.660784, 0.160784},
-    {1, 0.668627, 0.168627},
-    {1, 0.676471, 0.176471},
-    {1, 0.684314, 0.184314},
-    {1, 0.692157, 0.192157},
-    {1, 0.7, 0.2},
-    {1, 0.707843, 0.207843},
-    {1, 0.715686, 0.215686},
-    {1, 0.723529, 0.223529},
-    {1, 0.731373, 0.231373},
-    {1, 0.739216, 0.239216},
-    {1, 0.747059, 0.247059},
-    {1, 0.754902, 0.254902},
-    {1, 0.762745, 0.262745},
-    {1, 0.770588, 0.270588},
-    {1, 0.778431, 0.278431},
-    {1, 0.786275, 0.286275},
-    {1, 0.794118, 0.294118},
-    {1, 0.801961, 0.301961},
-    {1, 0.809804, 0.309804},
-    {1, 0.817647, 0.317647},
-    {1, 0.82549, 0.32549},
-    {1, 0.833333, 0.333333},
-    {1, 0.841176, 0.341176},
-    {1, 0.84902, 0.34902},
-    {1, 0.856863, 0.356863},
-    {1, 0.864706, 0.364706},
-    {1, 0.872549, 0.372549},
-    {1, 0.880392, 0.380392},
-    {1, 0.888235, 0.388235},
-    {1, 0.896078, 0.396078},
-    {1, 0.903922, 0.403922},
-    {1, 0.911765, 0.411765},
-    {1, 0.919608, 0.419608},
-    {1, 0.927451, 0.427451},
-    {1, 0.935294, 0.435294},
-    {1, 0.943137, 0.443137},
-    {1, 0.95098, 0.45098},
-    {1, 0.958824, 0.458824},
-    {1, 0.966667, 0.466667},
-    {1, 0.97451, 0.47451},
-    {1, 0.982353, 0.482353},
-    {1, 0.990196, 0.490196},
-    {1, 0.998039, 0.498039},
-    {1, 1, 0.505882},
-    {1, 1, 0.513725},
-    {1, 1, 0.521569},
-    {1, 1, 0.529412},
-    {1, 1, 0.537255},
-    {1, 1, 0.545098},
-    {1, 1, 0.552941},
-    {1, 1, 0.560784},
-    {1, 1, 0.568627},
-    {1, 1, 0.576471},
-    {1, 1, 0.584314},
-    {1, 1, 0.592157},
-    {1, 1, 0.6},
-    {1, 1, 0.607843},
-    {1, 1, 0.615686},
-    {1, 1, 0.623529},
-    {1, 1, 0.631373},
-    {1, 1, 0.639216},
-    {1, 1, 0.647059},
-    {1, 1, 0.654902},
-    {1, 1, 0.662745},
-    {1, 1, 0.670588},
-    {1, 1, 0.678431},
-    {1, 1, 0.686275},
-    {1, 1, 0.694118},
-    {1, 1, 0.701961},
-    {1, 1, 0.709804},
-    {1, 1, 0.717647},
-    {1, 1, 0.72549},
-    {1, 1, 0.733333},
-    {1, 1, 0.741176},
-    {1, 1, 0.74902},
-    {1, 1, 0.756863},
-    {1, 1, 0.764706},
-    {1, 1, 0.772549},
-    {1, 1, 0.780392},
-    {1, 1, 0.788235},
-    {1, 1, 0.796078},
-    {1, 1, 0.803922},
-    {1, 1, 0.811765},
-    {1, 1, 0.819608},
-    {1, 1, 0.827451},
-    {1, 1, 0.835294},
-    {1, 1, 0.843137},
-    {1, 1, 0.85098},
-    {1, 1, 0.858824},
-    {1, 1, 0.866667},
-    {1, 1, 0.87451},
-    {1, 1, 0.882353},
-    {1, 1, 0.890196},
-    {1, 1, 0.898039},
-    {1, 1, 0.905882},
-    {1, 1, 0.913725},
-    {1, 1, 0.921569},
-    {1, 1, 0.929412},
-    {1, 1, 0.937255},
-    {1, 1, 0.945098},
-    {1, 1, 0.952941},
-    {1, 1, 0.960784},
-    {1, 1, 0.968627},
-    {1, 1, 0.976471},
-    {1, 1, 0.984314},
-    {1, 1, 0.992157},
-    {1, 1, 1},
+constexpr ControlPoint magma[] = {
+    {0.f, {0.001462f, 0.000466f, 0.013866f}},
+    {0.0117647f, {0.004512f, 0.00349f, 0.029965f}},
+    {0.0352941f, {0.016156f, 0.01384f, 0.076603f}},
+    {0.054902f, {0.031696f, 0.025765f, 0.116965f}},
+    {0.0941176f, {0.074257f, 0.052017f, 0.20266f}},
+    {0.121569f, {0.107899f, 0.064335f, 0.267289f}},
+    {0.145098f, {0.140858f, 0.068654f, 0.324538f}},
+    {0.168627f, {0.178212f, 0.066576f, 0.379497f}},
+    {0.184314f, {0.204935f, 0.062907f, 0.411514f}},
+    {0.2f, {0.232077f, 0.059889f, 0.437695f}},
+    {0.215686f, {0.258857f, 0.059706f, 0.45771f}},
+    {0.235294f, {0.291366f, 0.064553f, 0.475462f}},
+    {0.258824f, {0.329114f, 0.075972f, 0.489287f}},
+    {0.290196f, {0.378211f, 0.095332f, 0.500067f}},
+    {0.333333f, {0.445163f, 0.122724f, 0.506901f}},
+    {0.384314f, {0.52527f, 0.152569f, 0.507192f}},
+    {0.431373f, {0.600868f, 0.177743f, 0.500394f}},
+    {0.47451f, {0.671349f, 0.200133f, 0.487358f}},
+    {0.517647f, {0.742004f, 0.224025f, 0.467018f}},
+    {0.560784f, {0.810855f, 0.252861f, 0.439305f}},
+    {0.592157f, {0.857763f, 0.279857f, 0.415496f}},
+    {0.619608f, {0.8947f, 0.309773f, 0.393995f}},
+    {0.647059f, {0.925937f, 0.346844f, 0.374959f}},
+    {0.670588f, {0.94718f, 0.384178f, 0.363701f}},
+    {0.694118f, {0.96331f, 0.42539f, 0.359469f}},
+    {0.717647f, {0.975082f, 0.468861f, 0.363111f}},
+    {0.741176f, {0.983485f, 0.51328f, 0.374198f}},
+    {0.768627f, {0.990138f, 0.565296f, 0.395122f}},
+    {0.8f, {0.994738f, 0.62435f, 0.427397f}},
+    {0.835294f, {0.997077f, 0.690088f, 0.471811f}},
+    {0.87451f, {0.997019f, 0.762398f, 0.528821f}},
+    {0.917647f, {0.994524f, 0.841387f, 0.598983f}},
+    {0.968627f, {0.989815f, 0.934329f, 0.690198f}},
+    {1.f, {0.987053f, 0.991438f, 0.749504f}},
 };
 
-constexpr colormap_t magma = {
-    {0.001462, 0.000466, 0.013866}, {0.002258, 0.001295, 0.018331},
-    {0.003279, 0.002305, 0.023708}, {0.004512, 0.00349, 0.029965},
-    {0.00595, 0.004843, 0.03713},   {0.007588, 0.006356, 0.044973},
-    {0.009426, 0.008022, 0.052844}, {0.011465, 0.009828, 0.06075},
-    {0.013708, 0.011771, 0.068667}, {0.016156, 0.01384, 0.076603},
-    {0.018815, 0.016026, 0.084584}, {0.021692, 0.01832, 0.09261},
-    {0.024792, 0.020715, 0.100676}, {0.028123, 0.023201, 0.108787},
-    {0.031696, 0.025765, 0.116965}, {0.03552, 0.028397, 0.125209},
-    {0.039608, 0.03109, 0.133515},  {0.04383, 0.03383, 0.141886},
-    {0.048062, 0.036607, 0.150327}, {0.05232, 0.039407, 0.158841},
-    {0.056615, 0.04216, 0.167446},  {0.060949, 0.044794, 0.176129},
-    {0.06533, 0.047318, 0.184892},  {0.069764, 0.049726, 0.193735},
-    {0.074257, 0.052017, 0.20266},  {0.078815, 0.054184, 0.211667},
-    {0.083446, 0.056225, 0.220755}, {0.088155, 0.058133, 0.229922},
-    {0.092949, 0.059904, 0.239164}, {0.097833, 0.061531, 0.248477},
-    {0.102815, 0.06301, 0.257854},  {0.107899, 0.064335, 0.267289},
-    {0.113094, 0.065492, 0.276784}, {0.118405, 0.066479, 0.286321},
-    {0.123833, 0.067295, 0.295879}, {0.12938, 0.067935, 0.305443},
-    {0.135053, 0.068391, 0.315},    {0.140858, 0.068654, 0.324538},
-    {0.146785, 0.068738, 0.334011}, {0.152839, 0.068637, 0.343404},
-    {0.159018, 0.068354, 0.352688}, {0.165308, 0.067911, 0.361816},
-    {0.171713, 0.067305, 0.370771}, {0.178212, 0.066576, 0.379497},
-    {0.184801, 0.065732, 0.387973}, {0.19146, 0.064818, 0.396152},
-    {0.198177, 0.063862, 0.404009}, {0.204935, 0.062907, 0.411514},
-    {0.211718, 0.061992, 0.418647}, {0.218512, 0.061158, 0.425392},
-    {0.225302, 0.060445, 0.431742}, {0.232077, 0.059889, 0.437695},
-    {0.238826, 0.059517, 0.443256}, {0.245543, 0.059352, 0.448436},
-    {0.25222, 0.059415, 0.453248},  {0.258857, 0.059706, 0.45771},
-    {0.265447, 0.060237, 0.46184},  {0.271994, 0.060994, 0.46566},
-    {0.278493, 0.061978, 0.46919},  {0.284951, 0.063168, 0.472451},
-    {0.291366, 0.064553, 0.475462}, {0.29774, 0.066117, 0.478243},
-    {0.304081, 0.067835, 0.480812}, {0.310382, 0.069702, 0.483186},
-    {0.316654, 0.07169, 0.48538},   {0.322899, 0.073782, 0.487408},
-    {0.329114, 0.075972, 0.489287}, {0.335308, 0.078236, 0.491024},
-    {0.341482, 0.080564, 0.492631}, {0.347636, 0.082946, 0.494121},
-    {0.353773, 0.085373, 0.495501}, {0.359898, 0.087831, 0.496778},
-    {0.366012, 0.090314, 0.49796},  {0.372116, 0.092816, 0.499053},
-    {0.378211, 0.095332, 0.500067}, {0.384299, 0.097855, 0.501002},
-    {0.390384, 0.100379, 0.501864}, {0.396467, 0.102902, 0.502658},
-    {0.402548, 0.10542, 0.503386},  {0.408629, 0.10793, 0.504052},
-    {0.414709, 0.110431, 0.504662}, {0.420791, 0.11292, 0.505215},
-    {0.426877, 0.115395, 0.505714}, {0.432967, 0.117855, 0.50616},
-    {0.439062, 0.120298, 0.506555}, {0.445163, 0.122724, 0.506901},
-    {0.451271, 0.125132, 0.507198}, {0.457386, 0.127522, 0.507448},
-    {0.463508, 0.129893, 0.507652}, {0.46964, 0.132245, 0.507809},
-    {0.47578, 0.134577, 0.507921},  {0.481929, 0.136891, 0.507989},
-    {0.488088, 0.139186, 0.508011}, {0.494258, 0.141462, 0.507988},
-    {0.500438, 0.143719, 0.50792},  {0.506629, 0.145958, 0.507806},
-    {0.512831, 0.148179, 0.507648}, {0.519045, 0.150383, 0.507443},
-    {0.52527, 0.152569, 0.507192},  {0.531507, 0.154739, 0.506895},
-    {0.537755, 0.156894, 0.506551}, {0.544015, 0.159033, 0.506159},
-    {0.550287, 0.161158, 0.505719}, {0.556571, 0.163269, 0.50523},
-    {0.562866, 0.165368, 0.504692}, {0.569172, 0.167454, 0.504105},
-    {0.57549, 0.16953, 0.503466},   {0.581819, 0.171596, 0.502777},
-    {0.588158, 0.173652, 0.502035}, {0.594508, 0.175701, 0.501241},
-    {0.600868, 0.177743, 0.500394}, {0.607238, 0.179779, 0.499492},
-    {0.613617, 0.181811, 0.498536}, {0.620005, 0.18384, 0.497524},
-    {0.626401, 0.185867, 0.496456}, {0.632805, 0.187893, 0.495332},
-    {0.639216, 0.189921, 0.49415},  {0.645633, 0.191952, 0.49291},
-    {0.652056, 0.193986, 0.491611}, {0.658483, 0.196027, 0.490253},
-    {0.664915, 0.198075, 0.488836}, {0.671349, 0.200133, 0.487358},
-    {0.677786, 0.202203, 0.485819}, {0.684224, 0.204286, 0.484219},
-    {0.690661, 0.206384, 0.482558}, {0.697098, 0.208501, 0.480835},
-    {0.703532, 0.210638, 0.479049}, {0.709962, 0.212797, 0.477201},
-    {0.716387, 0.214982, 0.47529},  {0.722805, 0.217194, 0.473316},
-    {0.729216, 0.219437, 0.471279}, {0.735616, 0.221713, 0.46918},
-    {0.742004, 0.224025, 0.467018}, {0.748378, 0.226377, 0.464794},
-    {0.754737, 0.228772, 0.462509}, {0.761077, 0.231214, 0.460162},
-    {0.767398, 0.233705, 0.457755}, {0.773695, 0.236249, 0.455289},
-    {0.779968, 0.238851, 0.452765}, {0.786212, 0.241514, 0.450184},
-    {0.792427, 0.244242, 0.447543}, {0.798608, 0.24704, 0.444848},
-    {0.804752, 0.249911, 0.442102}, {0.810855, 0.252861, 0.439305},
-    {0.816914, 0.255895, 0.436461}, {0.822926, 0.259016, 0.433573},
-    {0.828886, 0.262229, 0.430644}, {0.834791, 0.26554, 0.427671},
-    {0.840636, 0.268953, 0.424666}, {0.846416, 0.272473, 0.421631},
-    {0.852126, 0.276106, 0.418573}, {0.857763, 0.279857, 0.415496},
-    {0.86332, 0.283729, 0.412403},  {0.868793, 0.287728, 0.409303},
-    {0.874176, 0.291859, 0.406205}, {0.879464, 0.296125, 0.403118},
-    {0.884651, 0.30053, 0.400047},  {0.889731, 0.305079, 0.397002},
-    {0.8947, 0.309773, 0.393995},   {0.899552, 0.314616, 0.391037},
-    {0.904281, 0.31961, 0.388137},  {0.908884, 0.324755, 0.385308},
-    {0.913354, 0.330052, 0.382563}, {0.917689, 0.3355, 0.379915},
-    {0.921884, 0.341098, 0.377376}, {0.925937, 0.346844, 0.374959},
-    {0.929845, 0.352734, 0.372677}, {0.933606, 0.358764, 0.370541},
-    {0.937221, 0.364929, 0.368567}, {0.940687, 0.371224, 0.366762},
-    {0.944006, 0.377643, 0.365136}, {0.94718, 0.384178, 0.363701},
-    {0.95021, 0.39082, 0.362468},   {0.953099, 0.397563, 0.361438},
-    {0.955849, 0.4044, 0.360619},   {0.958464, 0.411324, 0.360014},
-    {0.960949, 0.418323, 0.35963},  {0.96331, 0.42539, 0.359469},
-    {0.965549, 0.432519, 0.359529}, {0.967671, 0.439703, 0.35981},
-    {0.96968, 0.446936, 0.360311},  {0.971582, 0.45421, 0.36103},
-    {0.973381, 0.46152, 0.361965},  {0.975082, 0.468861, 0.363111},
-    {0.97669, 0.476226, 0.364466},  {0.97821, 0.483612, 0.366025},
-    {0.979645, 0.491014, 0.367783}, {0.981, 0.498428, 0.369734},
-    {0.982279, 0.505851, 0.371874}, {0.983485, 0.51328, 0.374198},
-    {0.984622, 0.520713, 0.376698}, {0.985693, 0.528148, 0.379371},
-    {0.9867, 0.535582, 0.38221},    {0.987646, 0.543015, 0.38521},
-    {0.988533, 0.550446, 0.388365}, {0.989363, 0.557873, 0.391671},
-    {0.990138, 0.565296, 0.395122}, {0.990871, 0.572706, 0.398714},
-    {0.991558, 0.580107, 0.402441}, {0.992196, 0.587502, 0.406299},
-    {0.992785, 0.594891, 0.410283}, {0.993326, 0.602275, 0.41439},
-    {0.993834, 0.609644, 0.418613}, {0.994309, 0.616999, 0.42295},
-    {0.994738, 0.62435, 0.427397},  {0.995122, 0.631696, 0.431951},
-    {0.99548, 0.639027, 0.436607},  {0.99581, 0.646344, 0.441361},
-    {0.996096, 0.653659, 0.446213}, {0.996341, 0.660969, 0.45116},
-    {0.99658, 0.668256, 0.456192},  {0.996775, 0.675541, 0.461314},
-    {0.996925, 0.682828, 0.466526}, {0.997077, 0.690088, 0.471811},
-    {0.997186, 0.697349, 0.477182}, {0.997254, 0.704611, 0.482635},
-    {0.997325, 0.711848, 0.488154}, {0.997351, 0.719089, 0.493755},
-    {0.997351, 0.726324, 0.499428}, {0.997341, 0.733545, 0.505167},
-    {0.997285, 0.740772, 0.510983}, {0.997228, 0.747981, 0.516859},
-    {0.997138, 0.75519, 0.522806},  {0.997019, 0.762398, 0.528821},
-    {0.996898, 0.769591, 0.534892}, {0.996727, 0.776795, 0.541039},
-    {0.996571, 0.783977, 0.547233}, {0.996369, 0.791167, 0.553499},
-    {0.996162, 0.798348, 0.55982},  {0.995932, 0.805527, 0.566202},
-    {0.99568, 0.812706, 0.572645},  {0.995424, 0.819875, 0.57914},
-    {0.995131, 0.827052, 0.585701}, {0.994851, 0.834213, 0.592307},
-    {0.994524, 0.841387, 0.598983}, {0.994222, 0.84854, 0.605696},
-    {0.993866, 0.855711, 0.612482}, {0.993545, 0.862859, 0.619299},
-    {0.99317, 0.870024, 0.626189},  {0.992831, 0.877168, 0.633109},
-    {0.99244, 0.88433, 0.640099},   {0.992089, 0.89147, 0.647116},
-    {0.991688, 0.898627, 0.654202}, {0.991332, 0.905763, 0.661309},
-    {0.99093, 0.912915, 0.668481},  {0.99057, 0.920049, 0.675675},
-    {0.990175, 0.927196, 0.682926}, {0.989815, 0.934329, 0.690198},
-    {0.989434, 0.94147, 0.697519},  {0.989077, 0.948604, 0.704863},
-    {0.988717, 0.955742, 0.712242}, {0.988367, 0.962878, 0.719649},
-    {0.988033, 0.970012, 0.727077}, {0.987691, 0.977154, 0.734536},
-    {0.987387, 0.984288, 0.742002}, {0.987053, 0.991438, 0.749504},
+constexpr ControlPoint inferno[] = {
+    {0.f, {0.001462f, 0.000466f, 0.013866f}},
+    {0.0117647f, {0.004547f, 0.003392f, 0.030909f}},
+    {0.0352941f, {0.016561f, 0.013136f, 0.080282f}},
+    {0.054902f, {0.033385f, 0.023702f, 0.123397f}},
+    {0.0901961f, {0.076637f, 0.041905f, 0.205799f}},
+    {0.113725f, {0.110536f, 0.047399f, 0.262912f}},
+    {0.137255f, {0.149073f, 0.045468f, 0.317085f}},
+    {0.152941f, {0.176493f, 0.041402f, 0.348111f}},
+    {0.168627f, {0.204209f, 0.037632f, 0.373238f}},
+    {0.184314f, {0.231538f, 0.036405f, 0.3924f}},
+    {0.203922f, {0.26481f, 0.039647f, 0.409345f}},
+    {0.227451f, {0.303568f, 0.049396f, 0.422182f}},
+    {0.258824f, {0.354032f, 0.066925f, 0.430906f}},
+    {0.294118f, {0.410113f, 0.087896f, 0.433098f}},
+    {0.333333f, {0.472328f, 0.110547f, 0.428334f}},
+    {0.372549f, {0.534683f, 0.132534f, 0.416667f}},
+    {0.411765f, {0.59694f, 0.154848f, 0.398125f}},
+    {0.45098f, {0.658463f, 0.178962f, 0.372748f}},
+    {0.494118f, {0.724103f, 0.20967f, 0.337424f}},
+    {0.537255f, {0.785929f, 0.247056f, 0.295477f}},
+    {0.576471f, {0.837165f, 0.288385f, 0.252988f}},
+    {0.615686f, {0.882188f, 0.337287f, 0.207628f}},
+    {0.654902f, {0.919879f, 0.393389f, 0.16007f}},
+    {0.690196f, {0.946965f, 0.449191f, 0.115272f}},
+    {0.72549f, {0.967322f, 0.509078f, 0.068659f}},
+    {0.752941f, {0.978422f, 0.557937f, 0.034931f}},
+    {0.764706f, {0.981895f, 0.579392f, 0.02625f}},
+    {0.776471f, {0.984591f, 0.601122f, 0.023606f}},
+    {0.788235f, {0.986502f, 0.623105f, 0.027814f}},
+    {0.8f, {0.987622f, 0.64532f, 0.039886f}},
+    {0.815686f, {0.987874f, 0.675267f, 0.065257f}},
+    {0.835294f, {0.986175f, 0.713153f, 0.103863f}},
+    {0.858824f, {0.981173f, 0.759135f, 0.156863f}},
+    {0.882353f, {0.973088f, 0.805409f, 0.216877f}},
+    {0.901961f, {0.964394f, 0.843848f, 0.273391f}},
+    {0.917647f, {0.956834f, 0.874129f, 0.323974f}},
+    {0.933333f, {0.950018f, 0.903409f, 0.380271f}},
+    {0.94902f, {0.946392f, 0.930761f, 0.442367f}},
+    {0.960784f, {0.947937f, 0.949318f, 0.491426f}},
+    {0.972549f, {0.954529f, 0.965896f, 0.540361f}},
+    {0.984314f, {0.966249f, 0.980678f, 0.587206f}},
+    {1.f, {0.988362f, 0.998364f, 0.644924f}},
 };
 
-constexpr colormap_t inferno = {
-    {0.001462, 0.000466, 0.013866}, {0.002267, 0.00127, 0.01857},
-    {0.003299, 0.002249, 0.024239}, {0.004547, 0.003392, 0.030909},
-    {0.006006, 0.004692, 0.038558}, {0.007676, 0.006136, 0.046836},
-    {0.009561, 0.007713, 0.055143}, {0.011663, 0.009417, 0.06346},
-    {0.013995, 0.011225, 0.071862}, {0.016561, 0.013136, 0.080282},
-    {0.019373, 0.015133, 0.088767}, {0.022447, 0.017199, 0.097327},
-    {0.025793, 0.019331, 0.10593},  {0.029432, 0.021503, 0.114621},
-    {0.033385, 0.023702, 0.123397}, {0.037668, 0.025921, 0.132232},
-    {0.042253, 0.028139, 0.141141}, {0.046915, 0.030324, 0.150164},
-    {0.051644, 0.032474, 0.159254}, {0.056449, 0.034569, 0.168414},
-    {0.06134, 0.03659, 0.177642},   {0.066331, 0.038504, 0.186962},
-    {0.071429, 0.040294, 0.196354}, {0.076637, 0.041905, 0.205799},
-    {0.081962, 0.043328, 0.215289}, {0.087411, 0.044556, 0.224813},
-    {0.09299, 0.045583, 0.234358},  {0.098702, 0.046402, 0.243904},
-    {0.104551, 0.047008, 0.25343},  {0.110536, 0.047399, 0.262912},
-    {0.116656, 0.047574, 0.272321}, {0.122908, 0.047536, 0.281624},
-    {0.129285, 0.047293, 0.290788}, {0.135778, 0.046856, 0.299776},
-    {0.142378, 0.046242, 0.308553}, {0.149073, 0.045468, 0.317085},
-    {0.15585, 0.044559, 0.325338},  {0.162689, 0.043554, 0.333277},
-    {0.169575, 0.042489, 0.340874}, {0.176493, 0.041402, 0.348111},
-    {0.183429, 0.040329, 0.354971}, {0.190367, 0.039309, 0.361447},
-    {0.197297, 0.0384, 0.367535},   {0.204209, 0.037632, 0.373238},
-    {0.211095, 0.03703, 0.378563},  {0.217949, 0.036615, 0.383522},
-    {0.224763, 0.036405, 0.388129}, {0.231538, 0.036405, 0.3924},
-    {0.238273, 0.036621, 0.396353}, {0.244967, 0.037055, 0.400007},
-    {0.25162, 0.037705, 0.403378},  {0.258234, 0.038571, 0.406485},
-    {0.26481, 0.039647, 0.409345},  {0.271347, 0.040922, 0.411976},
-    {0.27785, 0.042353, 0.414392},  {0.284321, 0.043933, 0.416608},
-    {0.290763, 0.045644, 0.418637}, {0.297178, 0.04747, 0.420491},
-    {0.303568, 0.049396, 0.422182}, {0.309935, 0.051407, 0.423721},
-    {0.316282, 0.05349, 0.425116},  {0.32261, 0.055634, 0.426377},
-    {0.328921, 0.057827, 0.427511}, {0.335217, 0.06006, 0.428524},
-    {0.3415, 0.062325, 0.429425},   {0.347771, 0.064616, 0.430217},
-    {0.354032, 0.066925, 0.430906}, {0.360284, 0.069247, 0.431497},
-    {0.366529, 0.071579, 0.431994}, {0.372768, 0.073915, 0.4324},
-    {0.379001, 0.076253, 0.432719}, {0.385228, 0.078591, 0.432955},
-    {0.391453, 0.080927, 0.433109}, {0.397674, 0.083257, 0.433183},
-    {0.403894, 0.08558, 0.433179},  {0.410113, 0.087896, 0.433098},
-    {0.416331, 0.090203, 0.432943}, {0.422549, 0.092501, 0.432714},
-    {0.428768, 0.09479, 0.432412},  {0.434987, 0.097069, 0.432039},
-    {0.441207, 0.099338, 0.431594}, {0.447428, 0.101597, 0.43108},
-    {0.453651, 0.103848, 0.430498}, {0.459875, 0.106089, 0.429846},
-    {0.4661, 0.108322, 0.429125},   {0.472328, 0.110547, 0.428334},
-    {0.478558, 0.112764, 0.427475}, {0.484789, 0.114974, 0.426548},
-    {0.491022, 0.117179, 0.425552}, {0.497257, 0.119379, 0.424488},
-    {0.503493, 0.121575, 0.423356}, {0.50973, 0.123769, 0.422156},
-    {0.515967, 0.12596, 0.420887},  {0.522206, 0.12815, 0.419549},
-    {0.528444, 0.130341, 0.418142}, {0.534683, 0.132534, 0.416667},
-    {0.54092, 0.134729, 0.415123},  {0.547157, 0.136929, 0.413511},
-    {0.553392, 0.139134, 0.411829}, {0.559624, 0.141346, 0.410078},
-    {0.565854, 0.143567, 0.408258}, {0.572081, 0.145797, 0.406369},
-    {0.578304, 0.148039, 0.404411}, {0.584521, 0.150294, 0.402385},
-    {0.590734, 0.152563, 0.40029},  {0.59694, 0.154848, 0.398125},
-    {0.603139, 0.157151, 0.395891}, {0.60933, 0.159474, 0.393589},
-    {0.615513, 0.161817, 0.391219}, {0.621685, 0.164184, 0.388781},
-    {0.627847, 0.166575, 0.386276}, {0.633998, 0.168992, 0.383704},
-    {0.640135, 0.171438, 0.381065}, {0.64626, 0.173914, 0.378359},
-    {0.652369, 0.176421, 0.375586}, {0.658463, 0.178962, 0.372748},
-    {0.66454, 0.181539, 0.369846},  {0.670599, 0.184153, 0.366879},
-    {0.676638, 0.186807, 0.363849}, {0.682656, 0.189501, 0.360757},
-    {0.688653, 0.192239, 0.357603}, {0.694627, 0.195021, 0.354388},
-    {0.700576, 0.197851, 0.351113}, {0.7065, 0.200728, 0.347777},
-    {0.712396, 0.203656, 0.344383}, {0.718264, 0.206636, 0.340931},
-    {0.724103, 0.20967, 0.337424},  {0.729909, 0.212759, 0.333861},
-    {0.735683, 0.215906, 0.330245}, {0.741423, 0.219112, 0.326576},
-    {0.747127, 0.222378, 0.322856}, {0.752794, 0.225706, 0.319085},
-    {0.758422, 0.229097, 0.315266}, {0.76401, 0.232554, 0.311399},
-    {0.769556, 0.236077, 0.307485}, {0.775059, 0.239667, 0.303526},
-    {0.780517, 0.243327, 0.299523}, {0.785929, 0.247056, 0.295477},
-    {0.791293, 0.250856, 0.29139},  {0.796607, 0.254728, 0.287264},
-    {0.801871, 0.258674, 0.283099}, {0.807082, 0.262692, 0.278898},
-    {0.812239, 0.266786, 0.274661}, {0.817341, 0.270954, 0.27039},
-    {0.822386, 0.275197, 0.266085}, {0.827372, 0.279517, 0.26175},
-    {0.832299, 0.283913, 0.257383}, {0.837165, 0.288385, 0.252988},
-    {0.841969, 0.292933, 0.248564}, {0.846709, 0.297559, 0.244113},
-    {0.851384, 0.30226, 0.239636},  {0.855992, 0.307038, 0.235133},
-    {0.860533, 0.311892, 0.230606}, {0.865006, 0.316822, 0.226055},
-    {0.869409, 0.321827, 0.221482}, {0.873741, 0.326906, 0.216886},
-    {0.878001, 0.33206, 0.212268},  {0.882188, 0.337287, 0.207628},
-    {0.886302, 0.342586, 0.202968}, {0.890341, 0.347957, 0.198286},
-    {0.894305, 0.353399, 0.193584}, {0.898192, 0.358911, 0.18886},
-    {0.902003, 0.364492, 0.184116}, {0.905735, 0.37014, 0.17935},
-    {0.90939, 0.375856, 0.174563},  {0.912966, 0.381636, 0.169755},
-    {0.916462, 0.387481, 0.164924}, {0.919879, 0.393389, 0.16007},
-    {0.923215, 0.399359, 0.155193}, {0.92647, 0.405389, 0.150292},
-    {0.929644, 0.411479, 0.145367}, {0.932737, 0.417627, 0.140417},
-    {0.935747, 0.423831, 0.13544},  {0.938675, 0.430091, 0.130438},
-    {0.941521, 0.436405, 0.125409}, {0.944285, 0.442772, 0.120354},
-    {0.946965, 0.449191, 0.115272}, {0.949562, 0.45566, 0.110164},
-    {0.952075, 0.462178, 0.105031}, {0.954506, 0.468744, 0.099874},
-    {0.956852, 0.475356, 0.094695}, {0.959114, 0.482014, 0.089499},
-    {0.961293, 0.488716, 0.084289}, {0.963387, 0.495462, 0.079073},
-    {0.965397, 0.502249, 0.073859}, {0.967322, 0.509078, 0.068659},
-    {0.969163, 0.515946, 0.063488}, {0.970919, 0.522853, 0.058367},
-    {0.97259, 0.529798, 0.053324},  {0.974176, 0.53678, 0.048392},
-    {0.975677, 0.543798, 0.043618}, {0.977092, 0.55085, 0.03905},
-    {0.978422, 0.557937, 0.034931}, {0.979666, 0.565057, 0.031409},
-    {0.980824, 0.572209, 0.028508}, {0.981895, 0.579392, 0.02625},
-    {0.982881, 0.586606, 0.024661}, {0.983779, 0.593849, 0.02377},
-    {0.984591, 0.601122, 0.023606}, {0.985315, 0.608422, 0.024202},
-    {0.985952, 0.61575, 0.025592},  {0.986502, 0.623105, 0.027814},
-    {0.986964, 0.630485, 0.030908}, {0.987337, 0.63789, 0.034916},
-    {0.987622, 0.64532, 0.039886},  {0.987819, 0.652773, 0.045581},
-    {0.987926, 0.66025, 0.05175},   {0.987945, 0.667748, 0.058329},
-    {0.987874, 0.675267, 0.065257}, {0.987714, 0.682807, 0.072489},
-    {0.987464, 0.690366, 0.07999},  {0.987124, 0.697944, 0.087731},
-    {0.986694, 0.70554, 0.095694},  {0.986175, 0.713153, 0.103863},
-    {0.985566, 0.720782, 0.112229}, {0.984865, 0.728427, 0.120785},
-    {0.984075, 0.736087, 0.129527}, {0.983196, 0.743758, 0.138453},
-    {0.982228, 0.751442, 0.147565}, {0.981173, 0.759135, 0.156863},
-    {0.980032, 0.766837, 0.166353}, {0.978806, 0.774545, 0.176037},
-    {0.977497, 0.782258, 0.185923}, {0.976108, 0.789974, 0.196018},
-    {0.974638, 0.797692, 0.206332}, {0.973088, 0.805409, 0.216877},
-    {0.971468, 0.813122, 0.227658}, {0.969783, 0.820825, 0.238686},
-    {0.968041, 0.828515, 0.249972}, {0.966243, 0.836191, 0.261534},
-    {0.964394, 0.843848, 0.273391}, {0.962517, 0.851476, 0.285546},
-    {0.960626, 0.859069, 0.29801},  {0.95872, 0.866624, 0.31082},
-    {0.956834, 0.874129, 0.323974}, {0.954997, 0.881569, 0.337475},
-    {0.953215, 0.888942, 0.351369}, {0.951546, 0.896226, 0.365627},
-    {0.950018, 0.903409, 0.380271}, {0.948683, 0.910473, 0.395289},
-    {0.947594, 0.917399, 0.410665}, {0.946809, 0.924168, 0.426373},
-    {0.946392, 0.930761, 0.442367}, {0.946403, 0.937159, 0.458592},
-    {0.946903, 0.943348, 0.47497},  {0.947937, 0.949318, 0.491426},
-    {0.949545, 0.955063, 0.50786},  {0.95174, 0.960587, 0.524203},
-    {0.954529, 0.965896, 0.540361}, {0.957896, 0.971003, 0.556275},
-    {0.961812, 0.975924, 0.571925}, {0.966249, 0.980678, 0.587206},
-    {0.971162, 0.985282, 0.602154}, {0.976511, 0.989753, 0.61676},
-    {0.982257, 0.994109, 0.631017}, {0.988362, 0.998364, 0.644924},
+constexpr ControlPoint plasma[] = {
+    {0.f, {0.050383f, 0.029803f, 0.527975f}},
+    {0.00784314f, {0.075353f, 0.027206f, 0.538007f}},
+    {0.0196078f, {0.10598f, 0.024309f, 0.551368f}},
+    {0.0392157f, {0.148607f, 0.021154f, 0.570562f}},
+    {0.0705882f, {0.207435f, 0.017442f, 0.596333f}},
+    {0.113725f, {0.280648f, 0.011488f, 0.625038f}},
+    {0.152941f, {0.343925f, 0.004991f, 0.64471f}},
+    {0.188235f, {0.399411f, 0.000859f, 0.656133f}},
+    {0.219608f, {0.447714f, 0.00208f, 0.66024f}},
+    {0.243137f, {0.48321f, 0.00846f, 0.659095f}},
+    {0.266667f, {0.517933f, 0.021563f, 0.654109f}},
+    {0.286275f, {0.546157f, 0.038954f, 0.64701f}},
+    {0.321569f, {0.595011f, 0.07719f, 0.627917f}},
+    {0.360784f, {0.645872f, 0.120898f, 0.598867f}},
+    {0.415686f, {0.710549f, 0.182868f, 0.550004f}},
+    {0.47451f, {0.771958f, 0.249237f, 0.494813f}},
+    {0.541176f, {0.833422f, 0.324635f, 0.434366f}},
+    {0.607843f, {0.887402f, 0.401762f, 0.376494f}},
+    {0.670588f, {0.930798f, 0.477867f, 0.322697f}},
+    {0.72549f, {0.961336f, 0.548636f, 0.275305f}},
+    {0.772549f, {0.980556f, 0.613039f, 0.234646f}},
+    {0.815686f, {0.991365f, 0.675355f, 0.198453f}},
+    {0.854902f, {0.994561f, 0.734791f, 0.168938f}},
+    {0.886275f, {0.991897f, 0.784239f, 0.151042f}},
+    {0.909804f, {0.986509f, 0.822401f, 0.143557f}},
+    {0.933333f, {0.977995f, 0.861432f, 0.142808f}},
+    {0.968627f, {0.959276f, 0.921407f, 0.151566f}},
+    {0.980392f, {0.951726f, 0.941671f, 0.152925f}},
+    {0.988235f, {0.946602f, 0.95519f, 0.150328f}},
+    {0.992157f, {0.944152f, 0.961916f, 0.146861f}},
+    {0.996078f, {0.941896f, 0.96859f, 0.140956f}},
+    {1.f, {0.940015f, 0.975158f, 0.131326f}},
 };
 
-constexpr colormap_t plasma = {
-    {0.050383, 0.029803, 0.527975}, {0.063536, 0.028426, 0.533124},
-    {0.075353, 0.027206, 0.538007}, {0.086222, 0.026125, 0.542658},
-    {0.096379, 0.025165, 0.547103}, {0.10598, 0.024309, 0.551368},
-    {0.115124, 0.023556, 0.555468}, {0.123903, 0.022878, 0.559423},
-    {0.132381, 0.022258, 0.56325},  {0.140603, 0.021687, 0.566959},
-    {0.148607, 0.021154, 0.570562}, {0.156421, 0.020651, 0.574065},
-    {0.16407, 0.020171, 0.577478},  {0.171574, 0.019706, 0.580806},
-    {0.17895, 0.019252, 0.584054},  {0.186213, 0.018803, 0.587228},
-    {0.193374, 0.018354, 0.59033},  {0.200445, 0.017902, 0.593364},
-    {0.207435, 0.017442, 0.596333}, {0.21435, 0.016973, 0.599239},
-    {0.221197, 0.016497, 0.602083}, {0.227983, 0.016007, 0.604867},
-    {0.234715, 0.015502, 0.607592}, {0.241396, 0.014979, 0.610259},
-    {0.248032, 0.014439, 0.612868}, {0.254627, 0.013882, 0.615419},
-    {0.261183, 0.013308, 0.617911}, {0.267703, 0.012716, 0.620346},
-    {0.274191, 0.012109, 0.622722}, {0.280648, 0.011488, 0.625038},
-    {0.287076, 0.010855, 0.627295}, {0.293478, 0.010213, 0.62949},
-    {0.299855, 0.009561, 0.631624}, {0.30621, 0.008902, 0.633694},
-    {0.312543, 0.008239, 0.6357},   {0.318856, 0.007576, 0.63764},
-    {0.32515, 0.006915, 0.639512},  {0.331426, 0.006261, 0.641316},
-    {0.337683, 0.005618, 0.643049}, {0.343925, 0.004991, 0.64471},
-    {0.35015, 0.004382, 0.646298},  {0.356359, 0.003798, 0.64781},
-    {0.362553, 0.003243, 0.649245}, {0.368733, 0.002724, 0.650601},
-    {0.374897, 0.002245, 0.651876}, {0.381047, 0.001814, 0.653068},
-    {0.387183, 0.001434, 0.654177}, {0.393304, 0.001114, 0.655199},
-    {0.399411, 0.000859, 0.656133}, {0.405503, 0.000678, 0.656977},
-    {0.41158, 0.000577, 0.65773},   {0.417642, 0.000564, 0.65839},
-    {0.423689, 0.000646, 0.658956}, {0.429719, 0.000831, 0.659425},
-    {0.435734, 0.001127, 0.659797}, {0.441732, 0.00154, 0.660069},
-    {0.447714, 0.00208, 0.66024},   {0.453677, 0.002755, 0.66031},
-    {0.459623, 0.003574, 0.660277}, {0.46555, 0.004545, 0.660139},
-    {0.471457, 0.005678, 0.659897}, {0.477344, 0.00698, 0.659549},
-    {0.48321, 0.00846, 0.659095},   {0.489055, 0.010127, 0.658534},
-    {0.494877, 0.01199, 0.657865},  {0.500678, 0.014055, 0.657088},
-    {0.506454, 0.016333, 0.656202}, {0.512206, 0.018833, 0.655209},
-    {0.517933, 0.021563, 0.654109}, {0.523633, 0.024532, 0.652901},
-    {0.529306, 0.027747, 0.651586}, {0.534952, 0.031217, 0.650165},
-    {0.54057, 0.03495, 0.64864},    {0.546157, 0.038954, 0.64701},
-    {0.551715, 0.043136, 0.645277}, {0.557243, 0.047331, 0.643443},
-    {0.562738, 0.051545, 0.641509}, {0.568201, 0.055778, 0.639477},
-    {0.573632, 0.060028, 0.637349}, {0.579029, 0.064296, 0.635126},
-    {0.584391, 0.068579, 0.632812}, {0.589719, 0.072878, 0.630408},
-    {0.595011, 0.07719, 0.627917},  {0.600266, 0.081516, 0.625342},
-    {0.605485, 0.085854, 0.622686}, {0.610667, 0.090204, 0.619951},
-    {0.615812, 0.094564, 0.61714},  {0.620919, 0.098934, 0.614257},
-    {0.625987, 0.103312, 0.611305}, {0.631017, 0.107699, 0.608287},
-    {0.636008, 0.112092, 0.605205}, {0.640959, 0.116492, 0.602065},
-    {0.645872, 0.120898, 0.598867}, {0.650746, 0.125309, 0.595617},
-    {0.65558, 0.129725, 0.592317},  {0.660374, 0.134144, 0.588971},
-    {0.665129, 0.138566, 0.585582}, {0.669845, 0.142992, 0.582154},
-    {0.674522, 0.147419, 0.578688}, {0.67916, 0.151848, 0.575189},
-    {0.683758, 0.156278, 0.57166},  {0.688318, 0.160709, 0.568103},
-    {0.69284, 0.165141, 0.564522},  {0.697324, 0.169573, 0.560919},
-    {0.701769, 0.174005, 0.557296}, {0.706178, 0.178437, 0.553657},
-    {0.710549, 0.182868, 0.550004}, {0.714883, 0.187299, 0.546338},
-    {0.719181, 0.191729, 0.542663}, {0.723444, 0.196158, 0.538981},
-    {0.72767, 0.200586, 0.535293},  {0.731862, 0.205013, 0.531601},
-    {0.736019, 0.209439, 0.527908}, {0.740143, 0.213864, 0.524216},
-    {0.744232, 0.218288, 0.520524}, {0.748289, 0.222711, 0.516834},
-    {0.752312, 0.227133, 0.513149}, {0.756304, 0.231555, 0.509468},
-    {0.760264, 0.235976, 0.505794}, {0.764193, 0.240396, 0.502126},
-    {0.76809, 0.244817, 0.498465},  {0.771958, 0.249237, 0.494813},
-    {0.775796, 0.253658, 0.491171}, {0.779604, 0.258078, 0.487539},
-    {0.783383, 0.2625, 0.483918},   {0.787133, 0.266922, 0.480307},
-    {0.790855, 0.271345, 0.476706}, {0.794549, 0.27577, 0.473117},
-    {0.798216, 0.280197, 0.469538}, {0.801855, 0.284626, 0.465971},
-    {0.805467, 0.289057, 0.462415}, {0.809052, 0.293491, 0.45887},
-    {0.812612, 0.297928, 0.455338}, {0.816144, 0.302368, 0.451816},
-    {0.819651, 0.306812, 0.448306}, {0.823132, 0.311261, 0.444806},
-    {0.826588, 0.315714, 0.441316}, {0.830018, 0.320172, 0.437836},
-    {0.833422, 0.324635, 0.434366}, {0.836801, 0.329105, 0.430905},
-    {0.840155, 0.33358, 0.427455},  {0.843484, 0.338062, 0.424013},
-    {0.846788, 0.342551, 0.420579}, {0.850066, 0.347048, 0.417153},
-    {0.853319, 0.351553, 0.413734}, {0.856547, 0.356066, 0.410322},
-    {0.85975, 0.360588, 0.406917},  {0.862927, 0.365119, 0.403519},
-    {0.866078, 0.36966, 0.400126},  {0.869203, 0.374212, 0.396738},
-    {0.872303, 0.378774, 0.393355}, {0.875376, 0.383347, 0.389976},
-    {0.878423, 0.387932, 0.3866},   {0.881443, 0.392529, 0.383229},
-    {0.884436, 0.397139, 0.37986},  {0.887402, 0.401762, 0.376494},
-    {0.89034, 0.406398, 0.37313},   {0.89325, 0.411048, 0.369768},
-    {0.896131, 0.415712, 0.366407}, {0.898984, 0.420392, 0.363047},
-    {0.901807, 0.425087, 0.359688}, {0.904601, 0.429797, 0.356329},
-    {0.907365, 0.434524, 0.35297},  {0.910098, 0.439268, 0.34961},
-    {0.9128, 0.444029, 0.346251},   {0.915471, 0.448807, 0.34289},
-    {0.918109, 0.453603, 0.339529}, {0.920714, 0.458417, 0.336166},
-    {0.923287, 0.463251, 0.332801}, {0.925825, 0.468103, 0.329435},
-    {0.928329, 0.472975, 0.326067}, {0.930798, 0.477867, 0.322697},
-    {0.933232, 0.48278, 0.319325},  {0.93563, 0.487712, 0.315952},
-    {0.93799, 0.492667, 0.312575},  {0.940313, 0.497642, 0.309197},
-    {0.942598, 0.502639, 0.305816}, {0.944844, 0.507658, 0.302433},
-    {0.947051, 0.512699, 0.299049}, {0.949217, 0.517763, 0.295662},
-    {0.951344, 0.52285, 0.292275},  {0.953428, 0.52796, 0.288883},
-    {0.95547, 0.533093, 0.28549},   {0.957469, 0.53825, 0.282096},
-    {0.959424, 0.543431, 0.278701}, {0.961336, 0.548636, 0.275305},
-    {0.963203, 0.553865, 0.271909}, {0.965024, 0.559118, 0.268513},
-    {0.966798, 0.564396, 0.265118}, {0.968526, 0.5697, 0.261721},
-    {0.970205, 0.575028, 0.258325}, {0.971835, 0.580382, 0.254931},
-    {0.973416, 0.585761, 0.25154},  {0.974947, 0.591165, 0.248151},
-    {0.976428, 0.596595, 0.244767}, {0.977856, 0.602051, 0.241387},
-    {0.979233, 0.607532, 0.238013}, {0.980556, 0.613039, 0.234646},
-    {0.981826, 0.618572, 0.231287}, {0.983041, 0.624131, 0.227937},
-    {0.984199, 0.629718, 0.224595}, {0.985301, 0.63533, 0.221265},
-    {0.986345, 0.640969, 0.217948}, {0.987332, 0.646633, 0.214648},
-    {0.98826, 0.652325, 0.211364},  {0.989128, 0.658043, 0.2081},
-    {0.989935, 0.663787, 0.204859}, {0.990681, 0.669558, 0.201642},
-    {0.991365, 0.675355, 0.198453}, {0.991985, 0.681179, 0.195295},
-    {0.992541, 0.68703, 0.19217},   {0.993032, 0.692907, 0.189084},
-    {0.993456, 0.69881, 0.186041},  {0.993814, 0.704741, 0.183043},
-    {0.994103, 0.710698, 0.180097}, {0.994324, 0.716681, 0.177208},
-    {0.994474, 0.722691, 0.174381}, {0.994553, 0.728728, 0.171622},
-    {0.994561, 0.734791, 0.168938}, {0.994495, 0.74088, 0.166335},
-    {0.994355, 0.746995, 0.163821}, {0.994141, 0.753137, 0.161404},
-    {0.993851, 0.759304, 0.159092}, {0.993482, 0.765499, 0.156891},
-    {0.993033, 0.77172, 0.154808},  {0.992505, 0.777967, 0.152855},
-    {0.991897, 0.784239, 0.151042}, {0.991209, 0.790537, 0.149377},
-    {0.990439, 0.796859, 0.14787},  {0.989587, 0.803205, 0.146529},
-    {0.988648, 0.809579, 0.145357}, {0.987621, 0.815978, 0.144363},
-    {0.986509, 0.822401, 0.143557}, {0.985314, 0.828846, 0.142945},
-    {0.984031, 0.835315, 0.142528}, {0.982653, 0.841812, 0.142303},
-    {0.98119, 0.848329, 0.142279},  {0.979644, 0.854866, 0.142453},
-    {0.977995, 0.861432, 0.142808}, {0.976265, 0.868016, 0.143351},
-    {0.974443, 0.874622, 0.144061}, {0.97253, 0.88125, 0.144923},
-    {0.970533, 0.887896, 0.145919}, {0.968443, 0.894564, 0.147014},
-    {0.966271, 0.901249, 0.14818},  {0.964021, 0.90795, 0.14937},
-    {0.961681, 0.914672, 0.15052},  {0.959276, 0.921407, 0.151566},
-    {0.956808, 0.928152, 0.152409}, {0.954287, 0.934908, 0.152921},
-    {0.951726, 0.941671, 0.152925}, {0.949151, 0.948435, 0.152178},
-    {0.946602, 0.95519, 0.150328},  {0.944152, 0.961916, 0.146861},
-    {0.941896, 0.96859, 0.140956},  {0.940015, 0.975158, 0.131326},
+constexpr ControlPoint viridis[] = {
+    {0.f, {0.267004f, 0.004874f, 0.329415f}},
+    {0.0196078f, {0.273809f, 0.031497f, 0.358853f}},
+    {0.0470588f, {0.280267f, 0.073417f, 0.397163f}},
+    {0.0823529f, {0.283229f, 0.120777f, 0.440584f}},
+    {0.117647f, {0.280255f, 0.165693f, 0.476498f}},
+    {0.152941f, {0.271828f, 0.209303f, 0.504434f}},
+    {0.188235f, {0.258965f, 0.251537f, 0.524736f}},
+    {0.227451f, {0.241237f, 0.296485f, 0.539709f}},
+    {0.278431f, {0.21621f, 0.351535f, 0.550627f}},
+    {0.352941f, {0.182256f, 0.426184f, 0.55712f}},
+    {0.439216f, {0.149039f, 0.508051f, 0.55725f}},
+    {0.498039f, {0.128729f, 0.563265f, 0.551229f}},
+    {0.537255f, {0.120092f, 0.600104f, 0.54253f}},
+    {0.564706f, {0.120638f, 0.625828f, 0.533488f}},
+    {0.588235f, {0.128087f, 0.647749f, 0.523491f}},
+    {0.607843f, {0.14021f, 0.665859f, 0.513427f}},
+    {0.631373f, {0.162016f, 0.687316f, 0.499129f}},
+    {0.654902f, {0.19109f, 0.708366f, 0.482284f}},
+    {0.682353f, {0.232815f, 0.732247f, 0.459277f}},
+    {0.709804f, {0.281477f, 0.755203f, 0.432552f}},
+    {0.741176f, {0.344074f, 0.780029f, 0.397381f}},
+    {0.776471f, {0.421908f, 0.805774f, 0.35191f}},
+    {0.815686f, {0.515992f, 0.831158f, 0.294279f}},
+    {0.862745f, {0.636902f, 0.856542f, 0.21662f}},
+    {0.909804f, {0.762373f, 0.876424f, 0.137064f}},
+    {0.92549f, {0.804182f, 0.882046f, 0.114965f}},
+    {0.937255f, {0.83527f, 0.886029f, 0.102646f}},
+    {0.94902f, {0.866013f, 0.889868f, 0.095953f}},
+    {0.960784f, {0.89632f, 0.893616f, 0.096335f}},
+    {0.972549f, {0.926106f, 0.89733f, 0.104071f}},
+    {0.984314f, {0.9553f, 0.901065f, 0.118128f}},
+    {1.f, {0.993248f, 0.906157f, 0.143936f}},
 };
 
-constexpr colormap_t viridis = {
-    {0.267004, 0.004874, 0.329415}, {0.26851, 0.009605, 0.335427},
-    {0.269944, 0.014625, 0.341379}, {0.271305, 0.019942, 0.347269},
-    {0.272594, 0.025563, 0.353093}, {0.273809, 0.031497, 0.358853},
-    {0.274952, 0.037752, 0.364543}, {0.276022, 0.044167, 0.370164},
-    {0.277018, 0.050344, 0.375715}, {0.277941, 0.056324, 0.381191},
-    {0.278791, 0.062145, 0.386592}, {0.279566, 0.067836, 0.391917},
-    {0.280267, 0.073417, 0.397163}, {0.280894, 0.078907, 0.402329},
-    {0.281446, 0.08432, 0.407414},  {0.281924, 0.089666, 0.412415},
-    {0.282327, 0.094955, 0.417331}, {0.282656, 0.100196, 0.42216},
-    {0.28291, 0.105393, 0.426902},  {0.283091, 0.110553, 0.431554},
-    {0.283197, 0.11568, 0.436115},  {0.283229, 0.120777, 0.440584},
-    {0.283187, 0.125848, 0.44496},  {0.283072, 0.130895, 0.449241},
-    {0.282884, 0.13592, 0.453427},  {0.282623, 0.140926, 0.457517},
-    {0.28229, 0.145912, 0.46151},   {0.281887, 0.150881, 0.465405},
-    {0.281412, 0.155834, 0.469201}, {0.280868, 0.160771, 0.472899},
-    {0.280255, 0.165693, 0.476498}, {0.279574, 0.170599, 0.479997},
-    {0.278826, 0.17549, 0.483397},  {0.278012, 0.180367, 0.486697},
-    {0.277134, 0.185228, 0.489898}, {0.276194, 0.190074, 0.493001},
-    {0.275191, 0.194905, 0.496005}, {0.274128, 0.199721, 0.498911},
-    {0.273006, 0.20452, 0.501721},  {0.271828, 0.209303, 0.504434},
-    {0.270595, 0.214069, 0.507052}, {0.269308, 0.218818, 0.509577},
-    {0.267968, 0.223549, 0.512008}, {0.26658, 0.228262, 0.514349},
-    {0.265145, 0.232956, 0.516599}, {0.263663, 0.237631, 0.518762},
-    {0.262138, 0.242286, 0.520837}, {0.260571, 0.246922, 0.522828},
-    {0.258965, 0.251537, 0.524736}, {0.257322, 0.25613, 0.526563},
-    {0.255645, 0.260703, 0.528312}, {0.253935, 0.265254, 0.529983},
-    {0.252194, 0.269783, 0.531579}, {0.250425, 0.27429, 0.533103},
-    {0.248629, 0.278775, 0.534556}, {0.246811, 0.283237, 0.535941},
-    {0.244972, 0.287675, 0.53726},  {0.243113, 0.292092, 0.538516},
-    {0.241237, 0.296485, 0.539709}, {0.239346, 0.300855, 0.540844},
-    {0.237441, 0.305202, 0.541921}, {0.235526, 0.309527, 0.542944},
-    {0.233603, 0.313828, 0.543914}, {0.231674, 0.318106, 0.544834},
-    {0.229739, 0.322361, 0.545706}, {0.227802, 0.326594, 0.546532},
-    {0.225863, 0.330805, 0.547314}, {0.223925, 0.334994, 0.548053},
-    {0.221989, 0.339161, 0.548752}, {0.220057, 0.343307, 0.549413},
-    {0.21813, 0.347432, 0.550038},  {0.21621, 0.351535, 0.550627},
-    {0.214298, 0.355619, 0.551184}, {0.212395, 0.359683, 0.55171},
-    {0.210503, 0.363727, 0.552206}, {0.208623, 0.367752, 0.552675},
-    {0.206756, 0.371758, 0.553117}, {0.204903, 0.375746, 0.553533},
-    {0.203063, 0.379716, 0.553925}, {0.201239, 0.38367, 0.554294},
-    {0.19943, 0.387607, 0.554642},  {0.197636, 0.391528, 0.554969},
-    {0.19586, 0.395433, 0.555276},  {0.1941, 0.399323, 0.555565},
-    {0.192357, 0.403199, 0.555836}, {0.190631, 0.407061, 0.556089},
-    {0.188923, 0.41091, 0.556326},  {0.187231, 0.414746, 0.556547},
-    {0.185556, 0.41857, 0.556753},  {0.183898, 0.422383, 0.556944},
-    {0.182256, 0.426184, 0.55712},  {0.180629, 0.429975, 0.557282},
-    {0.179019, 0.433756, 0.55743},  {0.177423, 0.437527, 0.557565},
-    {0.175841, 0.44129, 0.557685},  {0.174274, 0.445044, 0.557792},
-    {0.172719, 0.448791, 0.557885}, {0.171176, 0.45253, 0.557965},
-    {0.169646, 0.456262, 0.55803},  {0.168126, 0.459988, 0.558082},
-    {0.166617, 0.463708, 0.558119}, {0.165117, 0.467423, 0.558141},
-    {0.163625, 0.471133, 0.558148}, {0.162142, 0.474838, 0.55814},
-    {0.160665, 0.47854, 0.558115},  {0.159194, 0.482237, 0.558073},
-    {0.157729, 0.485932, 0.558013}, {0.15627, 0.489624, 0.557936},
-    {0.154815, 0.493313, 0.55784},  {0.153364, 0.497, 0.557724},
-    {0.151918, 0.500685, 0.557587}, {0.150476, 0.504369, 0.55743},
-    {0.149039, 0.508051, 0.55725},  {0.147607, 0.511733, 0.557049},
-    {0.14618, 0.515413, 0.556823},  {0.144759, 0.519093, 0.556572},
-    {0.143343, 0.522773, 0.556295}, {0.141935, 0.526453, 0.555991},
-    {0.140536, 0.530132, 0.555659}, {0.139147, 0.533812, 0.555298},
-    {0.13777, 0.537492, 0.554906},  {0.136408, 0.541173, 0.554483},
-    {0.135066, 0.544853, 0.554029}, {0.133743, 0.548535, 0.553541},
-    {0.132444, 0.552216, 0.553018}, {0.131172, 0.555899, 0.552459},
-    {0.129933, 0.559582, 0.551864}, {0.128729, 0.563265, 0.551229},
-    {0.127568, 0.566949, 0.550556}, {0.126453, 0.570633, 0.549841},
-    {0.125394, 0.574318, 0.549086}, {0.124395, 0.578002, 0.548287},
-    {0.123463, 0.581687, 0.547445}, {0.122606, 0.585371, 0.546557},
-    {0.121831, 0.589055, 0.545623}, {0.121148, 0.592739, 0.544641},
-    {0.120565, 0.596422, 0.543611}, {0.120092, 0.600104, 0.54253},
-    {0.119738, 0.603785, 0.5414},   {0.119512, 0.607464, 0.540218},
-    {0.119423, 0.611141, 0.538982}, {0.119483, 0.614817, 0.537692},
-    {0.119699, 0.61849, 0.536347},  {0.120081, 0.622161, 0.534946},
-    {0.120638, 0.625828, 0.533488}, {0.12138, 0.629492, 0.531973},
-    {0.122312, 0.633153, 0.530398}, {0.123444, 0.636809, 0.528763},
-    {0.12478, 0.640461, 0.527068},  {0.126326, 0.644107, 0.525311},
-    {0.128087, 0.647749, 0.523491}, {0.130067, 0.651384, 0.521608},
-    {0.132268, 0.655014, 0.519661}, {0.134692, 0.658636, 0.517649},
-    {0.137339, 0.662252, 0.515571}, {0.14021, 0.665859, 0.513427},
-    {0.143303, 0.669459, 0.511215}, {0.146616, 0.67305, 0.508936},
-    {0.150148, 0.676631, 0.506589}, {0.153894, 0.680203, 0.504172},
-    {0.157851, 0.683765, 0.501686}, {0.162016, 0.687316, 0.499129},
-    {0.166383, 0.690856, 0.496502}, {0.170948, 0.694384, 0.493803},
-    {0.175707, 0.6979, 0.491033},   {0.180653, 0.701402, 0.488189},
-    {0.185783, 0.704891, 0.485273}, {0.19109, 0.708366, 0.482284},
-    {0.196571, 0.711827, 0.479221}, {0.202219, 0.715272, 0.476084},
-    {0.20803, 0.718701, 0.472873},  {0.214, 0.722114, 0.469588},
-    {0.220124, 0.725509, 0.466226}, {0.226397, 0.728888, 0.462789},
-    {0.232815, 0.732247, 0.459277}, {0.239374, 0.735588, 0.455688},
-    {0.24607, 0.73891, 0.452024},   {0.252899, 0.742211, 0.448284},
-    {0.259857, 0.745492, 0.444467}, {0.266941, 0.748751, 0.440573},
-    {0.274149, 0.751988, 0.436601}, {0.281477, 0.755203, 0.432552},
-    {0.288921, 0.758394, 0.428426}, {0.296479, 0.761561, 0.424223},
-    {0.304148, 0.764704, 0.419943}, {0.311925, 0.767822, 0.415586},
-    {0.319809, 0.770914, 0.411152}, {0.327796, 0.77398, 0.40664},
-    {0.335885, 0.777018, 0.402049}, {0.344074, 0.780029, 0.397381},
-    {0.35236, 0.783011, 0.392636},  {0.360741, 0.785964, 0.387814},
-    {0.369214, 0.788888, 0.382914}, {0.377779, 0.791781, 0.377939},
-    {0.386433, 0.794644, 0.372886}, {0.395174, 0.797475, 0.367757},
-    {0.404001, 0.800275, 0.362552}, {0.412913, 0.803041, 0.357269},
-    {0.421908, 0.805774, 0.35191},  {0.430983, 0.808473, 0.346476},
-    {0.440137, 0.811138, 0.340967}, {0.449368, 0.813768, 0.335384},
-    {0.458674, 0.816363, 0.329727}, {0.468053, 0.818921, 0.323998},
-    {0.477504, 0.821444, 0.318195}, {0.487026, 0.823929, 0.312321},
-    {0.496615, 0.826376, 0.306377}, {0.506271, 0.828786, 0.300362},
-    {0.515992, 0.831158, 0.294279}, {0.525776, 0.833491, 0.288127},
-    {0.535621, 0.835785, 0.281908}, {0.545524, 0.838039, 0.275626},
-    {0.555484, 0.840254, 0.269281}, {0.565498, 0.84243, 0.262877},
-    {0.575563, 0.844566, 0.256415}, {0.585678, 0.846661, 0.249897},
-    {0.595839, 0.848717, 0.243329}, {0.606045, 0.850733, 0.236712},
-    {0.616293, 0.852709, 0.230052}, {0.626579, 0.854645, 0.223353},
-    {0.636902, 0.856542, 0.21662},  {0.647257, 0.8584, 0.209861},
-    {0.657642, 0.860219, 0.203082}, {0.668054, 0.861999, 0.196293},
-    {0.678489, 0.863742, 0.189503}, {0.688944, 0.865448, 0.182725},
-    {0.699415, 0.867117, 0.175971}, {0.709898, 0.868751, 0.169257},
-    {0.720391, 0.87035, 0.162603},  {0.730889, 0.871916, 0.156029},
-    {0.741388, 0.873449, 0.149561}, {0.751884, 0.874951, 0.143228},
-    {0.762373, 0.876424, 0.137064}, {0.772852, 0.877868, 0.131109},
-    {0.783315, 0.879285, 0.125405}, {0.79376, 0.880678, 0.120005},
-    {0.804182, 0.882046, 0.114965}, {0.814576, 0.883393, 0.110347},
-    {0.82494, 0.88472, 0.106217},   {0.83527, 0.886029, 0.102646},
-    {0.845561, 0.887322, 0.099702}, {0.85581, 0.888601, 0.097452},
-    {0.866013, 0.889868, 0.095953}, {0.876168, 0.891125, 0.09525},
-    {0.886271, 0.892374, 0.095374}, {0.89632, 0.893616, 0.096335},
-    {0.906311, 0.894855, 0.098125}, {0.916242, 0.896091, 0.100717},
-    {0.926106, 0.89733, 0.104071},  {0.935904, 0.89857, 0.108131},
-    {0.945636, 0.899815, 0.112838}, {0.9553, 0.901065, 0.118128},
-    {0.964894, 0.902323, 0.123941}, {0.974417, 0.90359, 0.130215},
-    {0.983868, 0.904867, 0.136897}, {0.993248, 0.906157, 0.143936},
+// The palettes, in the order of their indexes.
+constexpr Palette registry[] = {
+    {"spring", spring, std::size(spring)},
+    {"summer", summer, std::size(summer)},
+    {"autumn", autumn, std::size(autumn)},
+    {"winter", winter, std::size(winter)},
+    {"bone", bone, std::size(bone)},
+    {"cool", cool, std::size(cool)},
+    {"hot", hot, std::size(hot)},
+    {"copper", copper, std::size(copper)},
+    {"hsv", hsv, std::size(hsv)},
+    {"nipy_spectral", nipy_spectral, std::size(nipy_spectral)},
+    {"jet", jet, std::size(jet)},
+    {"terrain", terrain, std::size(terrain)},
+    {"seismic", seismic, std::size(seismic)},
+    {"afmhot", afmhot, std::size(afmhot)},
+    {"magma", magma, std::size(magma)},
+    {"inferno", inferno, std::size(inferno)},
+    {"plasma", plasma, std::size(plasma)},
+    {"viridis", viridis, std::size(viridis)},
 };
 
-constexpr colormap_t* paletas_l[] = {
-    &spring,  &summer, &autumn, &winter,        &bone,   &cool,
-    &hot,     &copper, &hsv,    &nipy_spectral, &jet,    &terrain,
-    &seismic, &afmhot, &magma,  &inferno,       &plasma, &viridis};
+constexpr size_t num_paletas = std::size(registry);
+
+constexpr const Palette& palette(const size_t index) {
+   return registry[index < num_paletas ? index : 0];
+}
+
+constexpr float clamp01(float value) {
+   // NaN goes to 0 as well.
+   return value > 0.f ? (value < 1.f ? value : 1.f) : 0.f;
+}
+
+constexpr Rgb interpolate(const Palette& palette, float position) {
+   position = clamp01(position);
+   size_t next = 1;
+   while (next + 1 < palette.count &&
+          palette.points[next].position <= position) {
+      ++next;
+   }
+   const ControlPoint& a = palette.points[next - 1];
+   const ControlPoint& b = palette.points[next];
+   float t = clamp01((position - a.position) / (b.position - a.position));
+   return {a.color.r + t * (b.color.r - a.color.r),
+           a.color.g + t * (b.color.g - a.color.g),
+           a.color.b + t * (b.color.b - a.color.b)};
+}
+
+constexpr uint32_t channel(float value) {
+   return static_cast<uint32_t>(clamp01(value) * 255.f + 0.5f);
+}
 
-constexpr size_t num_paletas = sizeof(paletas_l);
+// Built by the compiler, so they cost nothing at startup.
+constexpr std::array<rgba8_t, num_paletas> rgba8_tables = [] {
+   std::array<rgba8_t, num_paletas> tables{};
+   for (size_t p = 0; p < num_paletas; ++p) {
+      for (size_t i = 0; i < color_points; ++i) {
+         Rgb c = interpolate(registry[p],
+                             static_cast<float>(i) / (color_points - 1));
+         tables[p][i] = channel(c.r) | channel(c.g) << 8 |
+                        channel(c.b) << 16 | 0xFF000000u;
+      }
+   }
+   return tables;
+}();
 
-const colormap_t* const colormap(const size_t index) {
-   if (index >= num_paletas) {
-      std::stringstream ss;
-      ss << "colormap out of bounds: index is " << index
-         << ", but size is: " << num_paletas;
-      throw new std::runtime_error(ss.str());
+constexpr size_t names_size = [] {
+   // Every name with its '\0', and the empty one that ends them.
+   size_t size = 1;
+   for (const Palette& palette : registry) {
+      for (const char* c = palette.name; *c; ++c) ++size;
+      ++size;
    }
-   return paletas_l[index];
+   return size;
+}();
+
+constexpr std::array<char, names_size> names = [] {
+   std::array<char, names_size> names{};
+   size_t i = 0;
+   for (const Palette& palette : registry) {
+      for (const char* c = palette.name; *c; ++c) names[i++] = *c;
+      names[i++] = '\0';
+   }
+   return names;
+}();
+
+}  // namespace
+
+size_t count() {
+   return num_paletas;
+}
+
+const char* name(const size_t index) {
+   return palette(index).name;
 }
 
 const char* paletas() {
-   return "spring\0"
-          "summer\0"
-          "autumn\0"
-          "winter\0"
-          "bone\0"
-          "cool\0"
-          "hot\0"
-          "copper\0"
-          "hsv\0"
-          "nipy_spectral\0"
-          "jet\0"
-          "terrain\0"
-          "seismic\0"
-          "afmhot\0"
-          "magma\0"
-          "inferno\0"
-          "plasma\0"
-          "viridis\0";
+   return names.data();
+}
+
+Rgb color(const size_t index, float norm_amount) {
+   return interpolate(palette(index), norm_amount);
+}
+
+const rgba8_t& rgba8(const size_t index) {
+   return rgba8_tables[index < num_paletas ? index : 0];
 }
 
 }  // namespace colormap
@@ -1,16 +1,67 @@
 #pragma once
 
-#define GLM_FORCE_RADIANS
-#define GLM_FORCE_DEPTH_ZERO_TO_ONE
-#include <glm/glm.hpp>
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
 
+/**
+ * Palettes to color values normalised to [0, 1], matplotlib's, made at
+ * compile time from a few control points each. A palette is picked by
+ * its index; indexes past the last palette pick the first, so lookups
+ * never fail.
+ */
 namespace colormap {
 
 constexpr size_t color_points = 256;
-typedef const glm::vec3 colormap_t[color_points];
 
-const colormap_t* const colormap(const size_t);
+struct Rgb {
+   float r;
+   float g;
+   float b;
+};
 
+// A palette as packed RGBA8 colors, red in the low byte and opaque: the
+// texels of a VK_FORMAT_R8G8B8A8_UNORM image. Entry i is the color at
+// i / (color_points - 1).
+typedef std::array<uint32_t, color_points> rgba8_t;
+
+size_t count();
+
+const char* name(const size_t);
+
+// The names in index order, each ended by '\0', and an empty one after
+// them, as ImGui::Combo takes them.
 const char* paletas();
 
+// Color at norm_amount, clamped to [0, 1], interpolated in float
+// between the control points.
+Rgb color(const size_t, float norm_amount);
+
+const rgba8_t& rgba8(const size_t);
+
+/**
+ * Color of norm_amount, clamped to [0, 1], in a palette from rgba8. The
+ * two nearest entries are blended with an 8 bit fixed-point fraction,
+ * two channels per multiply, so it's cheap enough for hot loops.
+ */
+inline uint32_t sample(const rgba8_t& palette, float norm_amount) {
+   // NaN goes to 0 as well.
+   float clamped = norm_amount > 0.f ? std::min(norm_amount, 1.f) : 0.f;
+   uint32_t fixed =
+       static_cast<uint32_t>(clamped * ((color_points - 1) << 8) + 0.5f);
+   uint32_t index = fixed >> 8;
+   if (index == color_points - 1) return palette[index];
+   uint32_t t = fixed & 0xFF;
+   uint32_t a = palette[index];
+   uint32_t b = palette[index + 1];
+   uint32_t red_blue =
+       (((a & 0xFF00FF) * (256 - t) + (b & 0xFF00FF) * t) >> 8) &
+       0xFF00FF;
+   uint32_t green_alpha = (((a >> 8) & 0xFF00FF) * (256 - t) +
+                           ((b >> 8) & 0xFF00FF) * t) &
+                          0xFF00FF00;
+   return red_blue | green_alpha;
+}
+
 }  // namespace colormaps
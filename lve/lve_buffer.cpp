@@ -8,6 +8,7 @@
 #include "lve_buffer.hpp"
 
 // std
+#include <algorithm>
 #include <cassert>
 #include <cstring>
 
@@ -209,4 +210,24 @@ VkResult LveBuffer::invalidateIndex(int index) {
    return invalidate(alignmentSize, index * alignmentSize);
 }
 
+VkIndexType indexTypeFor(const std::vector<uint32_t>& indices) {
+   for (uint32_t index : indices) {
+      if (index >= 0xffff && index != 0xffffffff) {
+         return VK_INDEX_TYPE_UINT32;
+      }
+   }
+   return VK_INDEX_TYPE_UINT16;
+}
+
+std::vector<uint16_t> narrowIndices(const std::vector<uint32_t>& indices) {
+   std::vector<uint16_t> narrow(indices.size());
+   std::transform(indices.begin(), indices.end(), narrow.begin(),
+                  [](uint32_t index) {
+                     return index == 0xffffffff
+                                ? uint16_t{0xffff}
+                                : static_cast<uint16_t>(index);
+                  });
+   return narrow;
+}
+
 }  // namespace lve
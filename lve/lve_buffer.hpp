@@ -1,5 +1,8 @@
 #pragma once
 
+#include <cstdint>
+#include <vector>
+
 #include "lve_device.hpp"
 
 namespace lve {
@@ -75,4 +78,15 @@ class LveBuffer {
    VkMemoryPropertyFlags memoryPropertyFlags;
 };
 
+/**
+ * Narrowest index type that holds every index: 16-bit when they are all
+ * below 0xffff, which would read as a primitive restart, else 32-bit.
+ * The 32-bit restart index 0xffffffff doesn't count, narrowIndices
+ * turns it into the 16-bit one.
+ */
+VkIndexType indexTypeFor(const std::vector<uint32_t>& indices);
+
+// The indices as 16-bit ones, for when indexTypeFor gives UINT16.
+std::vector<uint16_t> narrowIndices(const std::vector<uint32_t>& indices);
+
 }  // namespace lve
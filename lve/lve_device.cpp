@@ -154,9 +154,15 @@ void LveDevice::createLogicalDevice() {
       queueCreateInfos.push_back(queueCreateInfo);
    }
 
+   VkPhysicalDeviceFeatures supportedFeatures;
+   vkGetPhysicalDeviceFeatures(physicalDevice, &supportedFeatures);
+
    VkPhysicalDeviceFeatures deviceFeatures = {};
    deviceFeatures.samplerAnisotropy = VK_TRUE;
 	deviceFeatures.fillModeNonSolid = VK_TRUE;
+   // Optional, lets the terrain draw every chunk in one indirect call.
+   deviceFeatures.multiDrawIndirect = supportedFeatures.multiDrawIndirect;
+   features = deviceFeatures;
 
    VkDeviceCreateInfo createInfo = {};
    createInfo.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
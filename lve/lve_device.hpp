@@ -97,6 +97,8 @@ class LveDevice {
                             VkImage &image, VkDeviceMemory &imageMemory);
 
    VkPhysicalDeviceProperties properties;
+   // Features enabled on the logical device.
+   VkPhysicalDeviceFeatures features{};
 
   private:
    void createInstance();
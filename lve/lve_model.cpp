@@ -82,8 +82,17 @@ void LveModel::createIndexBuffers(const std::vector<uint32_t> &indices) {
 
    if (!hasIndexBuffer) return;
 
-   VkDeviceSize bufferSize = sizeof(indices[0]) * indexCount;
+   // Small meshes upload their indices as 16-bit.
+   indexType = indexTypeFor(indices);
+   std::vector<uint16_t> narrow;
+   const void *data = indices.data();
    uint32_t indexSize = sizeof(indices[0]);
+   if (indexType == VK_INDEX_TYPE_UINT16) {
+      narrow.assign(indices.begin(), indices.end());
+      data = narrow.data();
+      indexSize = sizeof(narrow[0]);
+   }
+   VkDeviceSize bufferSize = indexSize * indexCount;
 
    LveBuffer stagingBuffer{
        lveDevice,
@@ -95,7 +104,7 @@ void LveModel::createIndexBuffers(const std::vector<uint32_t> &indices) {
    };
 
    stagingBuffer.map();
-   stagingBuffer.writeToBuffer((void *)indices.data());
+   stagingBuffer.writeToBuffer(const_cast<void *>(data));
 
    indexBuffer = std::make_unique<LveBuffer>(
        lveDevice, indexSize, indexCount,
@@ -121,7 +130,7 @@ void LveModel::bind(VkCommandBuffer commandBuffer) {
 
    if (hasIndexBuffer) {
       vkCmdBindIndexBuffer(commandBuffer, indexBuffer->getBuffer(), 0,
-                           VK_INDEX_TYPE_UINT32);
+                           indexType);
    }
 }
 
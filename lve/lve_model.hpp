@@ -62,6 +62,7 @@ class LveModel {
    bool hasIndexBuffer = false;
    std::unique_ptr<LveBuffer> indexBuffer;
    uint32_t indexCount;
+   VkIndexType indexType = VK_INDEX_TYPE_UINT32;
 };
 
 }  // namespace lve
@@ -0,0 +1,127 @@
+#include "lve_palette.hpp"
+
+#include <stdexcept>
+
+#include "colormaps.hpp"
+#include "lve_buffer.hpp"
+
+namespace lve {
+
+LvePalette::LvePalette(LveDevice &device, size_t paleta)
+    : lveDevice{device}, paleta{paleta} {
+   VkImageCreateInfo imageInfo{};
+   imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+   imageInfo.imageType = VK_IMAGE_TYPE_1D;
+   imageInfo.format = VK_FORMAT_R8G8B8A8_UNORM;
+   imageInfo.extent.width = colormap::color_points;
+   imageInfo.extent.height = 1;
+   imageInfo.extent.depth = 1;
+   imageInfo.mipLevels = 1;
+   imageInfo.arrayLayers = 1;
+   imageInfo.samples = VK_SAMPLE_COUNT_1_BIT;
+   imageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+   imageInfo.usage =
+       VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT;
+   imageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+   imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+   lveDevice.createImageWithInfo(imageInfo,
+                                 VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+                                 image, imageMemory);
+
+   VkImageViewCreateInfo viewInfo{};
+   viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+   viewInfo.image = image;
+   viewInfo.viewType = VK_IMAGE_VIEW_TYPE_1D;
+   viewInfo.format = VK_FORMAT_R8G8B8A8_UNORM;
+   viewInfo.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+   viewInfo.subresourceRange.levelCount = 1;
+   viewInfo.subresourceRange.layerCount = 1;
+   if (vkCreateImageView(lveDevice.device(), &viewInfo, nullptr,
+                         &imageView) != VK_SUCCESS) {
+      throw std::runtime_error("failed to create palette image view!");
+   }
+
+   // Clamped, so the ends of the palette are its first and last colors.
+   VkSamplerCreateInfo samplerInfo{};
+   samplerInfo.sType = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
+   samplerInfo.magFilter = VK_FILTER_LINEAR;
+   samplerInfo.minFilter = VK_FILTER_LINEAR;
+   samplerInfo.mipmapMode = VK_SAMPLER_MIPMAP_MODE_NEAREST;
+   samplerInfo.addressModeU = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+   samplerInfo.addressModeV = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+   samplerInfo.addressModeW = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+   samplerInfo.maxAnisotropy = 1.f;
+   if (vkCreateSampler(lveDevice.device(), &samplerInfo, nullptr,
+                       &sampler) != VK_SUCCESS) {
+      throw std::runtime_error("failed to create palette sampler!");
+   }
+
+   setColormap(paleta);
+}
+
+LvePalette::~LvePalette() {
+   vkDestroySampler(lveDevice.device(), sampler, nullptr);
+   vkDestroyImageView(lveDevice.device(), imageView, nullptr);
+   vkDestroyImage(lveDevice.device(), image, nullptr);
+   vkFreeMemory(lveDevice.device(), imageMemory, nullptr);
+}
+
+void LvePalette::setColormap(size_t paleta) {
+   const colormap::rgba8_t &colors = colormap::rgba8(paleta);
+   this->paleta = paleta;
+
+   LveBuffer stagingBuffer{
+       lveDevice,
+       sizeof(uint32_t),
+       static_cast<uint32_t>(colors.size()),
+       VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+       VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
+           VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+   };
+   stagingBuffer.map();
+   stagingBuffer.writeToBuffer((void *)colors.data());
+
+   VkCommandBuffer commandBuffer = lveDevice.beginSingleTimeCommands();
+
+   // The old colors are dropped once earlier frames are done with them.
+   VkImageMemoryBarrier barrier{};
+   barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+   barrier.srcAccessMask = 0;
+   barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+   barrier.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+   barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+   barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+   barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+   barrier.image = image;
+   barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+   barrier.subresourceRange.levelCount = 1;
+   barrier.subresourceRange.layerCount = 1;
+   vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+                        VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0,
+                        nullptr, 1, &barrier);
+
+   VkBufferImageCopy region{};
+   region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+   region.imageSubresource.layerCount = 1;
+   region.imageExtent = {static_cast<uint32_t>(colors.size()), 1, 1};
+   vkCmdCopyBufferToImage(commandBuffer, stagingBuffer.getBuffer(), image,
+                          VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1,
+                          &region);
+
+   barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+   barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+   barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+   barrier.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+   vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT,
+                        VK_PIPELINE_STAGE_VERTEX_SHADER_BIT, 0, 0, nullptr,
+                        0, nullptr, 1, &barrier);
+
+   lveDevice.endSingleTimeCommands(commandBuffer);
+}
+
+VkDescriptorImageInfo LvePalette::descriptorInfo() const {
+   return VkDescriptorImageInfo{sampler, imageView,
+                                VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL};
+}
+
+}  // namespace lve
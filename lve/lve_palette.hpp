@@ -0,0 +1,51 @@
+#pragma once
+
+#include <vulkan/vulkan_core.h>
+
+#include <cstddef>
+
+#include "lve_device.hpp"
+
+namespace lve {
+
+/**
+ * A colormap palette as a 1D RGBA8 texture with linear filtering, for
+ * shaders to color by a normalised value: sampled at
+ * (value * (size - 1) + 0.5) / size it blends the two nearest entries
+ * like the palette is interpolated on the CPU. Changing the palette is
+ * a small upload into the same image, so descriptor sets that use it
+ * stay valid.
+ */
+class LvePalette {
+  public:
+   LvePalette(LveDevice &device, size_t paleta);
+   ~LvePalette();
+
+   LvePalette(const LvePalette &) = delete;
+   LvePalette &operator=(const LvePalette &) = delete;
+
+   /**
+    * Replaces the colors with those of palette paleta. Waits for the
+    * graphics queue, frames in flight may still be sampling the old
+    * ones.
+    */
+   void setColormap(size_t paleta);
+
+   size_t colormap() const {
+      return paleta;
+   }
+
+   // For a VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER binding.
+   VkDescriptorImageInfo descriptorInfo() const;
+
+  private:
+   LveDevice &lveDevice;
+   size_t paleta;
+
+   VkImage image;
+   VkDeviceMemory imageMemory;
+   VkImageView imageView;
+   VkSampler sampler;
+};
+
+}  // namespace lve
@@ -61,6 +61,17 @@ void LvePipeline::createGraphicsPipeline(
    createShaderModule(vertCode, &vertShaderModule);
    createShaderModule(fragCode, &fragShaderModule);
 
+   VkSpecializationInfo specializationInfo{};
+   specializationInfo.mapEntryCount =
+       static_cast<uint32_t>(configInfo.specializationEntries.size());
+   specializationInfo.pMapEntries =
+       configInfo.specializationEntries.data();
+   specializationInfo.dataSize = configInfo.specializationData.size();
+   specializationInfo.pData = configInfo.specializationData.data();
+   const VkSpecializationInfo* pSpecializationInfo =
+       configInfo.specializationEntries.empty() ? nullptr
+                                                : &specializationInfo;
+
    VkPipelineShaderStageCreateInfo shaderStages[2];
    shaderStages[0].sType =
        VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
@@ -69,7 +80,7 @@ void LvePipeline::createGraphicsPipeline(
    shaderStages[0].pName = "main";
    shaderStages[0].flags = 0;
    shaderStages[0].pNext = nullptr;
-   shaderStages[0].pSpecializationInfo = nullptr;
+   shaderStages[0].pSpecializationInfo = pSpecializationInfo;
 
    shaderStages[1].sType =
        VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
@@ -78,7 +89,7 @@ void LvePipeline::createGraphicsPipeline(
    shaderStages[1].pName = "main";
    shaderStages[1].flags = 0;
    shaderStages[1].pNext = nullptr;
-   shaderStages[1].pSpecializationInfo = nullptr;
+   shaderStages[1].pSpecializationInfo = pSpecializationInfo;
 
    auto& bindingDescriptions = configInfo.bindingDescriptions;
    auto& attributeDescriptions = configInfo.attributeDescriptions;
@@ -17,6 +17,9 @@ struct PipelineConfigInfo {
 
    std::vector<VkVertexInputBindingDescription> bindingDescriptions{};
    std::vector<VkVertexInputAttributeDescription> attributeDescriptions{};
+   // Specialization constants, shared by both shader stages.
+   std::vector<VkSpecializationMapEntry> specializationEntries{};
+   std::vector<char> specializationData{};
    VkPipelineViewportStateCreateInfo viewportInfo;
    VkPipelineInputAssemblyStateCreateInfo inputAssemblyInfo;
    VkPipelineRasterizationStateCreateInfo rasterizationInfo;
@@ -0,0 +1,128 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace lve {
+
+/**
+ * Rectangular grid of cells stored contiguously in row-major order, along
+ * with the metadata of the .asc it was read from.
+ */
+template <typename T>
+class Raster {
+  public:
+   /**
+    * Non-owning view over a contiguous run of cells, usually a row.
+    */
+   template <typename U>
+   class Span {
+     public:
+      Span(U *data, size_t size) : first{data}, count{size} {
+      }
+
+      U *begin() const {
+         return first;
+      }
+      U *end() const {
+         return first + count;
+      }
+      U *data() const {
+         return first;
+      }
+      size_t size() const {
+         return count;
+      }
+      U &operator[](size_t i) const {
+         return first[i];
+      }
+
+     private:
+      U *first;
+      size_t count;
+   };
+
+   Raster() = default;
+   Raster(uint32_t width, uint32_t height, const T &value = T{})
+       : xn{width},
+         yn{height},
+         cells(static_cast<size_t>(width) * height, value) {
+   }
+
+   uint32_t width() const {
+      return xn;
+   }
+   uint32_t height() const {
+      return yn;
+   }
+   size_t size() const {
+      return cells.size();
+   }
+   bool empty() const {
+      return cells.empty();
+   }
+
+   T *data() {
+      return cells.data();
+   }
+   const T *data() const {
+      return cells.data();
+   }
+   typename std::vector<T>::iterator begin() {
+      return cells.begin();
+   }
+   typename std::vector<T>::iterator end() {
+      return cells.end();
+   }
+   typename std::vector<T>::const_iterator begin() const {
+      return cells.begin();
+   }
+   typename std::vector<T>::const_iterator end() const {
+      return cells.end();
+   }
+
+   T &operator()(uint32_t x, uint32_t y) {
+      return cells[static_cast<size_t>(y) * xn + x];
+   }
+   const T &operator()(uint32_t x, uint32_t y) const {
+      return cells[static_cast<size_t>(y) * xn + x];
+   }
+
+   Span<T> row(uint32_t y) {
+      return {cells.data() + static_cast<size_t>(y) * xn, xn};
+   }
+   Span<const T> row(uint32_t y) const {
+      return {cells.data() + static_cast<size_t>(y) * xn, xn};
+   }
+
+   /**
+    * Bilinear interpolation between the four cells around (x, y), in cell
+    * coordinates. Positions outside the raster are clamped to its border.
+    */
+   T sample(float x, float y) const {
+      x = std::clamp(x, 0.f, static_cast<float>(xn - 1));
+      y = std::clamp(y, 0.f, static_cast<float>(yn - 1));
+      uint32_t x0 = static_cast<uint32_t>(x);
+      uint32_t y0 = static_cast<uint32_t>(y);
+      uint32_t x1 = std::min(x0 + 1, xn - 1);
+      uint32_t y1 = std::min(y0 + 1, yn - 1);
+      float fx = x - x0;
+      float fy = y - y0;
+      T top = (*this)(x0, y0) * (1.f - fx) + (*this)(x1, y0) * fx;
+      T bottom = (*this)(x0, y1) * (1.f - fx) + (*this)(x1, y1) * fx;
+      return top * (1.f - fy) + bottom * fy;
+   }
+
+   int cellsize = 1;
+   int32_t NODATA_value = -9999;
+
+  private:
+   uint32_t xn = 0;
+   uint32_t yn = 0;
+   std::vector<T> cells{};
+};
+
+}  // namespace lve
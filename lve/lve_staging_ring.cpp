@@ -0,0 +1,84 @@
+#include "lve_staging_ring.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace lve {
+
+LveStagingRing::LveStagingRing(LveDevice &device, VkDeviceSize size)
+    : lveDevice{device},
+      buffer{device, size, 1, VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+             VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
+                 VK_MEMORY_PROPERTY_HOST_COHERENT_BIT} {
+   buffer.map();
+}
+
+void LveStagingRing::copy(const void *data, VkDeviceSize size,
+                          VkBuffer dst, VkDeviceSize dstOffset) {
+   const char *bytes = static_cast<const char *>(data);
+   VkDeviceSize capacity = buffer.getBufferSize();
+   while (size) {
+      if (head == capacity) flush();
+      VkDeviceSize part = std::min(size, capacity - head);
+      std::memcpy(static_cast<char *>(buffer.getMappedMemory()) + head,
+                  bytes, part);
+      // Consecutive writes to the same buffer become one region.
+      if (!pending.empty() && pending.back().dst == dst &&
+          pending.back().region.srcOffset + pending.back().region.size ==
+              head &&
+          pending.back().region.dstOffset + pending.back().region.size ==
+              dstOffset) {
+         pending.back().region.size += part;
+      } else {
+         pending.push_back({dst, {head, dstOffset, part}});
+      }
+      head += part;
+      bytes += part;
+      dstOffset += part;
+      size -= part;
+   }
+}
+
+void LveStagingRing::flush() {
+   if (pending.empty()) {
+      head = 0;
+      return;
+   }
+   VkCommandBuffer commandBuffer = lveDevice.beginSingleTimeCommands();
+
+   // Frames still in flight may be reading what is overwritten.
+   vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+                        VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0,
+                        nullptr, 0, nullptr);
+
+   // Runs of copies to the same buffer go in a single command.
+   std::vector<VkBufferCopy> regions;
+   for (size_t i = 0; i < pending.size();) {
+      size_t j = i;
+      regions.clear();
+      for (; j < pending.size() && pending[j].dst == pending[i].dst; ++j) {
+         regions.push_back(pending[j].region);
+      }
+      vkCmdCopyBuffer(commandBuffer, buffer.getBuffer(), pending[i].dst,
+                      static_cast<uint32_t>(regions.size()),
+                      regions.data());
+      i = j;
+   }
+
+   VkMemoryBarrier barrier{};
+   barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+   barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+   barrier.dstAccessMask = VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT |
+                           VK_ACCESS_INDEX_READ_BIT |
+                           VK_ACCESS_SHADER_READ_BIT |
+                           VK_ACCESS_INDIRECT_COMMAND_READ_BIT;
+   vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT,
+                        VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, 0, 1, &barrier,
+                        0, nullptr, 0, nullptr);
+
+   lveDevice.endSingleTimeCommands(commandBuffer);
+   pending.clear();
+   head = 0;
+}
+
+}  // namespace lve
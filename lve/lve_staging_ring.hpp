@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "lve_buffer.hpp"
+#include "lve_device.hpp"
+
+namespace lve {
+
+/**
+ * Persistently mapped host buffer that carries small uploads to device
+ * local buffers. Copies are written one after the other and recorded
+ * together by flush, so a batch of scattered writes costs one submit and
+ * no allocation. When the ring fills up, the queued copies are flushed
+ * and writing starts over from its beginning.
+ */
+class LveStagingRing {
+  public:
+   static constexpr VkDeviceSize defaultSize = 4 << 20;
+
+   LveStagingRing(LveDevice &device, VkDeviceSize size = defaultSize);
+
+   LveStagingRing(const LveStagingRing &) = delete;
+   LveStagingRing &operator=(const LveStagingRing &) = delete;
+
+   /**
+    * Queues a copy of size bytes from data to dst at dstOffset. Copies
+    * larger than the ring are split.
+    */
+   void copy(const void *data, VkDeviceSize size, VkBuffer dst,
+             VkDeviceSize dstOffset);
+
+   /**
+    * Submits the queued copies and waits for them. The copies wait for
+    * the work already submitted, and later vertex, index, shader and
+    * indirect reads see their result.
+    */
+   void flush();
+
+  private:
+   struct Copy {
+      VkBuffer dst;
+      VkBufferCopy region;
+   };
+
+   LveDevice &lveDevice;
+   LveBuffer buffer;
+   VkDeviceSize head = 0;
+   std::vector<Copy> pending;
+};
+
+}  // namespace lve
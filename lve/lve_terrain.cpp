@@ -3,14 +3,22 @@
 #include <strings.h>
 #include <vulkan/vulkan_core.h>
 
+#include <algorithm>
+#include <cmath>
 #include <cstddef>
 #include <cstdint>
 #include <glm/ext/vector_float3.hpp>
 #include <glm/geometric.hpp>
 #include <memory>
+#include <stdexcept>
+#include <unordered_map>
 #include <vector>
 
 #include "lve_buffer.hpp"
+#include "lve_terrain_chunks.hpp"
+#include "lve_terrain_normals.hpp"
+#include "lve_terrain_tin.hpp"
+#include "lve_utils.hpp"
 
 #define GLM_ENABLE_EXPERIMENTAL
 #include <cassert>
@@ -18,52 +26,273 @@
 
 namespace lve {
 
+namespace {
+
+// Octahedral encoding; the shader normalizes.
+glm::i16vec2 encodeNormal(const glm::vec3 &normal) {
+   float l1 =
+       std::fabs(normal.x) + std::fabs(normal.y) + std::fabs(normal.z);
+   if (l1 == 0.f) return {0, 0};
+   float u = normal.x / l1;
+   float v = normal.y / l1;
+   if (normal.z < 0.f) {
+      float fu = (1.f - std::fabs(v)) * (u >= 0.f ? 1.f : -1.f);
+      float fv = (1.f - std::fabs(u)) * (v >= 0.f ? 1.f : -1.f);
+      u = fu;
+      v = fv;
+   }
+   return {static_cast<glm::int16>(std::lround(u * 32767.f)),
+           static_cast<glm::int16>(std::lround(v * 32767.f))};
+}
+
+glm::u8vec4 encodeColor(const glm::vec3 &color) {
+   auto unorm8 = [](float c) {
+      return static_cast<glm::uint8>(
+          std::lround(std::clamp(c, 0.f, 1.f) * 255.f));
+   };
+   return {unorm8(color.x), unorm8(color.y), unorm8(color.z), 255};
+}
+
+LveTerrain::Vertex packFull(float alttitude, const glm::vec3 &color,
+                            const glm::vec3 &normal) {
+   return LveTerrain::Vertex{
+       .alttitude = alttitude, .color = color, .normal = normal};
+}
+
+// The altitude as a 16-bit unorm of step units past offset.
+struct PackCompact16 {
+   float offset;
+   float step;
+
+   LveTerrain::CompactVertex16 operator()(float alttitude,
+                                          const glm::vec3 &color,
+                                          const glm::vec3 &normal) const {
+      float stored = std::clamp(std::round((alttitude - offset) * step),
+                                0.f, 65535.f);
+      return LveTerrain::CompactVertex16{
+          .alttitude = static_cast<glm::uint16>(stored),
+          .normal = encodeNormal(normal),
+          .color = encodeColor(color)};
+   }
+};
+
+LveTerrain::CompactVertex32 packCompact32(float alttitude,
+                                          const glm::vec3 &color,
+                                          const glm::vec3 &normal) {
+   return LveTerrain::CompactVertex32{.alttitude = alttitude,
+                                      .normal = encodeNormal(normal),
+                                      .color = encodeColor(color)};
+}
+
+// Columns x0 <= x < x1 of row y, x reversed. normals is scratch space.
+template <typename V, typename Pack>
+void packRow(V *out, const Raster<glm::float32> &alttitudeMap,
+             const Raster<glm::vec3> &colorMap, uint32_t y, uint32_t x0,
+             uint32_t x1, std::vector<glm::vec3> &normals, Pack pack) {
+   uint32_t yn = alttitudeMap.height();
+   uint32_t xn = alttitudeMap.width();
+   uint32_t ys = y == yn - 1 ? y : y + 1;
+   uint32_t ya = y == 0 ? y : y - 1;
+   Raster<glm::float32>::Span<const glm::float32> row =
+       alttitudeMap.row(y);
+   Raster<glm::vec3>::Span<const glm::vec3> colors = colorMap.row(y);
+   terrainRowNormals(row.data(), alttitudeMap.row(ys).data(),
+                     alttitudeMap.row(ya).data(), y, ys, ya, xn,
+                     normals.data(), x0, x1);
+   for (uint32_t x = x1; x-- > x0;) {
+      *out++ = pack(-row[x], colors[x], normals[x]);
+   }
+}
+
+template <typename V, typename Pack>
+void buildVertices(std::vector<V> &vertices,
+                   const Raster<glm::float32> &alttitudeMap,
+                   const Raster<glm::vec3> &colorMap, unsigned threads,
+                   Pack pack) {
+   uint32_t yn = alttitudeMap.height();
+   uint32_t xn = alttitudeMap.width();
+   vertices.resize(static_cast<size_t>(xn) * yn);
+
+   parallelFor(yn, threads, [&](size_t first, size_t last) {
+      std::vector<glm::vec3> normals(xn);
+      for (uint32_t y = first; y < last; ++y) {
+         packRow(vertices.data() + static_cast<size_t>(y) * xn,
+                 alttitudeMap, colorMap, y, 0, xn, normals, pack);
+      }
+   });
+}
+
+// Classes of vertices 2w and 2w + 1, the first in the low half.
+template <typename ClassOf>
+glm::uint32 vegetationWord(const Raster<glm::int32> &vegetationMap,
+                           ClassOf &&classOf, size_t w) {
+   size_t xn = vegetationMap.width();
+   size_t cells = vegetationMap.size();
+   glm::uint32 word = 0;
+   for (size_t i = 2 * w; i < std::min(2 * w + 2, cells); ++i) {
+      word |= classOf(vegetationMap(xn - 1 - i % xn, i / xn))
+              << (16 * (i % 2));
+   }
+   return word;
+}
+
+LveTerrain::Region clipRegion(const LveTerrain::Region &region,
+                              uint32_t border, uint32_t width,
+                              uint32_t height) {
+   LveTerrain::Region clipped{
+       .x0 = region.x0 > border ? region.x0 - border : 0,
+       .y0 = region.y0 > border ? region.y0 - border : 0,
+       .x1 = std::min(std::min(region.x1, width) + border, width),
+       .y1 = std::min(std::min(region.y1, height) + border, height),
+   };
+   if (region.x0 >= std::min(region.x1, width) ||
+       region.y0 >= std::min(region.y1, height)) {
+      return {};
+   }
+   return clipped;
+}
+
+template <typename V>
+std::vector<VkVertexInputBindingDescription> bindingDescriptions() {
+   std::vector<VkVertexInputBindingDescription> bindingDescriptions(1);
+   bindingDescriptions[0].binding = 0;
+   bindingDescriptions[0].stride = sizeof(V);
+   bindingDescriptions[0].inputRate = VK_VERTEX_INPUT_RATE_VERTEX;
+   return bindingDescriptions;
+}
+
+// maxError in metres.
+TerrainChunks buildChunks(const Raster<glm::float32> &alttitudeMap,
+                          glm::float32 maxError,
+                          std::vector<uint32_t> &indices,
+                          unsigned threads) {
+   TerrainChunks chunks;
+   if (maxError > 0.f) {
+      // One cell unit of altitude is cellsize metres.
+      glm::float32 cellsize =
+          static_cast<glm::float32>(std::max(alttitudeMap.cellsize, 1));
+      chunks = simplifyTerrain(alttitudeMap, maxError / cellsize,
+                               indices, threads);
+      chunks.optimizeIndices(indices, threads);
+   } else {
+      chunks = TerrainChunks(alttitudeMap.width(), alttitudeMap.height(),
+                             indices, threads);
+   }
+   return chunks;
+}
+
+}  // namespace
+
 LveTerrain::LveTerrain(LveDevice &device,
                        const LveTerrain::Builder &builder)
-    : lveDevice{device} {
-   createVertexBuffers(builder.vertices);
+    : lveDevice{device},
+      format{builder.format},
+      width{builder.width},
+      height{builder.height},
+      simplified{builder.maxError > 0.f},
+      chunks{builder.chunks} {
+   static id_t currentId = 0;
+   id = currentId++;
+   switch (format) {
+      case VertexFormat::Full:
+         createVertexBuffers(builder.vertices);
+         break;
+      case VertexFormat::Compact16:
+         createVertexBuffers(builder.compactVertices16);
+         break;
+      case VertexFormat::Compact32:
+         createVertexBuffers(builder.compactVertices32);
+         break;
+      case VertexFormat::Raster: {
+         if (builder.palette.size() < builder.vegetationTypes.size() ||
+             builder.palette.size() > maxVegetationClasses) {
+            throw std::runtime_error(
+                "terrain palette doesn't match the vegetation types");
+         }
+         vertexCount = static_cast<uint32_t>(builder.alttitudes.size());
+         alttitudeBuffer = createDeviceBuffer(
+             builder.alttitudes, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT);
+         vegetationBuffer = createDeviceBuffer(
+             builder.vegetation, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT);
+         // Sized for every class, so update never has to move it.
+         std::vector<glm::vec4> palette(maxVegetationClasses);
+         std::copy(builder.palette.begin(), builder.palette.end(),
+                   palette.begin());
+         paletteBuffer = createDeviceBuffer(
+             palette, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT);
+         vegetationTypes = builder.vegetationTypes;
+         for (size_t i = 0; i < vegetationTypes.size(); ++i) {
+            vegetationClasses[vegetationTypes[i]] =
+                static_cast<glm::uint32>(i);
+         }
+         break;
+      }
+   }
    createIndexBuffers(builder.indices);
+   if (hasIndexBuffer) {
+      std::vector<TerrainChunks::Range> gpuRanges;
+      chunks.gpuTables(gpuChunks, gpuRanges);
+      chunkBuffer = createDeviceBuffer(gpuChunks,
+                                       VK_BUFFER_USAGE_STORAGE_BUFFER_BIT);
+      chunkRangeBuffer = createDeviceBuffer(
+          gpuRanges, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT);
+   }
+   altitudeMatrix[1][1] = builder.alttitudeScale;
+   altitudeMatrix[3][1] = builder.alttitudeOffset;
 }
 
 LveTerrain::~LveTerrain() {
 }
 
 std::unique_ptr<LveTerrain> LveTerrain::createModelFromMesh(
-    LveDevice &device,
-    const std::vector<std::vector<glm::float32>> &alttitudeMap,
-    const std::vector<std::vector<glm::vec3>> &colorMap) {
+    LveDevice &device, const Raster<glm::float32> &alttitudeMap,
+    const Raster<glm::vec3> &colorMap, unsigned threads,
+    VertexFormat format) {
    Builder builder{};
-   builder.generateMesh(alttitudeMap, colorMap);
+   builder.format = format;
+   builder.generateMesh(alttitudeMap, colorMap, threads);
 
    return std::make_unique<LveTerrain>(device, builder);
 }
 
-void LveTerrain::createVertexBuffers(const std::vector<Vertex> &vertices) {
-   vertexCount = static_cast<uint32_t>(vertices.size());
-   assert(vertexCount >= 3 && "Vertex count must be at least 3");
-   VkDeviceSize bufferSize = sizeof(vertices[0]) * vertexCount;
-   uint32_t vertexSize = sizeof(vertices[0]);
+template <typename T>
+std::unique_ptr<LveBuffer> LveTerrain::createDeviceBuffer(
+    const std::vector<T> &data, VkBufferUsageFlags usageFlags) {
+   // Vulkan doesn't allow empty buffers.
+   uint32_t count = std::max<size_t>(data.size(), 1);
+   VkDeviceSize bufferSize = sizeof(T) * data.size();
+   uint32_t size = sizeof(T);
+
+   std::unique_ptr<LveBuffer> buffer = std::make_unique<LveBuffer>(
+       lveDevice, size, count,
+       usageFlags | VK_BUFFER_USAGE_TRANSFER_DST_BIT |
+           VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+       VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+   if (!bufferSize) return buffer;
 
    LveBuffer stagingBuffer{
        lveDevice,
-       vertexSize,
-       vertexCount,
+       size,
+       count,
        VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
            VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
    };
 
    stagingBuffer.map();
-   stagingBuffer.writeToBuffer((void *)vertices.data());
+   stagingBuffer.writeToBuffer((void *)data.data(), bufferSize);
 
-   vertexBuffer =
-       std::make_unique<LveBuffer>(lveDevice, vertexSize, vertexCount,
-                                   VK_BUFFER_USAGE_VERTEX_BUFFER_BIT |
-                                       VK_BUFFER_USAGE_TRANSFER_DST_BIT,
-                                   VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+   lveDevice.copyBuffer(stagingBuffer.getBuffer(), buffer->getBuffer(),
+                        bufferSize);
+   return buffer;
+}
 
-   lveDevice.copyBuffer(stagingBuffer.getBuffer(),
-                        vertexBuffer->getBuffer(), bufferSize);
+template <typename V>
+void LveTerrain::createVertexBuffers(const std::vector<V> &vertices) {
+   vertexCount = static_cast<uint32_t>(vertices.size());
+   assert(vertexCount >= 3 && "Vertex count must be at least 3");
+   vertexBuffer =
+       createDeviceBuffer(vertices, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT);
 }
 
 void LveTerrain::createIndexBuffers(const std::vector<uint32_t> &indices) {
@@ -72,56 +301,285 @@ void LveTerrain::createIndexBuffers(const std::vector<uint32_t> &indices) {
 
    if (!hasIndexBuffer) return;
 
-   VkDeviceSize bufferSize = sizeof(indices[0]) * indexCount;
-   uint32_t indexSize = sizeof(indices[0]);
+   // Indices address the whole grid.
+   indexType = indexTypeFor(indices);
+   if (indexType == VK_INDEX_TYPE_UINT16) {
+      std::vector<uint16_t> narrow(indices.begin(), indices.end());
+      indexBuffer =
+          createDeviceBuffer(narrow, VK_BUFFER_USAGE_INDEX_BUFFER_BIT);
+   } else {
+      indexBuffer =
+          createDeviceBuffer(indices, VK_BUFFER_USAGE_INDEX_BUFFER_BIT);
+   }
+}
 
-   LveBuffer stagingBuffer{
-       lveDevice,
-       indexSize,
-       indexCount,
-       VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
-       VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
-           VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+void LveTerrain::setPalette(const std::vector<glm::vec4> &palette) {
+   assert(format == VertexFormat::Raster &&
+          "Only the Raster format has a palette");
+   if (palette.size() > maxVegetationClasses) {
+      throw std::runtime_error("terrain palette is too large");
+   }
+   VkDeviceSize bufferSize = sizeof(glm::vec4) * palette.size();
+   if (!bufferSize) return;
+
+   // Written in place, so the descriptors keep pointing to it.
+   stagingRing().copy(palette.data(), bufferSize,
+                      paletteBuffer->getBuffer(), 0);
+   stagingRing().flush();
+}
+
+LveStagingRing &LveTerrain::stagingRing() {
+   if (!ring) ring = std::make_unique<LveStagingRing>(lveDevice);
+   return *ring;
+}
+
+void LveTerrain::checkSize(uint32_t mapWidth, uint32_t mapHeight) const {
+   if (mapWidth != width || mapHeight != height) {
+      throw std::runtime_error("terrain update maps differ in size");
+   }
+}
+
+template <typename V, typename Pack>
+void LveTerrain::updateVertices(const Raster<glm::float32> &alttitudeMap,
+                                const Raster<glm::vec3> &colorMap,
+                                const Region &region, Pack pack) {
+   std::vector<V> row(region.x1 - region.x0);
+   std::vector<glm::vec3> normals(width);
+   for (uint32_t y = region.y0; y < region.y1; ++y) {
+      packRow(row.data(), alttitudeMap, colorMap, y, region.x0,
+              region.x1, normals, pack);
+      // Map columns x0..x1 - 1 are vertices xn - x1..xn - 1 - x0.
+      size_t first = static_cast<size_t>(y) * width + width - region.x1;
+      stagingRing().copy(row.data(), sizeof(V) * row.size(),
+                         vertexBuffer->getBuffer(), sizeof(V) * first);
+   }
+}
+
+void LveTerrain::updateBounds(const Raster<glm::float32> &alttitudeMap,
+                              const Region &region) {
+   // Quantised altitudes may land half a step off, as when built.
+   glm::float32 padding = format == VertexFormat::Compact16
+                              ? altitudeMatrix[1][1] / 65535.f
+                              : 0.f;
+   std::vector<size_t> changed =
+       chunks.setBounds(alttitudeMap, padding, width - region.x1,
+                        width - 1 - region.x0, region.y0, region.y1 - 1);
+   if (!chunkBuffer) return;
+   for (size_t i : changed) {
+      const TerrainChunks::Chunk &chunk = chunks.getChunks()[i];
+      gpuChunks[i].lo.y = chunk.minAlttitude;
+      gpuChunks[i].hi.y = chunk.maxAlttitude;
+      stagingRing().copy(&gpuChunks[i], sizeof(TerrainChunks::GpuChunk),
+                         chunkBuffer->getBuffer(),
+                         sizeof(TerrainChunks::GpuChunk) * i);
+   }
+}
+
+void LveTerrain::update(const Raster<glm::float32> &alttitudeMap,
+                        const Raster<glm::vec3> &colorMap,
+                        const Region &region) {
+   if (format == VertexFormat::Raster) {
+      throw std::runtime_error(
+          "the Raster terrain format is updated from the vegetation map");
+   }
+   if (simplified) {
+      throw std::runtime_error(
+          "the altitudes of a simplified terrain can't be updated");
+   }
+   checkSize(alttitudeMap.width(), alttitudeMap.height());
+   checkSize(colorMap.width(), colorMap.height());
+   Region edited = clipRegion(region, 0, width, height);
+   if (edited.x0 == edited.x1) return;
+   // The normals of the cells around the edit read it.
+   Region rewritten = clipRegion(region, 1, width, height);
+
+   switch (format) {
+      case VertexFormat::Full:
+         updateVertices<Vertex>(alttitudeMap, colorMap, rewritten,
+                                packFull);
+         break;
+      case VertexFormat::Compact16: {
+         float offset = altitudeMatrix[3][1];
+         float scale = altitudeMatrix[1][1];
+         for (uint32_t y = edited.y0; y < edited.y1; ++y) {
+            const glm::float32 *row = alttitudeMap.row(y).data();
+            auto [lo, hi] =
+                std::minmax_element(row + edited.x0, row + edited.x1);
+            if (-*hi < offset || -*lo > offset + scale) {
+               throw std::runtime_error(
+                   "terrain update leaves the Compact16 altitude range");
+            }
+         }
+         updateVertices<CompactVertex16>(
+             alttitudeMap, colorMap, rewritten,
+             PackCompact16{.offset = offset, .step = 65535.f / scale});
+         break;
+      }
+      case VertexFormat::Compact32:
+         updateVertices<CompactVertex32>(alttitudeMap, colorMap,
+                                         rewritten, packCompact32);
+         break;
+      case VertexFormat::Raster:
+         break;
+   }
+   updateBounds(alttitudeMap, edited);
+   stagingRing().flush();
+}
+
+void LveTerrain::updateVegetation(const Raster<glm::int32> &vegetationMap,
+                                  const Region &region) {
+   // Every word is built before anything changes.
+   std::unordered_map<glm::int32, glm::uint32> added;
+   auto classOf = [&](glm::int32 type) {
+      auto found = vegetationClasses.find(type);
+      if (found != vegetationClasses.end()) return found->second;
+      auto [next, inserted] = added.try_emplace(
+          type,
+          static_cast<glm::uint32>(vegetationTypes.size() + added.size()));
+      if (next->second >= maxVegetationClasses) {
+         throw std::runtime_error("too many vegetation types");
+      }
+      return next->second;
    };
+   std::vector<std::vector<glm::uint32>> words(region.y1 - region.y0);
+   for (uint32_t y = region.y0; y < region.y1; ++y) {
+      size_t first = static_cast<size_t>(y) * width + width - region.x1;
+      size_t last = static_cast<size_t>(y) * width + width - region.x0;
+      for (size_t w = first / 2; w < (last + 1) / 2; ++w) {
+         words[y - region.y0].push_back(
+             vegetationWord(vegetationMap, classOf, w));
+      }
+   }
 
-   stagingBuffer.map();
-   stagingBuffer.writeToBuffer((void *)indices.data());
+   vegetationTypes.resize(vegetationTypes.size() + added.size());
+   for (const auto &[type, vegetationClass] : added) {
+      vegetationClasses[type] = vegetationClass;
+      vegetationTypes[vegetationClass] = type;
+   }
+   for (uint32_t y = region.y0; y < region.y1; ++y) {
+      size_t first = static_cast<size_t>(y) * width + width - region.x1;
+      const std::vector<glm::uint32> &row_words = words[y - region.y0];
+      stagingRing().copy(row_words.data(),
+                         sizeof(glm::uint32) * row_words.size(),
+                         vegetationBuffer->getBuffer(),
+                         sizeof(glm::uint32) * (first / 2));
+   }
+}
 
-   indexBuffer = std::make_unique<LveBuffer>(
-       lveDevice, indexSize, indexCount,
-       VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
-       VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+void LveTerrain::update(const Raster<glm::float32> &alttitudeMap,
+                        const Raster<glm::int32> &vegetationMap,
+                        const Region &region) {
+   if (format != VertexFormat::Raster) {
+      throw std::runtime_error(
+          "only the Raster terrain format has a vegetation map");
+   }
+   if (simplified) {
+      throw std::runtime_error(
+          "the altitudes of a simplified terrain can't be updated");
+   }
+   checkSize(alttitudeMap.width(), alttitudeMap.height());
+   checkSize(vegetationMap.width(), vegetationMap.height());
+   Region edited = clipRegion(region, 0, width, height);
+   if (edited.x0 == edited.x1) return;
+
+   updateVegetation(vegetationMap, edited);
+   std::vector<glm::float32> alttitudes(edited.x1 - edited.x0);
+   for (uint32_t y = edited.y0; y < edited.y1; ++y) {
+      const glm::float32 *row = alttitudeMap.row(y).data();
+      for (uint32_t x = edited.x1, i = 0; x-- > edited.x0; ++i) {
+         alttitudes[i] = -row[x];
+      }
+      size_t first = static_cast<size_t>(y) * width + width - edited.x1;
+      stagingRing().copy(alttitudes.data(),
+                         sizeof(glm::float32) * alttitudes.size(),
+                         alttitudeBuffer->getBuffer(),
+                         sizeof(glm::float32) * first);
+   }
+   updateBounds(alttitudeMap, edited);
+   stagingRing().flush();
+}
 
-   lveDevice.copyBuffer(stagingBuffer.getBuffer(),
-                        indexBuffer->getBuffer(), bufferSize);
+void LveTerrain::update(const Raster<glm::int32> &vegetationMap,
+                        const Region &region) {
+   if (format != VertexFormat::Raster) {
+      throw std::runtime_error(
+          "only the Raster terrain format has a vegetation map");
+   }
+   checkSize(vegetationMap.width(), vegetationMap.height());
+   Region edited = clipRegion(region, 0, width, height);
+   if (edited.x0 == edited.x1) return;
+
+   updateVegetation(vegetationMap, edited);
+   stagingRing().flush();
+}
+
+VkDescriptorBufferInfo LveTerrain::vertexInfo() {
+   return vertexBuffer->descriptorInfo();
 }
 
-void LveTerrain::draw(VkCommandBuffer commandBuffer) {
+VkDescriptorBufferInfo LveTerrain::alttitudeInfo() {
+   return alttitudeBuffer->descriptorInfo();
+}
+
+VkDescriptorBufferInfo LveTerrain::vegetationInfo() {
+   return vegetationBuffer->descriptorInfo();
+}
+
+VkDescriptorBufferInfo LveTerrain::paletteInfo() {
+   return paletteBuffer->descriptorInfo();
+}
+
+VkDescriptorBufferInfo LveTerrain::chunkInfo() {
+   return chunkBuffer->descriptorInfo();
+}
+
+VkDescriptorBufferInfo LveTerrain::chunkRangeInfo() {
+   return chunkRangeBuffer->descriptorInfo();
+}
+
+void LveTerrain::draw(VkCommandBuffer commandBuffer,
+                      const glm::vec3 &viewer,
+                      const glm::mat4 &projectionView, float lodDistance) {
    if (hasIndexBuffer) {
-      vkCmdDrawIndexed(commandBuffer, indexCount, 1, 0, 0, 0);
+      chunks.cull(projectionView, visible);
+      chunks.selectLevels(viewer, lodDistance, levels);
+      ranges.clear();
+      chunks.drawRanges(levels, visible, ranges);
+      for (const TerrainChunks::Range &range : ranges) {
+         vkCmdDrawIndexed(commandBuffer, range.count, 1, range.first, 0,
+                          0);
+      }
    } else {
       vkCmdDraw(commandBuffer, vertexCount, 1, 0, 0);
    }
 }
 
+void LveTerrain::drawIndirect(VkCommandBuffer commandBuffer,
+                              VkBuffer drawBuffer) {
+   if (!hasIndexBuffer) return;
+   vkCmdDrawIndexedIndirect(
+       commandBuffer, drawBuffer, 0,
+       TerrainChunks::gpuDrawsPerChunk *
+           static_cast<uint32_t>(chunks.getChunks().size()),
+       sizeof(VkDrawIndexedIndirectCommand));
+}
+
 void LveTerrain::bind(VkCommandBuffer commandBuffer) {
-   VkBuffer buffers[] = {vertexBuffer->getBuffer()};
-   VkDeviceSize offsets[] = {0};
-   vkCmdBindVertexBuffers(commandBuffer, 0, 1, buffers, offsets);
+   if (vertexBuffer) {
+      VkBuffer buffers[] = {vertexBuffer->getBuffer()};
+      VkDeviceSize offsets[] = {0};
+      vkCmdBindVertexBuffers(commandBuffer, 0, 1, buffers, offsets);
+   }
 
    if (hasIndexBuffer) {
       vkCmdBindIndexBuffer(commandBuffer, indexBuffer->getBuffer(), 0,
-                           VK_INDEX_TYPE_UINT32);
+                           indexType);
    }
 }
 
 std::vector<VkVertexInputBindingDescription>
 LveTerrain::Vertex::getBindingDescriptions() {
-   std::vector<VkVertexInputBindingDescription> bindingDescriptions(1);
-   bindingDescriptions[0].binding = 0;
-   bindingDescriptions[0].stride = sizeof(Vertex);
-   bindingDescriptions[0].inputRate = VK_VERTEX_INPUT_RATE_VERTEX;
-   return bindingDescriptions;
+   return bindingDescriptions<Vertex>();
 }
 
 std::vector<VkVertexInputAttributeDescription>
@@ -138,63 +596,140 @@ LveTerrain::Vertex::getAttributeDescriptions() {
    return attributeDescriptions;
 }
 
+std::vector<VkVertexInputBindingDescription>
+LveTerrain::CompactVertex16::getBindingDescriptions() {
+   return bindingDescriptions<CompactVertex16>();
+}
+
+std::vector<VkVertexInputAttributeDescription>
+LveTerrain::CompactVertex16::getAttributeDescriptions() {
+   std::vector<VkVertexInputAttributeDescription> attributeDescriptions{};
+
+   attributeDescriptions.push_back(
+       {0, 0, VK_FORMAT_R16_UNORM, offsetof(CompactVertex16, alttitude)});
+   attributeDescriptions.push_back(
+       {1, 0, VK_FORMAT_R8G8B8A8_UNORM, offsetof(CompactVertex16, color)});
+   attributeDescriptions.push_back(
+       {2, 0, VK_FORMAT_R16G16_SNORM, offsetof(CompactVertex16, normal)});
+
+   return attributeDescriptions;
+}
+
+std::vector<VkVertexInputBindingDescription>
+LveTerrain::CompactVertex32::getBindingDescriptions() {
+   return bindingDescriptions<CompactVertex32>();
+}
+
+std::vector<VkVertexInputAttributeDescription>
+LveTerrain::CompactVertex32::getAttributeDescriptions() {
+   std::vector<VkVertexInputAttributeDescription> attributeDescriptions{};
+
+   attributeDescriptions.push_back(
+       {0, 0, VK_FORMAT_R32_SFLOAT, offsetof(CompactVertex32, alttitude)});
+   attributeDescriptions.push_back(
+       {1, 0, VK_FORMAT_R8G8B8A8_UNORM, offsetof(CompactVertex32, color)});
+   attributeDescriptions.push_back(
+       {2, 0, VK_FORMAT_R16G16_SNORM, offsetof(CompactVertex32, normal)});
+
+   return attributeDescriptions;
+}
+
 void LveTerrain::Builder::generateMesh(
-    const std::vector<std::vector<glm::float32>> &alttitudeMap,
-    const std::vector<std::vector<glm::vec3>> &colorMap) {
-   vertices.clear();
-   indices.clear();
+    const Raster<glm::float32> &alttitudeMap,
+    const Raster<glm::vec3> &colorMap, unsigned threads) {
+   if (format == VertexFormat::Raster) {
+      throw std::runtime_error(
+          "the Raster terrain format is built by generateRaster");
+   }
+   *this = Builder{.format = format, .maxError = maxError};
 
-   uint32_t yn = alttitudeMap.size();
+   uint32_t yn = alttitudeMap.height();
    if (!yn) return;
-   uint32_t xn = alttitudeMap[0].size();
+   uint32_t xn = alttitudeMap.width();
    if (!xn) return;
-   uint32_t total_verts = yn + (xn - 1) * (2 * yn - 2);
-   uint32_t n = 4 * xn - 2;
-
-   for (int y = 0; y < yn; ++y) {
-      for (int x = xn - 1; x >= 0; --x) {
-         uint32_t xs = x == xn - 1 ? x : x + 1;
-         uint32_t xa = x == 0 ? x : x - 1;
-         uint32_t ys = y == yn - 1 ? y : y + 1;
-         uint32_t ya = y == 0 ? y : y - 1;
-
-         glm::vec3 x_y = {x, y, alttitudeMap[y][x]};
-         glm::vec3 xs_y = {xs, y, alttitudeMap[y][xs]};
-         glm::vec3 xa_y = {xa, y, alttitudeMap[y][xa]};
-         glm::vec3 x_ys = {x, ys, alttitudeMap[ys][x]};
-         glm::vec3 x_ya = {x, ya, alttitudeMap[ya][x]};
-
-         glm::vec3 x_a = x_y - x_ys;
-         glm::vec3 x_b = x_y - xs_y;
-         glm::vec3 x_c = x_y - x_ya;
-         glm::vec3 x_d = x_y - xa_y;
-
-         glm::vec3 n1 = glm::cross(x_a, x_b);
-         glm::vec3 n2 = glm::cross(x_b, x_c);
-         glm::vec3 n3 = glm::cross(x_c, x_d);
-         glm::vec3 n4 = glm::cross(x_d, x_a);
-
-         glm::vec3 normal = (n1 + n2 + n3 + n4) / 4.f;
-
-         Vertex vertex = {.alttitude = -alttitudeMap[y][x],
-                          .color = colorMap[y][x],
-                          .normal = normal};
-
-         vertices.push_back(vertex);
+   width = xn;
+   height = yn;
+
+   switch (format) {
+      case VertexFormat::Full:
+         buildVertices(vertices, alttitudeMap, colorMap, threads,
+                       packFull);
+         break;
+      case VertexFormat::Compact16: {
+         // The vertex altitude is -height, so the range is [-max, -min].
+         const glm::float32 *cells = alttitudeMap.data();
+         auto [lo, hi] =
+             std::minmax_element(cells, cells + alttitudeMap.size());
+         alttitudeOffset = -*hi;
+         alttitudeScale = *hi > *lo ? *hi - *lo : 1.f;
+         buildVertices(compactVertices16, alttitudeMap, colorMap, threads,
+                       PackCompact16{.offset = alttitudeOffset,
+                                     .step = 65535.f / alttitudeScale});
+         break;
       }
+      case VertexFormat::Compact32:
+         buildVertices(compactVertices32, alttitudeMap, colorMap, threads,
+                       packCompact32);
+         break;
+      case VertexFormat::Raster:
+         break;
    }
+   chunks = buildChunks(alttitudeMap, maxError, indices, threads);
+   // Quantised altitudes may land half a step off.
+   glm::float32 padding = format == VertexFormat::Compact16
+                              ? alttitudeScale / 65535.f
+                              : 0.f;
+   chunks.setBounds(alttitudeMap, padding, threads);
+}
 
-   for (uint32_t i = 0; i < total_verts; ++i) {
-      uint32_t r = i % n;
-      uint32_t c = r / 2;
-      uint32_t d = (c / xn) % 2;
-      uint32_t s = 1 - 2 * d;
-
-      uint32_t y = s * (i % 2) + (c / xn) * 2 + (i / n) * 2;
-      uint32_t x = d * (xn - 1) + s * (((r + d) / 2) % xn);
+void LveTerrain::Builder::generateRaster(
+    const Raster<glm::float32> &alttitudeMap,
+    const Raster<glm::int32> &vegetationMap, unsigned threads) {
+   if (alttitudeMap.width() != vegetationMap.width() ||
+       alttitudeMap.height() != vegetationMap.height()) {
+      throw std::runtime_error(
+          "altitude and vegetation maps differ in size");
+   }
+   *this = Builder{.format = VertexFormat::Raster, .maxError = maxError};
 
-      uint32_t index = x + y * xn;
-      indices.push_back(index);
+   uint32_t yn = alttitudeMap.height();
+   if (!yn) return;
+   uint32_t xn = alttitudeMap.width();
+   if (!xn) return;
+   width = xn;
+   height = yn;
+
+   std::unordered_map<glm::int32, glm::uint32> classes;
+   glm::int32 last = 0;
+   for (size_t i = 0; i < vegetationMap.size(); ++i) {
+      glm::int32 type = vegetationMap.data()[i];
+      if (i && type == last) continue;
+      last = type;
+      if (classes.count(type)) continue;
+      classes[type] = static_cast<glm::uint32>(vegetationTypes.size());
+      vegetationTypes.push_back(type);
+   }
+   if (vegetationTypes.size() > 0x10000) {
+      throw std::runtime_error("too many vegetation types");
    }
+
+   // Two classes per word, so each worker fills whole words.
+   size_t cells = static_cast<size_t>(xn) * yn;
+   alttitudes.resize(cells);
+   vegetation.resize((cells + 1) / 2);
+   parallelFor((cells + 1) / 2, threads, [&](size_t first, size_t last) {
+      for (size_t w = first; w < last; ++w) {
+         for (size_t i = 2 * w; i < std::min(2 * w + 2, cells); ++i) {
+            alttitudes[i] = -alttitudeMap(xn - 1 - i % xn, i / xn);
+         }
+         vegetation[w] = vegetationWord(
+             vegetationMap,
+             [&classes](glm::int32 type) { return classes.at(type); }, w);
+      }
+   });
+
+   chunks = buildChunks(alttitudeMap, maxError, indices, threads);
+   chunks.setBounds(alttitudeMap, 0.f, threads);
 }
+
 }  // namespace lve
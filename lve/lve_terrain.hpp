@@ -1,11 +1,16 @@
 #pragma once
 
+#include <cstddef>
 #include <glm/fwd.hpp>
 #include <memory>
+#include <unordered_map>
 #include <vector>
 
 #include "lve_buffer.hpp"
 #include "lve_device.hpp"
+#include "lve_raster.hpp"
+#include "lve_staging_ring.hpp"
+#include "lve_terrain_chunks.hpp"
 
 #define GLM_FORCE_RADIANS
 #define GLM_FORCE_DEPTH_ZERO_TO_ONE
@@ -15,6 +20,17 @@ namespace lve {
 
 class LveTerrain {
   public:
+   using id_t = unsigned int;
+
+   // Raster has no vertex buffer; the shader reads storage buffers.
+   enum class VertexFormat {
+      Full,
+      Compact16,
+      Compact32,
+      Raster,
+   };
+   static constexpr size_t vertexFormatCount = 4;
+
    struct Vertex {
       glm::float32 alttitude{};
       glm::vec3 color{};
@@ -26,15 +42,75 @@ class LveTerrain {
       getAttributeDescriptions();
    };
 
+   // Altitude normalised over the map's range, see altitudeTransform.
+   struct CompactVertex16 {
+      glm::uint16 alttitude{};
+      glm::i16vec2 normal{};
+      glm::u8vec4 color{};
+
+      static std::vector<VkVertexInputBindingDescription>
+      getBindingDescriptions();
+      static std::vector<VkVertexInputAttributeDescription>
+      getAttributeDescriptions();
+   };
+
+   struct CompactVertex32 {
+      glm::float32 alttitude{};
+      glm::i16vec2 normal{};
+      glm::u8vec4 color{};
+
+      static std::vector<VkVertexInputBindingDescription>
+      getBindingDescriptions();
+      static std::vector<VkVertexInputAttributeDescription>
+      getAttributeDescriptions();
+   };
+
    struct Builder {
+      VertexFormat format = VertexFormat::Full;
+      // In metres, over altitudes in cell units. 0 keeps the grid.
+      glm::float32 maxError = 0.f;
+      // Only the array matching format is filled.
       std::vector<Vertex> vertices{};
+      std::vector<CompactVertex16> compactVertices16{};
+      std::vector<CompactVertex32> compactVertices32{};
+      // Raster format, two 16-bit classes per vegetation word.
+      std::vector<glm::float32> alttitudes{};
+      std::vector<glm::uint32> vegetation{};
+      // Indexed by class. The palette is left to the caller.
+      std::vector<glm::int32> vegetationTypes{};
+      std::vector<glm::vec4> palette{};
       std::vector<uint32_t> indices{};
+      TerrainChunks chunks{};
+      // alttitude = alttitudeOffset + alttitudeScale * stored.
+      glm::float32 alttitudeOffset = 0.f;
+      glm::float32 alttitudeScale = 1.f;
+      uint32_t width = 0;
+      uint32_t height = 0;
+
+      // threads = 0 uses one per hardware thread.
+      void generateMesh(const Raster<glm::float32> &alttitudeMap,
+                        const Raster<glm::vec3> &colorMap,
+                        unsigned threads = 0);
+
+      // Throws past maxVegetationClasses types.
+      void generateRaster(const Raster<glm::float32> &alttitudeMap,
+                          const Raster<glm::int32> &vegetationMap,
+                          unsigned threads = 0);
+   };
 
-      void generateMesh(
-          const std::vector<std::vector<glm::float32>> &alttitudeMap,
-          const std::vector<std::vector<glm::vec3>> &colorMap);
+   // Map cells x0 <= x < x1 of rows y0 <= y < y1.
+   struct Region {
+      uint32_t x0 = 0;
+      uint32_t y0 = 0;
+      uint32_t x1 = 0;
+      uint32_t y1 = 0;
    };
 
+   // Distance, in cells, up to which chunks keep full detail.
+   static constexpr float defaultLodDistance = 128.f;
+   // The palette is allocated for all of them.
+   static constexpr size_t maxVegetationClasses = 0x10000;
+
    LveTerrain(LveDevice &device, const LveTerrain::Builder &builder);
    ~LveTerrain();
 
@@ -42,25 +118,123 @@ class LveTerrain {
    LveTerrain &operator=(const LveTerrain &) = delete;
 
    static std::unique_ptr<LveTerrain> createModelFromMesh(
-       LveDevice &device,
-       const std::vector<std::vector<glm::float32>> &alttitudeMap,
-       const std::vector<std::vector<glm::vec3>> &colorMap);
+       LveDevice &device, const Raster<glm::float32> &alttitudeMap,
+       const Raster<glm::vec3> &colorMap, unsigned threads = 0,
+       VertexFormat format = VertexFormat::Full);
+
+   id_t getId() const {
+      return id;
+   }
+
+   VertexFormat vertexFormat() const {
+      return format;
+   }
+
+   // Identity unless the altitude is quantised.
+   const glm::mat4 &altitudeTransform() const {
+      return altitudeMatrix;
+   }
+
+   // Replaces the first palette.size() colors.
+   void setPalette(const std::vector<glm::vec4> &palette);
+
+   // update appends new types; their color is left to setPalette.
+   const std::vector<glm::int32> &getVegetationTypes() const {
+      return vegetationTypes;
+   }
+
+   bool isSimplified() const {
+      return simplified;
+   }
+
+   // Rewrites region plus the one cell border whose normals read it.
+   // Throws for simplified terrains, other map sizes, or altitudes out
+   // of the Compact16 range.
+   void update(const Raster<glm::float32> &alttitudeMap,
+               const Raster<glm::vec3> &colorMap, const Region &region);
+   // Raster format; new vegetation types get new classes.
+   void update(const Raster<glm::float32> &alttitudeMap,
+               const Raster<glm::int32> &vegetationMap,
+               const Region &region);
+   // Vegetation only, so simplified terrains allow it.
+   void update(const Raster<glm::int32> &vegetationMap,
+               const Region &region);
+
+   // Vertex buffer of the other formats.
+   VkDescriptorBufferInfo vertexInfo();
+   // Storage buffers of the Raster format.
+   VkDescriptorBufferInfo alttitudeInfo();
+   VkDescriptorBufferInfo vegetationInfo();
+   VkDescriptorBufferInfo paletteInfo();
+
+   const TerrainChunks &getChunks() const {
+      return chunks;
+   }
+   // Chunk tables for terrain_cull.comp, see TerrainChunks::gpuTables.
+   VkDescriptorBufferInfo chunkInfo();
+   VkDescriptorBufferInfo chunkRangeInfo();
 
    void bind(VkCommandBuffer commandBuffer);
-   void draw(VkCommandBuffer commandBuffer);
+   // viewer and projectionView in world space.
+   void draw(VkCommandBuffer commandBuffer, const glm::vec3 &viewer,
+             const glm::mat4 &projectionView,
+             float lodDistance = defaultLodDistance);
+   // Needs multiDrawIndirect.
+   void drawIndirect(VkCommandBuffer commandBuffer, VkBuffer drawBuffer);
 
   private:
-   void createVertexBuffers(const std::vector<Vertex> &vertices);
+   template <typename T>
+   std::unique_ptr<LveBuffer> createDeviceBuffer(
+       const std::vector<T> &data, VkBufferUsageFlags usageFlags);
+   template <typename V>
+   void createVertexBuffers(const std::vector<V> &vertices);
    void createIndexBuffers(const std::vector<uint32_t> &indices);
+   void checkSize(uint32_t mapWidth, uint32_t mapHeight) const;
+   template <typename V, typename Pack>
+   void updateVertices(const Raster<glm::float32> &alttitudeMap,
+                       const Raster<glm::vec3> &colorMap,
+                       const Region &region, Pack pack);
+   void updateBounds(const Raster<glm::float32> &alttitudeMap,
+                     const Region &region);
+   void updateVegetation(const Raster<glm::int32> &vegetationMap,
+                         const Region &region);
+   LveStagingRing &stagingRing();
 
    LveDevice &lveDevice;
 
+   id_t id;
+   VertexFormat format;
+   glm::mat4 altitudeMatrix{1.f};
+   uint32_t width;
+   uint32_t height;
+   bool simplified;
+
    std::unique_ptr<LveBuffer> vertexBuffer;
    uint32_t vertexCount;
 
+   std::unique_ptr<LveBuffer> alttitudeBuffer;
+   std::unique_ptr<LveBuffer> vegetationBuffer;
+   std::unique_ptr<LveBuffer> paletteBuffer;
+   // Class of each vegetation type, for update, and the other way.
+   std::unordered_map<glm::int32, glm::uint32> vegetationClasses;
+   std::vector<glm::int32> vegetationTypes;
+
    bool hasIndexBuffer = false;
    std::unique_ptr<LveBuffer> indexBuffer;
    uint32_t indexCount;
+   VkIndexType indexType = VK_INDEX_TYPE_UINT32;
+
+   TerrainChunks chunks;
+   std::unique_ptr<LveBuffer> chunkBuffer;
+   std::unique_ptr<LveBuffer> chunkRangeBuffer;
+   // Copy of chunkBuffer, whose bounds update rewrites.
+   std::vector<TerrainChunks::GpuChunk> gpuChunks;
+   // Created by the first update.
+   std::unique_ptr<LveStagingRing> ring;
+   // Scratch space of draw, kept between frames.
+   std::vector<uint32_t> levels;
+   std::vector<bool> visible;
+   std::vector<TerrainChunks::Range> ranges;
 };
 
 }  // namespace lve
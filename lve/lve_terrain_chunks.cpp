@@ -0,0 +1,468 @@
+#include "lve_terrain_chunks.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include "lve_utils.hpp"
+#include "lve_vertex_cache.hpp"
+
+namespace lve {
+
+namespace {
+
+typedef struct {
+   uint32_t c;
+   uint32_t r;
+} GridPoint;
+
+// A remainder under half a chunk is merged into the last chunk.
+std::vector<uint32_t> chunkBounds(uint32_t quads, uint32_t chunkSize) {
+   std::vector<uint32_t> bounds{0};
+   while (quads - bounds.back() >= chunkSize + chunkSize / 2) {
+      bounds.push_back(bounds.back() + chunkSize);
+   }
+   bounds.push_back(quads);
+   return bounds;
+}
+
+// Positions from a0 to a1 every step, both ends included.
+std::vector<uint32_t> axis(uint32_t a0, uint32_t a1, uint32_t step) {
+   std::vector<uint32_t> ret;
+   for (uint32_t a = a0; a < a1; a += step) {
+      ret.push_back(a);
+   }
+   ret.push_back(a1);
+   return ret;
+}
+
+uint32_t cells(uint32_t length, uint32_t step) {
+   return (length + step - 1) / step;
+}
+
+// Thinner chunks still get level 0, drawn whole as their interior.
+uint32_t levelCount(const TerrainChunks::Chunk &chunk) {
+   uint32_t side = std::min(chunk.x1 - chunk.x0, chunk.y1 - chunk.y0);
+   uint32_t levels = 0;
+   while (levels < 31 && side > (1u << levels)) {
+      ++levels;
+   }
+   return std::max(levels, 1u);
+}
+
+bool ringless(const TerrainChunks::Chunk &chunk) {
+   return std::min(chunk.x1 - chunk.x0, chunk.y1 - chunk.y0) < 2;
+}
+
+bool horizontal(TerrainChunks::Side side) {
+   return side == TerrainChunks::Top || side == TerrainChunks::Bottom;
+}
+
+void strip(const TerrainChunks::Chunk &chunk, TerrainChunks::Side side,
+           uint32_t step, uint32_t outerStep,
+           std::vector<GridPoint> &outer, std::vector<GridPoint> &inner) {
+   std::vector<uint32_t> xs = axis(chunk.x0, chunk.x1, step);
+   std::vector<uint32_t> ys = axis(chunk.y0, chunk.y1, step);
+   outer.clear();
+   inner.clear();
+   if (horizontal(side)) {
+      uint32_t r = side == TerrainChunks::Top ? chunk.y0 : chunk.y1;
+      uint32_t ri =
+          side == TerrainChunks::Top ? ys[1] : ys[ys.size() - 2];
+      for (uint32_t c : axis(chunk.x0, chunk.x1, outerStep)) {
+         outer.push_back({c, r});
+      }
+      for (size_t i = 1; i + 1 < xs.size(); ++i) {
+         inner.push_back({xs[i], ri});
+      }
+   } else {
+      uint32_t c = side == TerrainChunks::Left ? chunk.x0 : chunk.x1;
+      uint32_t ci =
+          side == TerrainChunks::Left ? xs[1] : xs[xs.size() - 2];
+      for (uint32_t r : axis(chunk.y0, chunk.y1, outerStep)) {
+         outer.push_back({c, r});
+      }
+      for (size_t i = 1; i + 1 < ys.size(); ++i) {
+         inner.push_back({ci, ys[i]});
+      }
+   }
+}
+
+uint32_t interiorCount(const TerrainChunks::Chunk &chunk, uint32_t step) {
+   if (ringless(chunk)) {
+      return 6 * (chunk.x1 - chunk.x0) * (chunk.y1 - chunk.y0);
+   }
+   return 6 * (cells(chunk.x1 - chunk.x0, step) - 2) *
+          (cells(chunk.y1 - chunk.y0, step) - 2);
+}
+
+uint32_t stripCount(const TerrainChunks::Chunk &chunk,
+                    TerrainChunks::Side side, uint32_t step,
+                    uint32_t outerStep) {
+   if (ringless(chunk)) return 0;
+   uint32_t along = horizontal(side) ? chunk.x1 - chunk.x0
+                                     : chunk.y1 - chunk.y0;
+   return 3 * (cells(along, outerStep) + cells(along, step) - 2);
+}
+
+void fillInterior(const TerrainChunks::Chunk &chunk, uint32_t step,
+                  uint32_t xn, uint32_t *out) {
+   std::vector<uint32_t> xs = axis(chunk.x0, chunk.x1, step);
+   std::vector<uint32_t> ys = axis(chunk.y0, chunk.y1, step);
+   size_t skip = ringless(chunk) ? 0 : 1;
+   // Bands narrow enough that a row is still cached for the next one.
+   constexpr size_t band = defaultVertexCacheSize / 2 - 1;
+   size_t i1 = xs.size() - 1 - skip;
+   for (size_t i0 = skip; i0 < i1; i0 += band) {
+      for (size_t j = skip; j + 1 + skip < ys.size(); ++j) {
+         for (size_t i = i0; i < std::min(i0 + band, i1); ++i) {
+            uint32_t a = ys[j] * xn + xs[i];
+            uint32_t b = ys[j] * xn + xs[i + 1];
+            uint32_t c = ys[j + 1] * xn + xs[i];
+            uint32_t d = ys[j + 1] * xn + xs[i + 1];
+            *out++ = a;
+            *out++ = b;
+            *out++ = c;
+            *out++ = b;
+            *out++ = d;
+            *out++ = c;
+         }
+      }
+   }
+}
+
+void fillStrip(const std::vector<GridPoint> &outer,
+               const std::vector<GridPoint> &inner, bool alongColumns,
+               uint32_t xn, uint32_t *out) {
+   auto along = [alongColumns](const GridPoint &p) {
+      return alongColumns ? p.c : p.r;
+   };
+   auto index = [xn](const GridPoint &p) {
+      return p.r * xn + p.c;
+   };
+   size_t a = 0;
+   size_t b = 0;
+   while (a + 1 < outer.size() || b + 1 < inner.size()) {
+      bool advanceOuter = b + 1 == inner.size() ||
+                          (a + 1 < outer.size() &&
+                           along(outer[a + 1]) <= along(inner[b + 1]));
+      *out++ = index(outer[a]);
+      if (advanceOuter) {
+         *out++ = index(outer[a + 1]);
+         *out++ = index(inner[b]);
+         ++a;
+      } else {
+         *out++ = index(inner[b + 1]);
+         *out++ = index(inner[b]);
+         ++b;
+      }
+   }
+}
+
+}  // namespace
+
+TerrainChunks::TerrainChunks(uint32_t xn, uint32_t yn,
+                             std::vector<uint32_t> &indices,
+                             unsigned threads, uint32_t chunkSize) {
+   if (xn < 2 || yn < 2) return;
+   layout(xn, yn, chunkSize);
+   for (Chunk &chunk : chunks) {
+      chunk.lods.resize(levelCount(chunk));
+      maxLevels = std::max<uint32_t>(maxLevels, chunk.lods.size());
+   }
+
+   size_t offset = indices.size();
+   auto place = [&offset](Range &range, uint32_t count) {
+      range = {static_cast<uint32_t>(offset), count};
+      offset += count;
+   };
+   for (uint32_t l = 0; l < maxLevels; ++l) {
+      for (Chunk &chunk : chunks) {
+         if (l >= chunk.lods.size()) continue;
+         Lod &lod = chunk.lods[l];
+         place(lod.interior, interiorCount(chunk, 1u << l));
+         for (Side side : {Top, Bottom, Left, Right}) {
+            lod.edges[side].resize(maxLevels - l);
+            place(lod.edges[side][0],
+                  stripCount(chunk, side, 1u << l, 1u << l));
+         }
+      }
+   }
+   for (Chunk &chunk : chunks) {
+      for (uint32_t l = 0; l < chunk.lods.size(); ++l) {
+         for (Side side : {Top, Bottom, Left, Right}) {
+            for (uint32_t k = 1; k < maxLevels - l; ++k) {
+               place(chunk.lods[l].edges[side][k],
+                     stripCount(chunk, side, 1u << l, 1u << (l + k)));
+            }
+         }
+      }
+   }
+
+   indices.resize(offset);
+   parallelFor(chunks.size(), threads, [&](size_t first, size_t last) {
+      std::vector<GridPoint> outer;
+      std::vector<GridPoint> inner;
+      for (size_t i = first; i < last; ++i) {
+         const Chunk &chunk = chunks[i];
+         for (uint32_t l = 0; l < chunk.lods.size(); ++l) {
+            const Lod &lod = chunk.lods[l];
+            fillInterior(chunk, 1u << l, xn,
+                         indices.data() + lod.interior.first);
+            if (ringless(chunk)) continue;
+            for (Side side : {Top, Bottom, Left, Right}) {
+               for (uint32_t k = 0; k < lod.edges[side].size(); ++k) {
+                  strip(chunk, side, 1u << l, 1u << (l + k), outer, inner);
+                  fillStrip(outer, inner, horizontal(side), xn,
+                            indices.data() + lod.edges[side][k].first);
+               }
+            }
+         }
+      }
+   });
+}
+
+TerrainChunks::TerrainChunks(
+    uint32_t xn, uint32_t yn, std::vector<uint32_t> &indices,
+    const std::vector<std::vector<uint32_t>> &blocks,
+    uint32_t chunkSize) {
+   if (xn < 2 || yn < 2) return;
+   layout(xn, yn, chunkSize);
+   maxLevels = 1;
+
+   // The last chunk of a row or column also takes the blocks of the
+   // remainder merged into it.
+   uint32_t blockColumns = cells(xn - 1, chunkSize);
+   uint32_t blockRows = cells(yn - 1, chunkSize);
+   for (uint32_t cy = 0; cy < rows; ++cy) {
+      for (uint32_t cx = 0; cx < columns; ++cx) {
+         Lod lod{};
+         lod.interior.first = static_cast<uint32_t>(indices.size());
+         uint32_t by1 = cy + 1 < rows ? cy + 1 : blockRows;
+         uint32_t bx1 = cx + 1 < columns ? cx + 1 : blockColumns;
+         for (uint32_t by = cy; by < by1; ++by) {
+            for (uint32_t bx = cx; bx < bx1; ++bx) {
+               const std::vector<uint32_t> &block =
+                   blocks[static_cast<size_t>(by) * blockColumns + bx];
+               indices.insert(indices.end(), block.begin(), block.end());
+            }
+         }
+         lod.interior.count =
+             static_cast<uint32_t>(indices.size()) - lod.interior.first;
+         for (Side side : {Top, Bottom, Left, Right}) {
+            lod.edges[side].resize(1);
+         }
+         chunks[static_cast<size_t>(cy) * columns + cx].lods = {lod};
+      }
+   }
+}
+
+void TerrainChunks::layout(uint32_t xn, uint32_t yn, uint32_t chunkSize) {
+   std::vector<uint32_t> xb = chunkBounds(xn - 1, chunkSize);
+   std::vector<uint32_t> yb = chunkBounds(yn - 1, chunkSize);
+   columns = xb.size() - 1;
+   rows = yb.size() - 1;
+   for (uint32_t cy = 0; cy < rows; ++cy) {
+      for (uint32_t cx = 0; cx < columns; ++cx) {
+         chunks.push_back({.x0 = xb[cx], .x1 = xb[cx + 1], .y0 = yb[cy],
+                           .y1 = yb[cy + 1]});
+      }
+   }
+}
+
+void TerrainChunks::fitBounds(Chunk &chunk,
+                              const Raster<glm::float32> &alttitudeMap,
+                              glm::float32 padding) {
+   uint32_t xn = alttitudeMap.width();
+   // Vertex columns x0..x1 are map columns xn - 1 - x1..xn - 1 - x0.
+   glm::float32 lo = INFINITY;
+   glm::float32 hi = -INFINITY;
+   for (uint32_t y = chunk.y0; y <= chunk.y1; ++y) {
+      const glm::float32 *row = alttitudeMap.row(y).data();
+      auto [min, max] = std::minmax_element(row + xn - 1 - chunk.x1,
+                                            row + xn - chunk.x0);
+      lo = std::min(lo, *min);
+      hi = std::max(hi, *max);
+   }
+   chunk.minAlttitude = -hi - padding;
+   chunk.maxAlttitude = -lo + padding;
+}
+
+void TerrainChunks::setBounds(const Raster<glm::float32> &alttitudeMap,
+                              glm::float32 padding, unsigned threads) {
+   parallelFor(chunks.size(), threads, [&](size_t first, size_t last) {
+      for (size_t i = first; i < last; ++i) {
+         fitBounds(chunks[i], alttitudeMap, padding);
+      }
+   });
+}
+
+std::vector<size_t> TerrainChunks::setBounds(
+    const Raster<glm::float32> &alttitudeMap, glm::float32 padding,
+    uint32_t c0, uint32_t c1, uint32_t r0, uint32_t r1) {
+   std::vector<size_t> changed;
+   for (size_t i = 0; i < chunks.size(); ++i) {
+      Chunk &chunk = chunks[i];
+      if (chunk.x1 < c0 || chunk.x0 > c1 || chunk.y1 < r0 ||
+          chunk.y0 > r1) {
+         continue;
+      }
+      fitBounds(chunk, alttitudeMap, padding);
+      changed.push_back(i);
+   }
+   return changed;
+}
+
+void TerrainChunks::optimizeIndices(std::vector<uint32_t> &indices,
+                                    unsigned threads) const {
+   std::vector<Range> interiors;
+   for (const Chunk &chunk : chunks) {
+      for (const Lod &lod : chunk.lods) {
+         interiors.push_back(lod.interior);
+      }
+   }
+   parallelFor(interiors.size(), threads, [&](size_t first, size_t last) {
+      for (size_t i = first; i < last; ++i) {
+         optimizeVertexCache(indices.data() + interiors[i].first,
+                             interiors[i].count);
+      }
+   });
+}
+
+float TerrainChunks::cacheMissRatio(
+    const std::vector<uint32_t> &indices) const {
+   double misses = 0.;
+   size_t triangles = 0;
+   for (const Chunk &chunk : chunks) {
+      if (chunk.lods.empty()) continue;
+      const Lod &lod = chunk.lods[0];
+      std::array<Range, 5> ranges = {lod.interior, lod.edges[Top][0],
+                                     lod.edges[Bottom][0],
+                                     lod.edges[Left][0],
+                                     lod.edges[Right][0]};
+      for (const Range &range : ranges) {
+         misses += averageCacheMissRatio(indices.data() + range.first,
+                                         range.count) *
+                   (range.count / 3);
+         triangles += range.count / 3;
+      }
+   }
+   return triangles ? static_cast<float>(misses / triangles) : 0.f;
+}
+
+std::array<glm::vec4, 6> TerrainChunks::frustumPlanes(
+    const glm::mat4 &projectionView) {
+   // Depth in [0, 1]: the near plane is the third row alone.
+   auto row = [&projectionView](int i) {
+      return glm::vec4(projectionView[0][i], projectionView[1][i],
+                       projectionView[2][i], projectionView[3][i]);
+   };
+   return {
+       row(3) + row(0), row(3) - row(0), row(3) + row(1),
+       row(3) - row(1), row(2),          row(3) - row(2),
+   };
+}
+
+void TerrainChunks::cull(const glm::mat4 &projectionView,
+                         std::vector<bool> &visible) const {
+   std::array<glm::vec4, 6> planes = frustumPlanes(projectionView);
+
+   visible.resize(chunks.size());
+   for (size_t i = 0; i < chunks.size(); ++i) {
+      const Chunk &chunk = chunks[i];
+      glm::vec3 lo(chunk.x0, chunk.minAlttitude, chunk.y0);
+      glm::vec3 hi(chunk.x1, chunk.maxAlttitude, chunk.y1);
+      bool inside = true;
+      for (const glm::vec4 &plane : planes) {
+         // The corner furthest along the plane normal.
+         glm::vec3 p(plane.x >= 0.f ? hi.x : lo.x,
+                     plane.y >= 0.f ? hi.y : lo.y,
+                     plane.z >= 0.f ? hi.z : lo.z);
+         if (glm::dot(glm::vec3(plane), p) + plane.w < 0.f) {
+            inside = false;
+            break;
+         }
+      }
+      visible[i] = inside;
+   }
+}
+
+void TerrainChunks::selectLevels(const glm::vec3 &viewer,
+                                 float lodDistance,
+                                 std::vector<uint32_t> &levels) const {
+   levels.resize(chunks.size());
+   for (size_t i = 0; i < chunks.size(); ++i) {
+      const Chunk &chunk = chunks[i];
+      float dx =
+          std::max({chunk.x0 - viewer.x, 0.f, viewer.x - chunk.x1});
+      float dz =
+          std::max({chunk.y0 - viewer.z, 0.f, viewer.z - chunk.y1});
+      float distance = std::sqrt(dx * dx + dz * dz);
+      uint32_t level = 0;
+      while (level + 1 < chunk.lods.size() &&
+             distance >= lodDistance * static_cast<float>(1u << level)) {
+         ++level;
+      }
+      levels[i] = level;
+   }
+}
+
+void TerrainChunks::drawRanges(const std::vector<uint32_t> &levels,
+                               const std::vector<bool> &visible,
+                               std::vector<Range> &ranges) const {
+   auto push = [&ranges](const Range &range) {
+      if (!range.count) return;
+      if (!ranges.empty() &&
+          ranges.back().first + ranges.back().count == range.first) {
+         ranges.back().count += range.count;
+      } else {
+         ranges.push_back(range);
+      }
+   };
+   for (uint32_t cy = 0; cy < rows; ++cy) {
+      for (uint32_t cx = 0; cx < columns; ++cx) {
+         size_t i = static_cast<size_t>(cy) * columns + cx;
+         if (!visible[i]) continue;
+         uint32_t level = levels[i];
+         const Lod &lod = chunks[i].lods[level];
+         push(lod.interior);
+         // Map borders have no neighbour to match.
+         std::array<uint32_t, 4> neighbours = {
+             cy > 0 ? levels[i - columns] : level,
+             cy + 1 < rows ? levels[i + columns] : level,
+             cx > 0 ? levels[i - 1] : level,
+             cx + 1 < columns ? levels[i + 1] : level,
+         };
+         for (Side side : {Top, Bottom, Left, Right}) {
+            uint32_t k =
+                neighbours[side] > level ? neighbours[side] - level : 0;
+            push(lod.edges[side][k]);
+         }
+      }
+   }
+}
+
+void TerrainChunks::gpuTables(std::vector<GpuChunk> &gpuChunks,
+                              std::vector<Range> &gpuRanges) const {
+   const uint32_t stride = 1 + 4 * maxLevels;
+   gpuChunks.clear();
+   gpuRanges.clear();
+   for (const Chunk &chunk : chunks) {
+      gpuChunks.push_back({
+          .lo = glm::vec4(chunk.x0, chunk.minAlttitude, chunk.y0, 0.f),
+          .hi = glm::vec4(chunk.x1, chunk.maxAlttitude, chunk.y1, 0.f),
+          .levels = static_cast<uint32_t>(chunk.lods.size()),
+          .firstRange = static_cast<uint32_t>(gpuRanges.size()),
+      });
+      for (const Lod &lod : chunk.lods) {
+         size_t base = gpuRanges.size();
+         gpuRanges.resize(base + stride);
+         gpuRanges[base] = lod.interior;
+         for (Side side : {Top, Bottom, Left, Right}) {
+            std::copy(lod.edges[side].begin(), lod.edges[side].end(),
+                      gpuRanges.begin() + base + 1 + side * maxLevels);
+         }
+      }
+   }
+}
+
+}  // namespace lve
@@ -0,0 +1,147 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <glm/fwd.hpp>
+#include <vector>
+
+#define GLM_FORCE_RADIANS
+#define GLM_FORCE_DEPTH_ZERO_TO_ONE
+#include <glm/glm.hpp>
+
+#include "lve_raster.hpp"
+
+namespace lve {
+
+/**
+ * Geomipmapping layout of the terrain grid; level l keeps every 2^l-th
+ * vertex. Each strip has a variant per coarser neighbour level, so
+ * chunks meet without cracks. The indices of one level are contiguous
+ * across chunks, so a run of chunks at the same level is one draw.
+ */
+class TerrainChunks {
+  public:
+   static constexpr uint32_t defaultChunkSize = 64;
+
+   struct Range {
+      uint32_t first = 0;
+      uint32_t count = 0;
+   };
+
+   // Top is row y0 and Left is column x0 of the chunk.
+   enum Side {
+      Top,
+      Bottom,
+      Left,
+      Right,
+   };
+
+   struct Lod {
+      Range interior{};
+      // edges[side][k] is the strip along side when the neighbour is
+      // drawn k levels coarser.
+      std::array<std::vector<Range>, 4> edges{};
+   };
+
+   struct Chunk {
+      // Vertex columns and rows covered, both bounds included.
+      uint32_t x0 = 0;
+      uint32_t x1 = 0;
+      uint32_t y0 = 0;
+      uint32_t y1 = 0;
+      // Range of the vertex altitudes, see setBounds.
+      glm::float32 minAlttitude = 0.f;
+      glm::float32 maxAlttitude = 0.f;
+      std::vector<Lod> lods{};
+   };
+
+   // The interior, then the strips in Side order.
+   static constexpr uint32_t gpuDrawsPerChunk = 5;
+
+   // std430, as terrain_cull.comp reads it.
+   struct GpuChunk {
+      // x0, minAlttitude, y0 and x1, maxAlttitude, y1, in grid space.
+      glm::vec4 lo{};
+      glm::vec4 hi{};
+      uint32_t levels = 0;
+      uint32_t firstRange = 0;
+      uint32_t padding[2] = {};
+   };
+
+   TerrainChunks() = default;
+
+   // Appends the indices of every level; threads = 0 uses all.
+   TerrainChunks(uint32_t xn, uint32_t yn, std::vector<uint32_t> &indices,
+                 unsigned threads = 0,
+                 uint32_t chunkSize = defaultChunkSize);
+
+   // Single level, for crack free meshes. blocks[by * bxn + bx] holds
+   // the triangles of chunk (bx, by), bxn = ceil((xn - 1) / chunkSize).
+   TerrainChunks(uint32_t xn, uint32_t yn, std::vector<uint32_t> &indices,
+                 const std::vector<std::vector<uint32_t>> &blocks,
+                 uint32_t chunkSize = defaultChunkSize);
+
+   // Vertex altitude is -h at vertex column xn - 1 - x.
+   void setBounds(const Raster<glm::float32> &alttitudeMap,
+                  glm::float32 padding = 0.f, unsigned threads = 0);
+
+   // Only the chunks over columns c0..c1 and rows r0..r1, included;
+   // returns them.
+   std::vector<size_t> setBounds(const Raster<glm::float32> &alttitudeMap,
+                                 glm::float32 padding, uint32_t c0,
+                                 uint32_t c1, uint32_t r0, uint32_t r1);
+
+   // The ranges don't move.
+   void optimizeIndices(std::vector<uint32_t> &indices,
+                        unsigned threads = 0) const;
+
+   // Of drawing every chunk at level 0.
+   float cacheMissRatio(const std::vector<uint32_t> &indices) const;
+
+   // Normals point inwards; depth in [0, 1].
+   static std::array<glm::vec4, 6> frustumPlanes(
+       const glm::mat4 &projectionView);
+
+   void cull(const glm::mat4 &projectionView,
+             std::vector<bool> &visible) const;
+
+   // Each doubling of the distance past lodDistance adds a level.
+   void selectLevels(const glm::vec3 &viewer, float lodDistance,
+                     std::vector<uint32_t> &levels) const;
+
+   // Contiguous ranges are merged.
+   void drawRanges(const std::vector<uint32_t> &levels,
+                   const std::vector<bool> &visible,
+                   std::vector<Range> &ranges) const;
+
+   // Each level takes 1 + 4 * getLevels() ranges: the interior, then
+   // edges[side][k] at 1 + side * getLevels() + k, unused slots empty.
+   void gpuTables(std::vector<GpuChunk> &gpuChunks,
+                  std::vector<Range> &gpuRanges) const;
+
+   const std::vector<Chunk> &getChunks() const {
+      return chunks;
+   }
+   uint32_t getColumns() const {
+      return columns;
+   }
+   uint32_t getRows() const {
+      return rows;
+   }
+   uint32_t getLevels() const {
+      return maxLevels;
+   }
+
+  private:
+   void layout(uint32_t xn, uint32_t yn, uint32_t chunkSize);
+   static void fitBounds(Chunk &chunk,
+                         const Raster<glm::float32> &alttitudeMap,
+                         glm::float32 padding);
+
+   uint32_t columns = 0;
+   uint32_t rows = 0;
+   uint32_t maxLevels = 0;
+   std::vector<Chunk> chunks{};
+};
+
+}  // namespace lve
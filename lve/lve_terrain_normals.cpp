@@ -0,0 +1,221 @@
+#include "lve_terrain_normals.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <type_traits>
+
+namespace lve {
+
+namespace {
+
+#if defined(__x86_64__) || defined(__i386__)
+#define LVE_X86_KERNELS
+// The wide kernels are always inlined into functions built for their
+// instruction set, so the ABI of the helpers never matters.
+#pragma GCC diagnostic ignored "-Wpsabi"
+typedef float Float4 __attribute__((vector_size(16)));
+typedef float Float8 __attribute__((vector_size(32)));
+#endif
+
+/**
+ * glm::vec3 over V lanes. The arithmetic mirrors glm's component by
+ * component, so every lane rounds exactly like the scalar code.
+ */
+template <typename V>
+struct Vec3 {
+   V x, y, z;
+};
+
+template <typename V>
+inline __attribute__((always_inline)) V splat(float value) {
+   if constexpr (std::is_same_v<V, float>) {
+      return value;
+   } else {
+      V ret;
+      for (size_t i = 0; i < sizeof(V) / sizeof(float); ++i) {
+         ret[i] = value;
+      }
+      return ret;
+   }
+}
+
+template <typename V>
+inline __attribute__((always_inline)) V load(const float *cells) {
+   V ret;
+   std::memcpy(&ret, cells, sizeof(V));
+   return ret;
+}
+
+template <typename V>
+inline __attribute__((always_inline)) Vec3<V> operator-(const Vec3<V> &a,
+                                                        const Vec3<V> &b) {
+   return {a.x - b.x, a.y - b.y, a.z - b.z};
+}
+
+template <typename V>
+inline __attribute__((always_inline)) Vec3<V> operator+(const Vec3<V> &a,
+                                                        const Vec3<V> &b) {
+   return {a.x + b.x, a.y + b.y, a.z + b.z};
+}
+
+template <typename V>
+inline __attribute__((always_inline)) Vec3<V> cross(const Vec3<V> &a,
+                                                    const Vec3<V> &b) {
+   return {a.y * b.z - b.y * a.z, a.z * b.x - b.z * a.x,
+           a.x * b.y - b.x * a.y};
+}
+
+/**
+ * Normal of the vertex at (x, y) given the positions and heights of its
+ * four neighbours. Same operations, in the same order, as the original
+ * generateMesh loop.
+ */
+template <typename V>
+inline __attribute__((always_inline)) Vec3<V> normal(
+    const V &x, const V &xs, const V &xa, const V &y, const V &ys,
+    const V &ya, const V &h, const V &h_xs, const V &h_xa, const V &h_ys,
+    const V &h_ya) {
+   Vec3<V> x_y = {x, y, h};
+   Vec3<V> xs_y = {xs, y, h_xs};
+   Vec3<V> xa_y = {xa, y, h_xa};
+   Vec3<V> x_ys = {x, ys, h_ys};
+   Vec3<V> x_ya = {x, ya, h_ya};
+
+   Vec3<V> x_a = x_y - x_ys;
+   Vec3<V> x_b = x_y - xs_y;
+   Vec3<V> x_c = x_y - x_ya;
+   Vec3<V> x_d = x_y - xa_y;
+
+   Vec3<V> n1 = cross(x_a, x_b);
+   Vec3<V> n2 = cross(x_b, x_c);
+   Vec3<V> n3 = cross(x_c, x_d);
+   Vec3<V> n4 = cross(x_d, x_a);
+
+   Vec3<V> sum = n1 + n2 + n3 + n4;
+   return {sum.x / 4.f, sum.y / 4.f, sum.z / 4.f};
+}
+
+template <typename V>
+inline __attribute__((always_inline)) void rowNormals(
+    const float *row, const float *row_s, const float *row_a, uint32_t y,
+    uint32_t ys, uint32_t ya, uint32_t xn, uint32_t x0, uint32_t x1,
+    glm::vec3 *normals) {
+   const V fy = splat<V>(y);
+   const V fys = splat<V>(ys);
+   const V fya = splat<V>(ya);
+
+   auto scalar = [&](uint32_t x) {
+      uint32_t xs = x == xn - 1 ? x : x + 1;
+      uint32_t xa = x == 0 ? x : x - 1;
+      Vec3<float> n = normal<float>(x, xs, xa, y, ys, ya, row[x],
+                                    row[xs], row[xa], row_s[x], row_a[x]);
+      normals[x] = {n.x, n.y, n.z};
+   };
+
+   uint32_t x = x0;
+   if (x == 0 && x < x1) scalar(x++);
+   if constexpr (!std::is_same_v<V, float>) {
+      // Inside the row both horizontal neighbours exist, so whole blocks
+      // of lanes can be loaded straight from the rows.
+      constexpr uint32_t lanes = sizeof(V) / sizeof(float);
+      V offsets;
+      for (uint32_t i = 0; i < lanes; ++i) {
+         offsets[i] = i;
+      }
+      for (; x + lanes < xn && x + lanes <= x1; x += lanes) {
+         V fx = offsets + static_cast<float>(x);
+         V fxs = fx + 1.f;
+         V fxa = fx - 1.f;
+         Vec3<V> n = normal<V>(fx, fxs, fxa, fy, fys, fya,
+                               load<V>(row + x), load<V>(row + x + 1),
+                               load<V>(row + x - 1), load<V>(row_s + x),
+                               load<V>(row_a + x));
+         for (uint32_t i = 0; i < lanes; ++i) {
+            normals[x + i] = {n.x[i], n.y[i], n.z[i]};
+         }
+      }
+   }
+   for (; x < x1; ++x) {
+      scalar(x);
+   }
+}
+
+typedef void (*RowNormals)(const float *, const float *, const float *,
+                           uint32_t, uint32_t, uint32_t, uint32_t,
+                           uint32_t, uint32_t, glm::vec3 *);
+
+void rowNormalsScalar(const float *row, const float *row_s,
+                      const float *row_a, uint32_t y, uint32_t ys,
+                      uint32_t ya, uint32_t xn, uint32_t x0, uint32_t x1,
+                      glm::vec3 *normals) {
+   rowNormals<float>(row, row_s, row_a, y, ys, ya, xn, x0, x1, normals);
+}
+
+#ifdef LVE_X86_KERNELS
+__attribute__((target("sse2"))) void rowNormalsSse(
+    const float *row, const float *row_s, const float *row_a, uint32_t y,
+    uint32_t ys, uint32_t ya, uint32_t xn, uint32_t x0, uint32_t x1,
+    glm::vec3 *normals) {
+   rowNormals<Float4>(row, row_s, row_a, y, ys, ya, xn, x0, x1, normals);
+}
+
+__attribute__((target("avx"))) void rowNormalsAvx(
+    const float *row, const float *row_s, const float *row_a, uint32_t y,
+    uint32_t ys, uint32_t ya, uint32_t xn, uint32_t x0, uint32_t x1,
+    glm::vec3 *normals) {
+   rowNormals<Float8>(row, row_s, row_a, y, ys, ya, xn, x0, x1, normals);
+}
+#endif
+
+RowNormals selectRowNormals() {
+#ifdef LVE_X86_KERNELS
+   __builtin_cpu_init();
+   if (__builtin_cpu_supports("avx")) return rowNormalsAvx;
+   if (__builtin_cpu_supports("sse2")) return rowNormalsSse;
+#endif
+   return rowNormalsScalar;
+}
+
+RowNormals findRowNormals(NormalsKernel kernel) {
+   switch (kernel) {
+      case NormalsKernel::Best: {
+         static const RowNormals best = selectRowNormals();
+         return best;
+      }
+      case NormalsKernel::Scalar:
+         return rowNormalsScalar;
+#ifdef LVE_X86_KERNELS
+      case NormalsKernel::Sse2:
+         __builtin_cpu_init();
+         return __builtin_cpu_supports("sse2") ? rowNormalsSse : nullptr;
+      case NormalsKernel::Avx:
+         __builtin_cpu_init();
+         return __builtin_cpu_supports("avx") ? rowNormalsAvx : nullptr;
+#endif
+      default:
+         return nullptr;
+   }
+}
+
+}  // namespace
+
+void terrainRowNormals(const glm::float32 *row, const glm::float32 *row_s,
+                       const glm::float32 *row_a, uint32_t y, uint32_t ys,
+                       uint32_t ya, uint32_t xn, glm::vec3 *normals,
+                       uint32_t x0, uint32_t x1) {
+   terrainRowNormals(NormalsKernel::Best, row, row_s, row_a, y, ys, ya, xn,
+                     normals, x0, x1);
+}
+
+bool terrainRowNormals(NormalsKernel kernel, const glm::float32 *row,
+                       const glm::float32 *row_s,
+                       const glm::float32 *row_a, uint32_t y, uint32_t ys,
+                       uint32_t ya, uint32_t xn, glm::vec3 *normals,
+                       uint32_t x0, uint32_t x1) {
+   RowNormals fn = findRowNormals(kernel);
+   if (!fn) return false;
+   fn(row, row_s, row_a, y, ys, ya, xn, x0, std::min(x1, xn), normals);
+   return true;
+}
+
+}  // namespace lve
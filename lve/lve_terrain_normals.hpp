@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstdint>
+#include <glm/fwd.hpp>
+
+#define GLM_FORCE_RADIANS
+#define GLM_FORCE_DEPTH_ZERO_TO_ONE
+#include <glm/glm.hpp>
+
+namespace lve {
+
+/**
+ * Computes the terrain normals of row y, in increasing x order, from the
+ * rows at ys = y + 1 and ya = y - 1 (clamped to the map). Each normal is
+ * the average of the cross products of the four edges around the vertex,
+ * bit for bit the same as the scalar formula. The interior of the row is
+ * processed with SSE or AVX when the CPU supports it. Only normals[x]
+ * for x0 <= x < x1 are written.
+ */
+void terrainRowNormals(const glm::float32 *row, const glm::float32 *row_s,
+                       const glm::float32 *row_a, uint32_t y, uint32_t ys,
+                       uint32_t ya, uint32_t xn, glm::vec3 *normals,
+                       uint32_t x0 = 0, uint32_t x1 = UINT32_MAX);
+
+/**
+ * The kernels terrainRowNormals can run. Best is the one it uses, the
+ * widest the CPU supports; the others are there to compare them.
+ */
+enum class NormalsKernel { Best, Scalar, Sse2, Avx };
+
+/**
+ * terrainRowNormals with the given kernel. Returns false, writing
+ * nothing, when the kernel is not built in or the CPU lacks it.
+ */
+bool terrainRowNormals(NormalsKernel kernel, const glm::float32 *row,
+                       const glm::float32 *row_s,
+                       const glm::float32 *row_a, uint32_t y, uint32_t ys,
+                       uint32_t ya, uint32_t xn, glm::vec3 *normals,
+                       uint32_t x0 = 0, uint32_t x1 = UINT32_MAX);
+
+}  // namespace lve
@@ -0,0 +1,230 @@
+#include "lve_terrain_tin.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+#include "lve_utils.hpp"
+
+namespace lve {
+
+namespace {
+
+// Square of the quadtree, size quads a side from vertex (c, r).
+typedef struct {
+   uint32_t c;
+   uint32_t r;
+   uint32_t size;
+} Block;
+
+typedef struct {
+   int64_t c;
+   int64_t r;
+} Point;
+
+// Twice the signed area of (a, b, q), positive when counterclockwise in
+// (c, r), the winding of the grid triangles.
+int64_t orient(const Point &a, const Point &b, const Point &q) {
+   return (b.c - a.c) * (q.r - a.r) - (b.r - a.r) * (q.c - a.c);
+}
+
+class TinBuilder {
+  public:
+   TinBuilder(const Raster<glm::float32> &alttitudeMap,
+              glm::float32 maxError)
+       : alttitudeMap{alttitudeMap},
+         xn{alttitudeMap.width()},
+         yn{alttitudeMap.height()},
+         maxError{maxError},
+         used(static_cast<size_t>(xn) * yn) {
+   }
+
+   /**
+    * Appends to leaves the blocks b is split into: the parts inside the
+    * grid, each split until its fan through the four corners holds.
+    */
+   void subdivide(const Block &b, std::vector<Block> &leaves,
+                  std::vector<Point> &scratch) const {
+      if (b.c >= xn - 1 || b.r >= yn - 1) return;
+      bool inside = b.c + b.size < xn && b.r + b.size < yn;
+      if (inside) {
+         ring(b, false, scratch);
+         if (b.size == 1 || withinError(b, scratch)) {
+            leaves.push_back(b);
+            return;
+         }
+      }
+      uint32_t half = b.size / 2;
+      subdivide({b.c, b.r, half}, leaves, scratch);
+      subdivide({b.c + half, b.r, half}, leaves, scratch);
+      subdivide({b.c, b.r + half, half}, leaves, scratch);
+      subdivide({b.c + half, b.r + half, half}, leaves, scratch);
+   }
+
+   // Marks the corners of every leaf as the vertices of the mesh.
+   void mark(const std::vector<std::vector<Block>> &leaves) {
+      std::fill(used.begin(), used.end(), 0);
+      for (const std::vector<Block> &blocks : leaves) {
+         for (const Block &b : blocks) {
+            used[index(b.c, b.r)] = 1;
+            used[index(b.c + b.size, b.r)] = 1;
+            used[index(b.c, b.r + b.size)] = 1;
+            used[index(b.c + b.size, b.r + b.size)] = 1;
+         }
+      }
+   }
+
+   /**
+    * Boundary of b counterclockwise from its top left corner: the four
+    * corners and, if withSides, every marked vertex on its sides.
+    */
+   void ring(const Block &b, bool withSides,
+             std::vector<Point> &points) const {
+      points.clear();
+      uint32_t c1 = b.c + b.size;
+      uint32_t r1 = b.r + b.size;
+      auto add = [&](uint32_t c, uint32_t r, bool corner) {
+         if (corner || (withSides && used[index(c, r)])) {
+            points.push_back({c, r});
+         }
+      };
+      for (uint32_t c = b.c; c < c1; ++c) add(c, b.r, c == b.c);
+      for (uint32_t r = b.r; r < r1; ++r) add(c1, r, r == b.r);
+      for (uint32_t c = c1; c > b.c; --c) add(c, r1, c == c1);
+      for (uint32_t r = r1; r > b.r; --r) add(b.c, r, r == r1);
+   }
+
+   // Whether the fan of b over points stays within maxError of the map.
+   bool withinError(const Block &b,
+                    const std::vector<Point> &points) const {
+      if (b.size == 1) return true;
+      Point m{b.c + b.size / 2, b.r + b.size / 2};
+      for (size_t i = 0; i < points.size(); ++i) {
+         const Point &p = points[i];
+         const Point &q = points[(i + 1) % points.size()];
+         int64_t area = orient(m, p, q);
+         double hm = height(m);
+         double hp = height(p);
+         double hq = height(q);
+         int64_t c0 = std::min({m.c, p.c, q.c});
+         int64_t c1 = std::max({m.c, p.c, q.c});
+         int64_t r0 = std::min({m.r, p.r, q.r});
+         int64_t r1 = std::max({m.r, p.r, q.r});
+         for (int64_t r = r0; r <= r1; ++r) {
+            for (int64_t c = c0; c <= c1; ++c) {
+               Point x{c, r};
+               int64_t wm = orient(p, q, x);
+               int64_t wp = orient(q, m, x);
+               int64_t wq = orient(m, p, x);
+               if (wm < 0 || wp < 0 || wq < 0) continue;
+               double fan = (wm * hm + wp * hp + wq * hq) / area;
+               if (std::abs(fan - height(x)) > maxError) return false;
+            }
+         }
+      }
+      return true;
+   }
+
+   // Appends the triangles of b, points being its ring with sides.
+   void triangulate(const Block &b, const std::vector<Point> &points,
+                    std::vector<uint32_t> &out) const {
+      if (b.size == 1) {
+         // Same split as the grid.
+         uint32_t a = index(b.c, b.r);
+         uint32_t p = index(b.c + 1, b.r);
+         uint32_t q = index(b.c, b.r + 1);
+         uint32_t d = index(b.c + 1, b.r + 1);
+         out.insert(out.end(), {a, p, q, p, d, q});
+         return;
+      }
+      uint32_t m = index(b.c + b.size / 2, b.r + b.size / 2);
+      for (size_t i = 0; i < points.size(); ++i) {
+         const Point &p = points[i];
+         const Point &q = points[(i + 1) % points.size()];
+         out.insert(out.end(), {m, index(p.c, p.r), index(q.c, q.r)});
+      }
+   }
+
+  private:
+   uint32_t index(int64_t c, int64_t r) const {
+      return static_cast<uint32_t>(r * xn + c);
+   }
+
+   double height(const Point &p) const {
+      return alttitudeMap(xn - 1 - static_cast<uint32_t>(p.c),
+                          static_cast<uint32_t>(p.r));
+   }
+
+   const Raster<glm::float32> &alttitudeMap;
+   uint32_t xn;
+   uint32_t yn;
+   double maxError;
+   std::vector<uint8_t> used;
+};
+
+}  // namespace
+
+TerrainChunks simplifyTerrain(const Raster<glm::float32> &alttitudeMap,
+                              glm::float32 maxError,
+                              std::vector<uint32_t> &indices,
+                              unsigned threads, uint32_t chunkSize) {
+   if (!chunkSize || (chunkSize & (chunkSize - 1))) {
+      throw std::runtime_error("terrain chunk size must be a power of 2");
+   }
+   uint32_t xn = alttitudeMap.width();
+   uint32_t yn = alttitudeMap.height();
+   if (xn < 2 || yn < 2) return {};
+
+   uint32_t bxn = (xn - 1 + chunkSize - 1) / chunkSize;
+   uint32_t byn = (yn - 1 + chunkSize - 1) / chunkSize;
+   TinBuilder tin(alttitudeMap, maxError);
+   std::vector<std::vector<Block>> leaves(static_cast<size_t>(bxn) * byn);
+   parallelFor(leaves.size(), threads, [&](size_t first, size_t last) {
+      std::vector<Point> scratch;
+      for (size_t i = first; i < last; ++i) {
+         Block root{static_cast<uint32_t>(i % bxn) * chunkSize,
+                    static_cast<uint32_t>(i / bxn) * chunkSize,
+                    chunkSize};
+         tin.subdivide(root, leaves[i], scratch);
+      }
+   });
+
+   // Smaller neighbours add vertices to the sides of a block, which
+   // changes its fan. Blocks whose fan no longer holds are split, until
+   // a pass splits none and its triangles are final.
+   std::vector<std::vector<uint32_t>> blocks(leaves.size());
+   std::vector<uint8_t> split(leaves.size(), 1);
+   while (std::find(split.begin(), split.end(), 1) != split.end()) {
+      tin.mark(leaves);
+      parallelFor(leaves.size(), threads, [&](size_t first, size_t last) {
+         std::vector<Point> points;
+         std::vector<Point> scratch;
+         std::vector<Block> next;
+         for (size_t i = first; i < last; ++i) {
+            split[i] = 0;
+            blocks[i].clear();
+            next.clear();
+            for (const Block &b : leaves[i]) {
+               tin.ring(b, true, points);
+               if (tin.withinError(b, points)) {
+                  next.push_back(b);
+                  tin.triangulate(b, points, blocks[i]);
+                  continue;
+               }
+               split[i] = 1;
+               uint32_t half = b.size / 2;
+               tin.subdivide({b.c, b.r, half}, next, scratch);
+               tin.subdivide({b.c + half, b.r, half}, next, scratch);
+               tin.subdivide({b.c, b.r + half, half}, next, scratch);
+               tin.subdivide({b.c + half, b.r + half, half}, next,
+                             scratch);
+            }
+            leaves[i].swap(next);
+         }
+      });
+   }
+
+   return TerrainChunks(xn, yn, indices, blocks, chunkSize);
+}
+
+}  // namespace lve
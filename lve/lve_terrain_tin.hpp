@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstdint>
+#include <glm/fwd.hpp>
+#include <vector>
+
+#include "lve_raster.hpp"
+#include "lve_terrain_chunks.hpp"
+
+#define GLM_FORCE_RADIANS
+#define GLM_FORCE_DEPTH_ZERO_TO_ONE
+#include <glm/glm.hpp>
+
+namespace lve {
+
+/**
+ * Error-bounded triangulated irregular network over the vertex grid of
+ * alttitudeMap (vertex column c is map column xn - 1 - c). The grid is
+ * split as a quadtree of square blocks, at most chunkSize quads a side,
+ * and each block is drawn as a fan from its center through its corners
+ * and every other block corner lying on its sides, so neighbouring
+ * blocks share their edges and the mesh has no cracks. Blocks are split
+ * until their fan is within maxError, in altitude units, of every
+ * altitude of the map they cover.
+ *
+ * The triangles index the full vertex grid and are appended to indices
+ * grouped by chunk; the returned layout draws them with a single level.
+ * Blocks are built on `threads` worker threads, 0 meaning one per
+ * hardware thread. Throws if chunkSize isn't a power of two.
+ */
+TerrainChunks simplifyTerrain(
+    const Raster<glm::float32> &alttitudeMap, glm::float32 maxError,
+    std::vector<uint32_t> &indices, unsigned threads = 0,
+    uint32_t chunkSize = TerrainChunks::defaultChunkSize);
+
+}  // namespace lve
@@ -1,6 +1,12 @@
 #pragma once
 
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
 #include <functional>
+#include <thread>
+#include <vector>
 
 namespace lve {
 
@@ -10,4 +16,99 @@ void hashCombine(std::size_t &seed, const T &v, const Rest &...rest) {
    (hashCombine(seed, rest), ...);
 };
 
+/**
+ * Number of worker threads to use for a parallel job. A request of 0
+ * means one thread per hardware thread.
+ */
+inline unsigned workerCount(unsigned requested) {
+   if (requested) return requested;
+   return std::max(1u, std::thread::hardware_concurrency());
+}
+
+/**
+ * Splits [0, count) in up to `threads` contiguous ranges and calls
+ * fn(begin, end) for each of them on its own thread. The last range runs
+ * on the calling thread, and the call returns once every range is done.
+ * The first exception thrown by any range is rethrown to the caller.
+ */
+template <typename F>
+void parallelFor(std::size_t count, unsigned threads, F &&fn) {
+   std::size_t workers =
+       std::min<std::size_t>(workerCount(threads), count);
+   if (workers <= 1) {
+      if (count) fn(std::size_t{0}, count);
+      return;
+   }
+   std::vector<std::thread> pool;
+   std::vector<std::exception_ptr> errors(workers);
+   pool.reserve(workers - 1);
+   std::size_t begin = 0;
+   for (std::size_t i = 0; i < workers; ++i) {
+      std::size_t end = count * (i + 1) / workers;
+      auto run = [&fn, &errors, i, begin, end] {
+         try {
+            fn(begin, end);
+         } catch (...) {
+            errors[i] = std::current_exception();
+         }
+      };
+      if (i + 1 == workers) {
+         run();
+      } else {
+         pool.emplace_back(run);
+      }
+      begin = end;
+   }
+   for (std::thread &thread : pool) {
+      thread.join();
+   }
+   for (std::exception_ptr &error : errors) {
+      if (error) std::rethrow_exception(error);
+   }
+}
+
+/**
+ * parallelFor for items of uneven cost. Up to `threads` workers take
+ * [0, count) in chunks of `grain` items from a shared counter until none
+ * are left, so a worker that drew slow items doesn't hold the others
+ * back. fn(worker, begin, end) is called once per chunk with the index
+ * of the worker running it, below workerCount(threads), for per worker
+ * scratch space. The last worker runs on the calling thread, and the
+ * first exception thrown is rethrown once every worker stopped.
+ */
+template <typename F>
+void parallelForDynamic(std::size_t count, unsigned threads,
+                        std::size_t grain, F &&fn) {
+   grain = std::max<std::size_t>(grain, 1);
+   std::size_t chunks = (count + grain - 1) / grain;
+   std::size_t workers =
+       std::min<std::size_t>(workerCount(threads), chunks);
+   std::atomic<std::size_t> next{0};
+   std::vector<std::exception_ptr> errors(workers);
+   auto run = [&fn, &errors, &next, count, grain](unsigned worker) {
+      try {
+         for (std::size_t begin = next.fetch_add(grain); begin < count;
+              begin = next.fetch_add(grain)) {
+            fn(worker, begin, std::min(begin + grain, count));
+         }
+      } catch (...) {
+         errors[worker] = std::current_exception();
+         // The other workers stop at their next chunk.
+         next = count;
+      }
+   };
+   std::vector<std::thread> pool;
+   pool.reserve(workers ? workers - 1 : 0);
+   for (std::size_t i = 0; i + 1 < workers; ++i) {
+      pool.emplace_back(run, static_cast<unsigned>(i));
+   }
+   if (workers) run(static_cast<unsigned>(workers - 1));
+   for (std::thread &thread : pool) {
+      thread.join();
+   }
+   for (std::exception_ptr &error : errors) {
+      if (error) std::rethrow_exception(error);
+   }
+}
+
 }  // namespace lve
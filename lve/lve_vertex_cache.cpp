@@ -0,0 +1,202 @@
+#include "lve_vertex_cache.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+namespace lve {
+
+namespace {
+
+// Scoring of Forsyth's "Linear-Speed Vertex Cache Optimisation".
+constexpr float cacheDecayPower = 1.5f;
+constexpr float lastTriangleScore = 0.75f;
+constexpr float valenceBoostScale = 2.f;
+constexpr float valenceBoostPower = 0.5f;
+
+constexpr uint32_t valenceTableSize = 32;
+
+/**
+ * Score of each cache position, then of each remaining triangle count,
+ * so the per triangle loop doesn't call pow.
+ */
+struct ScoreTables {
+   std::array<float, defaultVertexCacheSize> position{};
+   std::array<float, valenceTableSize> valence{};
+
+   ScoreTables() {
+      for (uint32_t i = 0; i < defaultVertexCacheSize; ++i) {
+         if (i < 3) {
+            // The vertices of the last triangle are equally fresh.
+            position[i] = lastTriangleScore;
+         } else {
+            float scaler = 1.f / (defaultVertexCacheSize - 3);
+            position[i] = std::pow(1.f - (i - 3) * scaler,
+                                   cacheDecayPower);
+         }
+      }
+      for (uint32_t i = 1; i < valenceTableSize; ++i) {
+         valence[i] = valenceBoost(i);
+      }
+   }
+
+   // Vertices with few triangles left are finished first, so they
+   // don't stay behind to be transformed again later.
+   static float valenceBoost(uint32_t remaining) {
+      return valenceBoostScale * std::pow(static_cast<float>(remaining),
+                                          -valenceBoostPower);
+   }
+
+   float score(int cachePosition, uint32_t remaining) const {
+      if (!remaining) return -1.f;
+      float score = cachePosition >= 0 ? position[cachePosition] : 0.f;
+      return score + (remaining < valenceTableSize
+                          ? valence[remaining]
+                          : valenceBoost(remaining));
+   }
+};
+
+}  // namespace
+
+void optimizeVertexCache(uint32_t *indices, size_t count) {
+   size_t triangles = count / 3;
+   if (triangles < 2) return;
+
+   // Vertices renumbered densely, so the tables stay the size of the
+   // list whatever vertices it uses.
+   std::vector<uint32_t> vertexIds(indices, indices + 3 * triangles);
+   std::sort(vertexIds.begin(), vertexIds.end());
+   vertexIds.erase(std::unique(vertexIds.begin(), vertexIds.end()),
+                   vertexIds.end());
+   std::vector<uint32_t> local(3 * triangles);
+   for (size_t i = 0; i < local.size(); ++i) {
+      local[i] = static_cast<uint32_t>(
+          std::lower_bound(vertexIds.begin(), vertexIds.end(),
+                           indices[i]) -
+          vertexIds.begin());
+   }
+
+   // Triangles of each vertex, the first remaining[v] still unplaced.
+   size_t vertices = vertexIds.size();
+   std::vector<uint32_t> remaining(vertices, 0);
+   for (uint32_t v : local) ++remaining[v];
+   std::vector<uint32_t> firstTriangle(vertices + 1, 0);
+   for (size_t v = 0; v < vertices; ++v) {
+      firstTriangle[v + 1] = firstTriangle[v] + remaining[v];
+   }
+   std::vector<uint32_t> vertexTriangles(firstTriangle.back());
+   std::vector<uint32_t> filled(firstTriangle.begin(),
+                                firstTriangle.end() - 1);
+   for (size_t t = 0; t < triangles; ++t) {
+      for (size_t k = 0; k < 3; ++k) {
+         vertexTriangles[filled[local[3 * t + k]]++] =
+             static_cast<uint32_t>(t);
+      }
+   }
+
+   static const ScoreTables tables;
+   std::vector<float> score(vertices);
+   for (size_t v = 0; v < vertices; ++v) {
+      score[v] = tables.score(-1, remaining[v]);
+   }
+   std::vector<float> triangleScore(triangles);
+   std::vector<bool> placed(triangles, false);
+   for (size_t t = 0; t < triangles; ++t) {
+      triangleScore[t] = score[local[3 * t]] + score[local[3 * t + 1]] +
+                         score[local[3 * t + 2]];
+   }
+
+   std::vector<uint32_t> out;
+   out.reserve(3 * triangles);
+   // Three more slots than the cache, for the vertices pushed out by
+   // the triangle being added.
+   std::vector<uint32_t> cache;
+   std::vector<uint32_t> nextCache;
+   size_t scan = 0;
+   size_t best = 0;
+   for (size_t t = 0; t < triangles; ++t) {
+      if (t) {
+         // The best triangle around the cache, or else the first left.
+         float bestScore = -1.f;
+         for (uint32_t v : cache) {
+            for (uint32_t i = firstTriangle[v];
+                 i < firstTriangle[v] + remaining[v]; ++i) {
+               uint32_t candidate = vertexTriangles[i];
+               if (triangleScore[candidate] > bestScore) {
+                  bestScore = triangleScore[candidate];
+                  best = candidate;
+               }
+            }
+         }
+         if (bestScore < 0.f) {
+            while (placed[scan]) ++scan;
+            best = scan;
+         }
+      }
+
+      placed[best] = true;
+      nextCache.clear();
+      for (size_t k = 0; k < 3; ++k) {
+         uint32_t v = local[3 * best + k];
+         out.push_back(vertexIds[v]);
+         nextCache.push_back(v);
+         // Move the triangle out of the remaining ones of v.
+         uint32_t *list = vertexTriangles.data() + firstTriangle[v];
+         std::swap(*std::find(list, list + remaining[v],
+                              static_cast<uint32_t>(best)),
+                   list[remaining[v] - 1]);
+         --remaining[v];
+      }
+      for (uint32_t v : cache) {
+         if (std::find(nextCache.begin(), nextCache.begin() + 3, v) ==
+             nextCache.begin() + 3) {
+            nextCache.push_back(v);
+         }
+      }
+      cache.swap(nextCache);
+
+      // Rescore what moved in the cache, and what fell out of it.
+      for (size_t i = 0; i < cache.size(); ++i) {
+         uint32_t v = cache[i];
+         int position = i < defaultVertexCacheSize ? static_cast<int>(i)
+                                                   : -1;
+         score[v] = tables.score(position, remaining[v]);
+      }
+      for (uint32_t v : cache) {
+         for (uint32_t i = firstTriangle[v];
+              i < firstTriangle[v] + remaining[v]; ++i) {
+            uint32_t triangle = vertexTriangles[i];
+            triangleScore[triangle] = score[local[3 * triangle]] +
+                                      score[local[3 * triangle + 1]] +
+                                      score[local[3 * triangle + 2]];
+         }
+      }
+      if (cache.size() > defaultVertexCacheSize) {
+         cache.resize(defaultVertexCacheSize);
+      }
+   }
+
+   std::copy(out.begin(), out.end(), indices);
+}
+
+float averageCacheMissRatio(const uint32_t *indices, size_t count,
+                            uint32_t cacheSize) {
+   size_t triangles = count / 3;
+   if (!triangles) return 0.f;
+   if (!cacheSize) return 3.f;
+   // A ring, misses overwriting the oldest entry.
+   std::vector<uint32_t> cache(cacheSize, UINT32_MAX);
+   size_t misses = 0;
+   for (size_t i = 0; i < 3 * triangles; ++i) {
+      if (std::find(cache.begin(), cache.end(), indices[i]) !=
+          cache.end()) {
+         continue;
+      }
+      cache[misses++ % cacheSize] = indices[i];
+   }
+   return static_cast<float>(misses) / triangles;
+}
+
+}  // namespace lve
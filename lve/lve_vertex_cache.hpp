@@ -0,0 +1,27 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace lve {
+
+// Post-transform cache size the triangle order is tuned for.
+constexpr uint32_t defaultVertexCacheSize = 32;
+
+/**
+ * Reorders the triangles of a triangle list, in place, so consecutive
+ * triangles share vertices while they are still in the post-transform
+ * cache (Forsyth's linear-speed vertex cache optimisation). Each triangle
+ * keeps its vertices and winding.
+ */
+void optimizeVertexCache(uint32_t *indices, size_t count);
+
+/**
+ * Average cache miss ratio of a triangle list: vertex shader invocations
+ * per triangle with a FIFO cache of cacheSize vertices. 0.5 is the best a
+ * large regular grid can do, 3 means no reuse at all.
+ */
+float averageCacheMissRatio(const uint32_t *indices, size_t count,
+                            uint32_t cacheSize = defaultVertexCacheSize);
+
+}  // namespace lve
@@ -3,9 +3,11 @@
 #include <strings.h>
 #include <vulkan/vulkan_core.h>
 
+#include <algorithm>
 #include <cstddef>
 #include <cstdint>
-#include <future>
+#include <deque>
+#include <functional>
 #include <glm/common.hpp>
 #include <glm/ext/vector_float2.hpp>
 #include <glm/ext/vector_float3.hpp>
@@ -14,8 +16,8 @@
 #include <vector>
 
 // #include "cppcolormap.hpp"
-#include "colormaps.hpp"
 #include "lve_buffer.hpp"
+#include "lve_utils.hpp"
 
 #define GLM_ENABLE_EXPERIMENTAL
 #include <cassert>
@@ -23,22 +25,415 @@
 
 namespace lve {
 
+namespace {
+
+// Both integrators run for max_samples * moveSpeed time units at most.
+constexpr size_t max_samples = 10000;
+constexpr float moveSpeed = 0.01f;
+
+constexpr float step_tolerance = 1e-3f;
+constexpr float max_turn = 0.05f;
+constexpr float max_segment = 1.f;
+constexpr float decimate_distance = 0.02f;
+constexpr float decimate_speed = 0.005f;
+constexpr size_t decimate_span = 32;
+// Fraction of the separation.
+constexpr float separation_test = 0.5f;
+
+// p in (x, z) grid coordinates.
+glm::vec2 windAt(const Raster<glm::vec2> &wind_speed, uint32_t xn,
+                 uint32_t yn, const glm::vec2 &p) {
+   uint32_t x0 = glm::clamp(xn - (uint32_t)floorf(p.x), (uint32_t)0,
+                            xn - 1);
+   uint32_t y0 = glm::clamp((uint32_t)floorf(p.y), (uint32_t)0, yn - 1);
+
+   uint32_t x1 = glm::clamp(xn - (uint32_t)ceilf(p.x), (uint32_t)0,
+                            xn - 1);
+   uint32_t y1 = glm::clamp((uint32_t)ceilf(p.y), (uint32_t)0, yn - 1);
+
+   float x_reg = glm::fract(p.x);
+   float y_reg = glm::fract(p.y);
+
+   glm::vec2 v00 = wind_speed(x0, y0);
+   glm::vec2 v01 = wind_speed(x1, y0);
+   glm::vec2 v10 = wind_speed(x0, y1);
+   glm::vec2 v11 = wind_speed(x1, y1);
+
+   glm::vec2 p00 = glm::vec2(0.f, 0.f);
+   glm::vec2 p01 = glm::vec2(1.f, 0.f);
+   glm::vec2 p10 = glm::vec2(0.f, 1.f);
+   glm::vec2 p11 = glm::vec2(1.f, 1.f);
+
+   glm::vec2 pos = glm::vec2(x_reg, y_reg);
+
+   float d00 = glm::length(p00 - pos);
+   float d01 = glm::length(p01 - pos);
+   float d10 = glm::length(p10 - pos);
+   float d11 = glm::length(p11 - pos);
+
+   return glm::clamp(1.f - d00, 0.f, 1.f) * v00 +
+          glm::clamp(1.f - d01, 0.f, 1.f) * v01 +
+          glm::clamp(1.f - d10, 0.f, 1.f) * v10 +
+          glm::clamp(1.f - d11, 0.f, 1.f) * v11;
+}
+
+float windHeight(const Raster<glm::float32> &alttitudeMap,
+                 const glm::vec2 &p) {
+   return -2.0 - alttitudeMap.sample(alttitudeMap.width() - p.x, p.y);
+}
+
+bool insideMap(const glm::vec2 &p, uint32_t xn, uint32_t yn) {
+   return !(p.x > xn - 1 || p.x < 0 || p.y > yn - 1 || p.y < 0);
+}
+
+// Empty, lines run their whole length.
+using StopTest = std::function<bool(const glm::vec2 &)>;
+
+// A direction of -1 traces against the wind.
+void traceEuler(const glm::vec3 &seed,
+                const Raster<glm::float32> &alttitudeMap,
+                const Raster<glm::vec2> &wind_speed, float min,
+                float spread, float direction, const StopTest &stop,
+                std::vector<LveWind::Vertex> &vertices) {
+   using Vertex = LveWind::Vertex;
+   const uint32_t xn = alttitudeMap.width();
+   const uint32_t yn = alttitudeMap.height();
+
+   size_t begin = vertices.size();
+   vertices.push_back({.position = seed, .speed = 0.f});
+   bool adentro = true;
+   while (adentro && vertices.size() - begin < max_samples) {
+      Vertex &vertex = vertices.back();
+      glm::vec2 p(vertex.position.x, vertex.position.z);
+      vertex.position.y = windHeight(alttitudeMap, p);
+
+      glm::vec2 moveDir = windAt(wind_speed, xn, yn, p);
+      float amount = glm::length(moveDir);
+      vertex.speed = (amount - min) / spread;
+
+      Vertex next_vertex = vertex;
+      moveDir *= direction * moveSpeed;
+      next_vertex.position.x += moveDir.x;
+      next_vertex.position.z += moveDir.y;
+
+      glm::vec2 next(next_vertex.position.x, next_vertex.position.z);
+      if (!insideMap(next, xn, yn) || (stop && stop(next))) {
+         adentro = false;
+      } else {
+         vertices.push_back(next_vertex);
+      }
+   }
+}
+
+float turnAngle(const glm::vec2 &a, const glm::vec2 &b) {
+   return std::fabs(std::atan2(a.x * b.y - a.y * b.x, glm::dot(a, b)));
+}
+
+// t is the parameter of the closest point along ab.
+float segmentDistance(const glm::vec3 &p, const glm::vec3 &a,
+                      const glm::vec3 &b, float &t) {
+   glm::vec3 ab = b - a;
+   float length2 = glm::dot(ab, ab);
+   t = length2 > 0.f
+           ? glm::clamp(glm::dot(p - a, ab) / length2, 0.f, 1.f)
+           : 0.f;
+   return glm::length(p - (a + t * ab));
+}
+
+// The ends of the line from begin on stay.
+void decimate(std::vector<LveWind::Vertex> &vertices, size_t begin) {
+   size_t end = vertices.size();
+   if (end - begin < 3) return;
+   // Compacts in place: out never passes the anchor.
+   size_t anchor = begin;
+   size_t out = begin + 1;
+   for (size_t i = begin + 1; i + 1 < end; ++i) {
+      const glm::vec3 &a = vertices[anchor].position;
+      const glm::vec3 &b = vertices[i + 1].position;
+      bool drop = i - anchor < decimate_span;
+      for (size_t j = anchor + 1; drop && j <= i; ++j) {
+         float t;
+         float distance = segmentDistance(vertices[j].position, a, b, t);
+         float from = vertices[anchor].speed;
+         float speed = from + t * (vertices[i + 1].speed - from);
+         drop = distance <= decimate_distance &&
+                std::fabs(speed - vertices[j].speed) <= decimate_speed;
+      }
+      if (drop) continue;
+      vertices[out] = vertices[i];
+      anchor = i;
+      ++out;
+   }
+   vertices[out] = vertices[end - 1];
+   vertices.resize(out + 1);
+}
+
+// Dormand-Prince RK45. Steps are never shorter than an Euler step.
+void traceAdaptive(const glm::vec3 &seed,
+                   const Raster<glm::float32> &alttitudeMap,
+                   const Raster<glm::vec2> &wind_speed, float min,
+                   float spread, float direction, const StopTest &stop,
+                   std::vector<LveWind::Vertex> &vertices) {
+   const uint32_t xn = alttitudeMap.width();
+   const uint32_t yn = alttitudeMap.height();
+   const glm::vec2 last(xn - 1, yn - 1);
+   // Stages may sample a little past the border.
+   auto velocity = [&](const glm::vec2 &p) {
+      return direction *
+             windAt(wind_speed, xn, yn, glm::clamp(p, glm::vec2(0), last));
+   };
+   auto emit = [&](const glm::vec2 &p, const glm::vec2 &v) {
+      vertices.push_back(
+          {.position = glm::vec3(p.x, windHeight(alttitudeMap, p), p.y),
+           .speed = (glm::length(v) - min) / spread});
+   };
+
+   const float duration = max_samples * moveSpeed;
+   size_t begin = vertices.size();
+   glm::vec2 p(seed.x, seed.z);
+   glm::vec2 v = velocity(p);
+   emit(p, v);
+   float t = 0.f;
+   float h = moveSpeed;
+   while (t < duration && vertices.size() - begin < max_samples) {
+      float speed = glm::length(v);
+      if (speed * moveSpeed < step_tolerance) break;
+      h = glm::clamp(std::min(h, max_segment / speed), moveSpeed,
+                     duration - t);
+
+      glm::vec2 k1 = v;
+      glm::vec2 k2 = velocity(p + h * (k1 / 5.f));
+      glm::vec2 k3 = velocity(p + h * (3.f / 40.f * k1 + 9.f / 40.f * k2));
+      glm::vec2 k4 = velocity(
+          p + h * (44.f / 45.f * k1 - 56.f / 15.f * k2 + 32.f / 9.f * k3));
+      glm::vec2 k5 = velocity(
+          p + h * (19372.f / 6561.f * k1 - 25360.f / 2187.f * k2 +
+                   64448.f / 6561.f * k3 - 212.f / 729.f * k4));
+      glm::vec2 k6 = velocity(
+          p + h * (9017.f / 3168.f * k1 - 355.f / 33.f * k2 +
+                   46732.f / 5247.f * k3 + 49.f / 176.f * k4 -
+                   5103.f / 18656.f * k5));
+      glm::vec2 next =
+          p + h * (35.f / 384.f * k1 + 500.f / 1113.f * k3 +
+                   125.f / 192.f * k4 - 2187.f / 6784.f * k5 +
+                   11.f / 84.f * k6);
+      // Also the next step's k1.
+      glm::vec2 k7 = velocity(next);
+      float error = glm::length(
+          h * (71.f / 57600.f * k1 - 71.f / 16695.f * k3 +
+               71.f / 1920.f * k4 - 17253.f / 339200.f * k5 +
+               22.f / 525.f * k6 - 1.f / 40.f * k7));
+      float turn = turnAngle(k1, k7);
+
+      bool shortest = h <= moveSpeed;
+      if (!shortest && (error > step_tolerance || turn > max_turn)) {
+         float shrink = 0.5f;
+         if (error > step_tolerance) {
+            shrink = std::min(shrink, 0.9f * std::pow(step_tolerance /
+                                                          error,
+                                                      0.2f));
+         }
+         h *= std::max(shrink, 0.2f);
+         continue;
+      }
+
+      if (!insideMap(next, xn, yn) || (stop && stop(next))) break;
+      t += h;
+      p = next;
+      v = k7;
+      emit(p, v);
+      float grow = error > 0.f
+                       ? 0.9f * std::pow(step_tolerance / error, 0.2f)
+                       : 5.f;
+      h *= glm::clamp(grow, 1.f, 5.f);
+   }
+   decimate(vertices, begin);
+}
+
+struct Arena {
+   std::vector<LveWind::Vertex> vertices;
+};
+
+struct Line {
+   unsigned worker;
+   size_t first;
+   size_t count;
+};
+
+using Trace = void (*)(const glm::vec3 &, const Raster<glm::float32> &,
+                       const Raster<glm::vec2> &, float, float, float,
+                       const StopTest &, std::vector<LveWind::Vertex> &);
+
+// Points of the traced lines, bucketed in cells of side `cell`.
+class Occupancy {
+  public:
+   Occupancy(uint32_t xn, uint32_t yn, float cell)
+       : cell{cell},
+         columns{static_cast<int64_t>(xn / cell) + 1},
+         rows{static_cast<int64_t>(yn / cell) + 1},
+         buckets(static_cast<size_t>(columns * rows)) {
+   }
+
+   // p must be inside the map.
+   void add(const glm::vec2 &p) {
+      buckets[row(p) * columns + column(p)].push_back(p);
+   }
+
+   // radius must not exceed cell.
+   bool near(const glm::vec2 &p, float radius) const {
+      int64_t c = column(p);
+      int64_t r = row(p);
+      float radius2 = radius * radius;
+      for (int64_t br = std::max<int64_t>(r - 1, 0);
+           br <= std::min(r + 1, rows - 1); ++br) {
+         for (int64_t bc = std::max<int64_t>(c - 1, 0);
+              bc <= std::min(c + 1, columns - 1); ++bc) {
+            for (const glm::vec2 &q : buckets[br * columns + bc]) {
+               glm::vec2 d = q - p;
+               if (glm::dot(d, d) < radius2) return true;
+            }
+         }
+      }
+      return false;
+   }
+
+  private:
+   int64_t column(const glm::vec2 &p) const {
+      return static_cast<int64_t>(p.x / cell);
+   }
+   int64_t row(const glm::vec2 &p) const {
+      return static_cast<int64_t>(p.y / cell);
+   }
+
+   float cell;
+   int64_t columns;
+   int64_t rows;
+   std::vector<std::vector<glm::vec2>> buckets;
+};
+
+// Jobard and Lefer's evenly spaced streamlines, all in worker 0's arena.
+void traceEvenlySpaced(Trace trace,
+                       const Raster<glm::float32> &alttitudeMap,
+                       const Raster<glm::vec2> &wind_speed, float min,
+                       float spread, float separation, Arena &arena,
+                       std::vector<Line> &lines) {
+   const uint32_t xn = alttitudeMap.width();
+   const uint32_t yn = alttitudeMap.height();
+   const float test = separation_test * separation;
+   // Lines closer than 3/4 of test always find a mark.
+   const float mark = test / 2.f;
+   Occupancy occupancy(xn, yn, separation);
+   StopTest stop = [&](const glm::vec2 &p) {
+      return occupancy.near(p, test);
+   };
+   auto at = [&](size_t i) {
+      const glm::vec3 &p = arena.vertices[i].position;
+      return glm::vec2(p.x, p.z);
+   };
+
+   std::deque<size_t> pending;
+   auto tryLine = [&](const glm::vec2 &seed) {
+      if (!insideMap(seed, xn, yn) || occupancy.near(seed, separation)) {
+         return;
+      }
+      // Against the wind, reversed, then with it, the seed kept once.
+      size_t begin = arena.vertices.size();
+      glm::vec3 start(seed.x, 0.f, seed.y);
+      trace(start, alttitudeMap, wind_speed, min, spread, -1.f, stop,
+            arena.vertices);
+      std::reverse(arena.vertices.begin() + begin, arena.vertices.end());
+      size_t middle = arena.vertices.size() - 1;
+      trace(start, alttitudeMap, wind_speed, min, spread, 1.f, stop,
+            arena.vertices);
+      arena.vertices.erase(arena.vertices.begin() + middle);
+
+      size_t end = arena.vertices.size();
+      if (end - begin < 2) {
+         // No wind at the seed.
+         arena.vertices.resize(begin);
+         return;
+      }
+      for (size_t i = begin; i + 1 < end; ++i) {
+         glm::vec2 a = at(i);
+         glm::vec2 b = at(i + 1);
+         float steps = std::ceil(glm::length(b - a) / mark);
+         for (float k = 0.f; k < steps; ++k) {
+            occupancy.add(a + (b - a) * (k / steps));
+         }
+      }
+      occupancy.add(at(end - 1));
+      pending.push_back(lines.size());
+      lines.push_back({0, begin, end - begin});
+   };
+
+   std::vector<glm::vec2> points;
+   auto seedAround = [&](const Line &line) {
+      // Copied, new lines grow the arena.
+      points.clear();
+      for (size_t i = line.first; i < line.first + line.count; ++i) {
+         points.push_back(at(i));
+      }
+      float along = separation;
+      for (size_t i = 0; i + 1 < points.size(); ++i) {
+         glm::vec2 d = points[i + 1] - points[i];
+         float length = glm::length(d);
+         if (length == 0.f) continue;
+         glm::vec2 side = glm::vec2(-d.y, d.x) * (separation / length);
+         float s = separation - along;
+         for (; s <= length; s += separation) {
+            glm::vec2 p = points[i] + d * (s / length);
+            tryLine(p + side);
+            tryLine(p - side);
+         }
+         along = length - (s - separation);
+      }
+   };
+
+   for (float y = 0.f; y <= yn - 1.f; y += separation) {
+      for (float x = 0.f; x <= xn - 1.f; x += separation) {
+         tryLine({x, y});
+         while (!pending.empty()) {
+            Line line = lines[pending.front()];
+            pending.pop_front();
+            seedAround(line);
+         }
+      }
+   }
+}
+
+}  // namespace
+
 LveWind::LveWind(LveDevice &device, const LveWind::Builder &builder)
     : lveDevice{device} {
    createVertexBuffers(builder.vertices);
    createIndexBuffers(builder.indices);
 }
 
+LveWind::LveWind(LveDevice &device, uint32_t lines, uint32_t lineCapacity)
+    : lveDevice{device}, indexCount{0}, drawCount{lines} {
+   vertexCount = lines * lineCapacity;
+   vertexBuffer = std::make_unique<LveBuffer>(
+       lveDevice, sizeof(Vertex), std::max(vertexCount, 1u),
+       VK_BUFFER_USAGE_VERTEX_BUFFER_BIT |
+           VK_BUFFER_USAGE_STORAGE_BUFFER_BIT |
+           VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+       VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+   drawBuffer = std::make_unique<LveBuffer>(
+       lveDevice, sizeof(VkDrawIndirectCommand), std::max(lines, 1u),
+       VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT |
+           VK_BUFFER_USAGE_STORAGE_BUFFER_BIT |
+           VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+       VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+}
+
 LveWind::~LveWind() {
 }
 
 std::unique_ptr<LveWind> LveWind::createModelFromMesh(
-    LveDevice &device,
-    const std::vector<std::vector<glm::float32>> &alttitudeMap,
-    const std::vector<std::vector<glm::vec2>> &wind_speed, float min,
-    float max, const size_t paleta) {
+    LveDevice &device, const Raster<glm::float32> &alttitudeMap,
+    const Raster<glm::vec2> &wind_speed, float min, float max) {
    Builder builder{};
-   builder.generateMesh(alttitudeMap, wind_speed, min, max, paleta);
+   builder.generateMesh(alttitudeMap, wind_speed, min, max);
 
    return std::make_unique<LveWind>(device, builder);
 }
@@ -77,8 +472,17 @@ void LveWind::createIndexBuffers(const std::vector<uint32_t> &indices) {
 
    if (!hasIndexBuffer) return;
 
-   VkDeviceSize bufferSize = sizeof(indices[0]) * indexCount;
+   // Restarts become 0xFFFF in 16 bits.
+   indexType = indexTypeFor(indices);
+   std::vector<uint16_t> narrow;
+   const void *data = indices.data();
    uint32_t indexSize = sizeof(indices[0]);
+   if (indexType == VK_INDEX_TYPE_UINT16) {
+      narrow = narrowIndices(indices);
+      data = narrow.data();
+      indexSize = sizeof(narrow[0]);
+   }
+   VkDeviceSize bufferSize = indexSize * indexCount;
 
    LveBuffer stagingBuffer{
        lveDevice,
@@ -90,7 +494,7 @@ void LveWind::createIndexBuffers(const std::vector<uint32_t> &indices) {
    };
 
    stagingBuffer.map();
-   stagingBuffer.writeToBuffer((void *)indices.data());
+   stagingBuffer.writeToBuffer(const_cast<void *>(data));
 
    indexBuffer = std::make_unique<LveBuffer>(
        lveDevice, indexSize, indexCount,
@@ -101,7 +505,29 @@ void LveWind::createIndexBuffers(const std::vector<uint32_t> &indices) {
                         indexBuffer->getBuffer(), bufferSize);
 }
 
+VkDescriptorBufferInfo LveWind::vertexInfo() {
+   return vertexBuffer->descriptorInfo();
+}
+
+VkDescriptorBufferInfo LveWind::drawInfo() {
+   return drawBuffer->descriptorInfo();
+}
+
 void LveWind::draw(VkCommandBuffer commandBuffer) {
+   if (drawBuffer) {
+      // Without multiDrawIndirect each line is a call of its own.
+      uint32_t stride = sizeof(VkDrawIndirectCommand);
+      if (lveDevice.features.multiDrawIndirect) {
+         vkCmdDrawIndirect(commandBuffer, drawBuffer->getBuffer(), 0,
+                           drawCount, stride);
+         return;
+      }
+      for (uint32_t l = 0; l < drawCount; ++l) {
+         vkCmdDrawIndirect(commandBuffer, drawBuffer->getBuffer(),
+                           l * stride, 1, stride);
+      }
+      return;
+   }
    if (hasIndexBuffer) {
       vkCmdDrawIndexed(commandBuffer, indexCount, 1, 0, 0, 0);
    } else {
@@ -116,7 +542,7 @@ void LveWind::bind(VkCommandBuffer commandBuffer) {
 
    if (hasIndexBuffer) {
       vkCmdBindIndexBuffer(commandBuffer, indexBuffer->getBuffer(), 0,
-                           VK_INDEX_TYPE_UINT32);
+                           indexType);
    }
 }
 
@@ -136,140 +562,77 @@ LveWind::Vertex::getAttributeDescriptions() {
    attributeDescriptions.push_back(
        {0, 0, VK_FORMAT_R32G32B32_SFLOAT, offsetof(Vertex, position)});
    attributeDescriptions.push_back(
-       {1, 0, VK_FORMAT_R32G32B32_SFLOAT, offsetof(Vertex, color)});
+       {1, 0, VK_FORMAT_R32_SFLOAT, offsetof(Vertex, speed)});
 
    return attributeDescriptions;
 }
 
 void LveWind::Builder::generateMesh(
-    const std::vector<std::vector<glm::float32>> &alttitudeMap,
-    const std::vector<std::vector<glm::vec2>> &wind_speed, float min,
-    float max, const size_t paleta) {
+    const Raster<glm::float32> &alttitudeMap,
+    const Raster<glm::vec2> &wind_speed, float min, float max,
+    unsigned threads) {
    vertices.clear();
    indices.clear();
 
-   const uint32_t xn = alttitudeMap[0].size();
-   const uint32_t yn = alttitudeMap.size();
+   const uint32_t xn = alttitudeMap.width();
+   const uint32_t yn = alttitudeMap.height();
 
-   const uint32_t spacing = 20;
+   const uint32_t spacing = seedSpacing;
 
    const float spread = max - min;
 
-   std::vector<std::vector<Vertex>> lines;
-   for (size_t y = 0; y < yn; y += spacing) {
-      for (size_t x = 0; x < xn; x += spacing) {
-         std::vector<Vertex> interno;
-         Vertex vertex = {.position = glm::vec3(x, 0, y),
-                          .color = glm::vec3(0)};
-         interno.push_back(vertex);
-         lines.push_back(interno);
+   Trace trace = integrator == Integrator::Euler ? traceEuler
+                                                 : traceAdaptive;
+   std::vector<Arena> arenas(workerCount(threads));
+   std::vector<Line> lines;
+   if (seeding == Seeding::EvenlySpaced) {
+      // Also rejects NaN.
+      float apart = separation > 0.f ? separation : defaultSeparation;
+      traceEvenlySpaced(trace, alttitudeMap, wind_speed, min, spread,
+                        apart, arenas[0], lines);
+   } else {
+      std::vector<glm::vec3> seeds;
+      for (size_t y = 0; y < yn; y += spacing) {
+         for (size_t x = 0; x < xn; x += spacing) {
+            seeds.push_back(glm::vec3(x, 0, y));
+         }
       }
-   }
 
-   const size_t max_samples = 10000;
-
-   colormap::colormap_t *color_map = colormap::colormap(paleta);
-   std::vector<std::future<void>> line_joins;
-   for (std::vector<Vertex> &line : lines) {
-      line_joins.push_back(std::async(
-          std::launch::async, [&line, xn, yn, &alttitudeMap, &wind_speed,
-                               min, spread, color_map] {
-             bool adentro = true;
-             while (adentro && line.size() < max_samples) {
-                Vertex &vertex = line.back();
-
-                uint32_t x0 =
-                    glm::clamp(xn - (uint32_t)floorf(vertex.position.x),
-                               (uint32_t)0, xn - 1);
-                uint32_t y0 =
-                    glm::clamp((uint32_t)floorf(vertex.position.z),
-                               (uint32_t)0, yn - 1);
-
-                uint32_t x1 =
-                    glm::clamp(xn - (uint32_t)ceilf(vertex.position.x),
-                               (uint32_t)0, xn - 1);
-                uint32_t y1 =
-                    glm::clamp((uint32_t)ceilf(vertex.position.z),
-                               (uint32_t)0, yn - 1);
-
-                float x_reg = glm::fract(vertex.position.x);
-                float y_reg = glm::fract(vertex.position.z);
-
-                float z00 = alttitudeMap[y0][x0];
-                float z01 = alttitudeMap[y0][x1];
-                float z10 = alttitudeMap[y1][x0];
-
-                float wind_heigth = -2.0 - (z00 + x_reg * (z01 - z00) +
-                                            y_reg * (z10 - z00));
-                vertex.position.y = wind_heigth;
-
-                glm::vec2 v00 = wind_speed[y0][x0];
-                glm::vec2 v01 = wind_speed[y0][x1];
-                glm::vec2 v10 = wind_speed[y1][x0];
-                glm::vec2 v11 = wind_speed[y1][x1];
-
-                glm::vec2 p00 = glm::vec2(0.f, 0.f);
-                glm::vec2 p01 = glm::vec2(1.f, 0.f);
-                glm::vec2 p10 = glm::vec2(0.f, 1.f);
-                glm::vec2 p11 = glm::vec2(1.f, 1.f);
-
-                glm::vec2 pos = glm::vec2(x_reg, y_reg);
-
-                float d00 = glm::length(p00 - pos);
-                float d01 = glm::length(p01 - pos);
-                float d10 = glm::length(p10 - pos);
-                float d11 = glm::length(p11 - pos);
-
-                glm::vec2 moveDir = glm::clamp(1.f - d00, 0.f, 1.f) * v00 +
-                                    glm::clamp(1.f - d01, 0.f, 1.f) * v01 +
-                                    glm::clamp(1.f - d10, 0.f, 1.f) * v10 +
-                                    glm::clamp(1.f - d11, 0.f, 1.f) * v11;
-
-                float amount = glm::length(moveDir);
-                float norm_amount = ((amount - min) / spread);
-                size_t last = colormap::color_points - 1;
-                float color_index = last * norm_amount;
-                size_t floor = floorf(color_index);
-                if (floor == last) {
-                   vertex.color = (*color_map)[last];
-                } else {
-                   size_t ceil = ceilf(color_index);
-                   float frac = glm::fract(color_index);
-                   auto floor_color = (*color_map)[floor];
-                   auto ceil_color = (*color_map)[ceil];
-                   vertex.color =
-                       ceil_color * frac + floor_color * (1.f - frac);
-                }
-
-                Vertex next_vertex = vertex;
-                const float moveSpeed = 0.01;
-                moveDir *= moveSpeed;
-                next_vertex.position.x += moveDir.x;
-                next_vertex.position.z += moveDir.y;
-
-                if (next_vertex.position.x > xn - 1 ||
-                    next_vertex.position.x < 0 ||
-                    next_vertex.position.z > yn - 1 ||
-                    next_vertex.position.z < 0) {
-                   adentro = false;
-                } else {
-                   line.push_back(next_vertex);
-                }
+      lines.resize(seeds.size());
+      parallelForDynamic(
+          seeds.size(), threads, 1,
+          [&](unsigned worker, size_t first, size_t last) {
+             Arena &arena = arenas[worker];
+             for (size_t l = first; l < last; ++l) {
+                size_t begin = arena.vertices.size();
+                trace(seeds[l], alttitudeMap, wind_speed, min, spread,
+                      1.f, {}, arena.vertices);
+                lines[l] = {worker, begin,
+                            arena.vertices.size() - begin};
              }
-          }));
+          });
    }
-   size_t index = 0;
-   for (std::future<void> &join : line_joins) {
-      join.wait();
+
+   // Same line order for any thread count.
+   std::vector<size_t> offsets(lines.size() + 1, 0);
+   for (size_t l = 0; l < lines.size(); ++l) {
+      offsets[l + 1] = offsets[l] + lines[l].count;
    }
-   for (std::vector<Vertex> line : lines) {
-      for (Vertex vertex : line) {
-         vertices.push_back(vertex);
-         indices.push_back(index);
-         ++index;
+   vertices.resize(offsets.back());
+   indices.resize(offsets.back() + lines.size());
+   parallelFor(lines.size(), threads, [&](size_t first, size_t last) {
+      for (size_t l = first; l < last; ++l) {
+         const Line &line = lines[l];
+         const Arena &arena = arenas[line.worker];
+         std::copy_n(arena.vertices.begin() + line.first, line.count,
+                     vertices.begin() + offsets[l]);
+         uint32_t *out = indices.data() + offsets[l] + l;
+         for (size_t i = 0; i < line.count; ++i) {
+            *out++ = static_cast<uint32_t>(offsets[l] + i);
+         }
+         *out = 0xFFFFFFFF;
       }
-      indices.push_back(0xFFFFFFFF);
-   }
+   });
 }
 
 }  // namespace lve
@@ -6,6 +6,7 @@
 
 #include "lve_buffer.hpp"
 #include "lve_device.hpp"
+#include "lve_raster.hpp"
 
 #define GLM_FORCE_RADIANS
 #define GLM_FORCE_DEPTH_ZERO_TO_ONE
@@ -15,9 +16,11 @@ namespace lve {
 
 class LveWind {
   public:
+   // The shader colors by speed from an LvePalette.
    struct Vertex {
       glm::vec3 position{};
-      glm::vec3 color{};
+      // Normalised over [min, max].
+      glm::float32 speed{};
 
       static std::vector<VkVertexInputBindingDescription>
       getBindingDescriptions();
@@ -25,31 +28,58 @@ class LveWind {
       getAttributeDescriptions();
    };
 
+   // Adaptive is RK45 plus decimation of straight runs.
+   enum class Integrator {
+      Euler,
+      Adaptive,
+   };
+
+   // EvenlySpaced runs on a single thread.
+   enum class Seeding {
+      Grid,
+      EvenlySpaced,
+   };
+
+   static constexpr uint32_t seedSpacing = 20;
+   // Also replaces a separation that isn't positive.
+   static constexpr float defaultSeparation = 10.f;
+
    struct Builder {
+      Integrator integrator = Integrator::Adaptive;
+      Seeding seeding = Seeding::EvenlySpaced;
+      float separation = defaultSeparation;
       std::vector<Vertex> vertices{};
       std::vector<uint32_t> indices{};
 
-      void generateMesh(
-          const std::vector<std::vector<glm::float32>> &alttitudeMap,
-          const std::vector<std::vector<glm::vec2>> &wind_speed, float min,
-          float max, const size_t paleta);
+      // threads = 0 uses one per hardware thread.
+      void generateMesh(const Raster<glm::float32> &alttitudeMap,
+                        const Raster<glm::vec2> &wind_speed, float min,
+                        float max, unsigned threads = 0);
    };
 
    LveWind(LveDevice &device, const LveWind::Builder &builder);
+   // For WindTraceSystem: line l starts at vertex l * lineCapacity.
+   LveWind(LveDevice &device, uint32_t lines, uint32_t lineCapacity);
    ~LveWind();
 
    LveWind(const LveWind &) = delete;
    LveWind &operator=(const LveWind &) = delete;
 
    static std::unique_ptr<LveWind> createModelFromMesh(
-       LveDevice &device,
-       const std::vector<std::vector<glm::float32>> &alttitudeMap,
-       const std::vector<std::vector<glm::vec2>> &wind_speed, float min,
-       float max, const size_t paleta);
+       LveDevice &device, const Raster<glm::float32> &alttitudeMap,
+       const Raster<glm::vec2> &wind_speed, float min, float max);
+
+   // Buffers of the lines traced on the GPU, for the tracing shader.
+   VkDescriptorBufferInfo vertexInfo();
+   VkDescriptorBufferInfo drawInfo();
 
    void bind(VkCommandBuffer commandBuffer);
    void draw(VkCommandBuffer commandBuffer);
 
+   VkIndexType getIndexType() const {
+      return indexType;
+   }
+
   private:
    void createVertexBuffers(const std::vector<Vertex> &vertices);
    void createIndexBuffers(const std::vector<uint32_t> &indices);
@@ -62,8 +92,11 @@ class LveWind {
    bool hasIndexBuffer = false;
    std::unique_ptr<LveBuffer> indexBuffer;
    uint32_t indexCount;
+   VkIndexType indexType = VK_INDEX_TYPE_UINT32;
 
-   static glm::vec3 color(float amount);
+   // One VkDrawIndirectCommand per GPU traced line.
+   std::unique_ptr<LveBuffer> drawBuffer;
+   uint32_t drawCount = 0;
 };
 
 }  // namespace lve
@@ -13,8 +13,8 @@ namespace lve {
 
 void TerrainMovementController::moveInPlaneXZ(
     GLFWwindow* window, float dt, LveGameObject& gameObject,
-    std::vector<std::vector<glm::float32>>& altitudeMap,
-    float cameraHeight, bool caminata) {
+    const Raster<glm::float32>& altitudeMap, float cameraHeight,
+    bool caminata) {
    int state = glfwGetMouseButton(window, GLFW_MOUSE_BUTTON_RIGHT);
    if (state == GLFW_PRESS && !changedMouse) {
       int cursor_mode =
@@ -81,12 +81,12 @@ void TerrainMovementController::moveInPlaneXZ(
          moveDir -= upDir;
       }
 
-      uint32_t yn = altitudeMap.size();
+      uint32_t yn = altitudeMap.height();
       if (!yn) {
          return;
       }
 
-      uint32_t xn = altitudeMap[0].size();
+      uint32_t xn = altitudeMap.width();
       if (!xn) {
          return;
       }
@@ -99,7 +99,7 @@ void TerrainMovementController::moveInPlaneXZ(
                      (uint32_t)0, yn - 1);
 
       float roof = fmin(xn, yn);
-      float floor = altitudeMap[y][x];
+      float floor = altitudeMap(x, y);
 
       float moveSpeed =
           moveSpeedMin +
@@ -112,29 +112,10 @@ void TerrainMovementController::moveInPlaneXZ(
              moveSpeed * dt * glm::normalize(moveDir);
       }
 
-      uint32_t x0 = glm::clamp(
-          xn - (uint32_t)floorf(gameObject.transform.translation.x),
-          (uint32_t)0, xn - 1);
-      uint32_t y0 =
-          glm::clamp((uint32_t)floorf(gameObject.transform.translation.z),
-                     (uint32_t)0, yn - 1);
-
-      uint32_t x1 = glm::clamp(
-          xn - (uint32_t)ceilf(gameObject.transform.translation.x),
-          (uint32_t)0, xn - 1);
-      uint32_t y1 =
-          glm::clamp((uint32_t)ceilf(gameObject.transform.translation.z),
-                     (uint32_t)0, yn - 1);
-
-      float x_reg = glm::fract(gameObject.transform.translation.x);
-      float y_reg = glm::fract(gameObject.transform.translation.z);
-
-      float z00 = altitudeMap[y0][x0];
-      float z01 = altitudeMap[y0][x1];
-      float z10 = altitudeMap[y1][x0];
-
-      float cam_floor = -cameraHeight -
-                        (z00 + x_reg * (z01 - z00) + y_reg * (z10 - z00));
+      float cam_floor =
+          -cameraHeight -
+          altitudeMap.sample(xn - gameObject.transform.translation.x,
+                             gameObject.transform.translation.z);
       float cam_roof = caminata ? cam_floor - 0.1 : -roof;
       gameObject.transform.translation = glm::clamp(
           gameObject.transform.translation, glm::vec3{0.f, cam_roof, 0.f},
@@ -5,6 +5,7 @@
 #include <vector>
 
 #include "../lve/lve_game_object.hpp"
+#include "../lve/lve_raster.hpp"
 
 namespace lve {
 
@@ -25,7 +26,7 @@ class TerrainMovementController {
 
    void moveInPlaneXZ(GLFWwindow* window, float dt,
                       LveGameObject& gameObject,
-                      std::vector<std::vector<glm::float32>>& altitudeMap,
+                      const Raster<glm::float32>& altitudeMap,
                       float cameraHeight, bool caminata);
 
    KeyMappings keys{};
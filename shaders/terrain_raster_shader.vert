@@ -0,0 +1,76 @@
+#version 450
+
+layout(location = 0) out vec3 fragColor;
+layout(location = 1) out vec3 fragPosWorld;
+layout(location = 2) out vec3 fragNormalWorld;
+
+layout(set = 0, binding = 0) uniform GloablUbo {
+   mat4 projection;
+   mat4 view;
+   vec4 ambientLightColor;
+	vec3 lightPosition;
+	uint cols;
+	uint time;
+}
+ubo;
+
+// Vertex altitudes, in vertex order.
+layout(set = 1, binding = 0) readonly buffer Alttitude {
+   float alttitude[];
+};
+
+// Vegetation class of each vertex, two 16-bit classes per word.
+layout(set = 1, binding = 1) readonly buffer Vegetation {
+   uint vegetation[];
+};
+
+layout(set = 1, binding = 2) readonly buffer Palette {
+   vec4 palette[];
+};
+
+layout(push_constant) uniform Push {
+   mat4 modelMatrix;
+   mat4 normalMatrix;
+}
+push;
+
+// Point of the map at vertex column c and row r. Vertex columns run in
+// reverse map x, and the vertex altitude is minus the map height.
+vec3 mapPoint(uint c, uint r) {
+   return vec3(float(ubo.cols - 1u - c), float(r),
+               -alttitude[r * ubo.cols + c]);
+}
+
+void main() {
+   uint index = uint(gl_VertexIndex);
+   uint cols = ubo.cols;
+   uint rows = uint(alttitude.length()) / cols;
+   uint c = index % cols;
+   uint r = index / cols;
+
+	vec3 position = vec3(c, alttitude[index], r);
+   vec4 positionWorld = push.modelMatrix * vec4(position ,1.0);
+
+   gl_Position = ubo.projection * ubo.view * positionWorld;
+
+   // Same normal as the one the CPU builds for the other formats: the
+   // average of the cross products of the four edges around the vertex,
+   // clamped at the borders of the map.
+   uint cs = c == 0u ? c : c - 1u;
+   uint ca = c == cols - 1u ? c : c + 1u;
+   uint rs = r == rows - 1u ? r : r + 1u;
+   uint ra = r == 0u ? r : r - 1u;
+   vec3 p = mapPoint(c, r);
+   vec3 a = p - mapPoint(c, rs);
+   vec3 b = p - mapPoint(cs, r);
+   vec3 d = p - mapPoint(c, ra);
+   vec3 e = p - mapPoint(ca, r);
+   vec3 normal = cross(a, b) + cross(b, d) + cross(d, e) + cross(e, a);
+
+   uint vegetationClass =
+       (vegetation[index / 2u] >> (16u * (index % 2u))) & 0xffffu;
+
+   fragNormalWorld = normalize(mat3(push.normalMatrix) * normal);
+   fragPosWorld = positionWorld.xyz;
+   fragColor = palette[vegetationClass].rgb;
+}
@@ -1,5 +1,9 @@
 #version 450
 
+// With the compact vertex formats the normal arrives octahedral-encoded
+// in normal.xy, and the altitude already scaled by modelMatrix.
+layout(constant_id = 0) const bool COMPACT_NORMAL = false;
+
 layout(location = 0) in float altittude;
 layout(location = 1) in vec3 color;
 layout(location = 2) in vec3 normal;
@@ -24,6 +28,14 @@ layout(push_constant) uniform Push {
 }
 push;
 
+vec3 octDecode(vec2 e) {
+   vec3 n = vec3(e, 1.0 - abs(e.x) - abs(e.y));
+   float t = max(-n.z, 0.0);
+   n.x += n.x >= 0.0 ? -t : t;
+   n.y += n.y >= 0.0 ? -t : t;
+   return n;
+}
+
 void main() {
 	float x = mod(gl_VertexIndex, ubo.cols);
 	float y = floor(gl_VertexIndex/ubo.cols);
@@ -32,7 +44,8 @@ void main() {
 
    gl_Position = ubo.projection * ubo.view * positionWorld;
 
-   fragNormalWorld = normalize(mat3(push.normalMatrix) * normal);
-   fragPosWorld = position;
+   vec3 vertexNormal = COMPACT_NORMAL ? octDecode(normal.xy) : normal;
+   fragNormalWorld = normalize(mat3(push.normalMatrix) * vertexNormal);
+   fragPosWorld = positionWorld.xyz;
    fragColor = color;
 }
@@ -0,0 +1,53 @@
+#version 450
+
+// Two vertices per wind particle, a line from the tail of its streak to
+// its head, colored by the wind speed and brighter at the head.
+
+layout(location = 0) out vec3 fragColor;
+
+layout(set = 0, binding = 0) uniform GloablUbo {
+   mat4 projection;
+   mat4 view;
+   vec4 ambientLightColor;
+	vec3 lightPosition;
+	uint cols;
+	uint time;
+}
+ubo;
+
+struct Particle {
+   vec4 head;
+   vec4 tail;
+};
+
+layout(set = 1, binding = 0) readonly buffer Particles {
+   Particle particles[];
+};
+
+// LvePalette.
+layout(set = 1, binding = 1) uniform sampler1D palette;
+
+layout(push_constant) uniform Push {
+   mat4 modelMatrix;
+   mat4 normalMatrix;
+}
+push;
+
+// speedColor of wind_shader.vert.
+vec3 speedColor(float norm_amount) {
+   float size = float(textureSize(palette, 0));
+   return texture(palette,
+                  (clamp(norm_amount, 0.0, 1.0) * (size - 1.0) + 0.5) /
+                      size).rgb;
+}
+
+void main() {
+   Particle particle = particles[gl_VertexIndex / 2];
+   bool head = (gl_VertexIndex & 1) == 1;
+   vec3 position = head ? particle.head.xyz : particle.tail.xyz;
+   vec4 positionWorld = push.modelMatrix * vec4(position, 1.0);
+
+   gl_Position = ubo.projection * ubo.view * positionWorld;
+
+   fragColor = speedColor(particle.tail.w) * (head ? 1.0 : 0.25);
+}
@@ -1,7 +1,7 @@
 #version 450
 
 layout(location = 0) in vec3 position;
-layout(location = 1) in vec3 color;
+layout(location = 1) in float speed;
 
 layout(location = 0) out vec3 fragColor;
 
@@ -15,17 +15,28 @@ layout(set = 0, binding = 0) uniform GloablUbo {
 }
 ubo;
 
+// LvePalette.
+layout(set = 1, binding = 0) uniform sampler1D palette;
+
 layout(push_constant) uniform Push {
    mat4 modelMatrix;
    mat4 normalMatrix;
 }
 push;
 
+// Color of a normalised speed, blending the nearest palette entries.
+vec3 speedColor(float norm_amount) {
+   float size = float(textureSize(palette, 0));
+   return texture(palette,
+                  (clamp(norm_amount, 0.0, 1.0) * (size - 1.0) + 0.5) /
+                      size).rgb;
+}
+
 void main() {
    vec4 positionWorld = push.modelMatrix * vec4(position ,1.0);
 
    gl_Position = ubo.projection * ubo.view * positionWorld;
 
 	float t = mod(ubo.time - gl_VertexIndex, 100) / 400.f;
-   fragColor = color * (1.f - t);
+   fragColor = speedColor(speed) * (1.f - t);
 }
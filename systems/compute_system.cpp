@@ -13,7 +13,7 @@ namespace lve {
 ComputeSystem::ComputeSystem(
     LveDevice &device,
     const std::vector<VkDescriptorSetLayout> desc_layout,
-    const std::string &compFilepath)
+    const std::string &compFilepath, uint32_t pushConstantSize)
     : lveDevice(device),
       CmdBuffer{},
       submitInfo{
@@ -26,7 +26,8 @@ ComputeSystem::ComputeSystem(
           .pCommandBuffers = &CmdBuffer,
           .signalSemaphoreCount = 0,
           .pSignalSemaphores = nullptr,
-      } {
+      },
+      pushConstantSize(pushConstantSize) {
    createFence();
    createPipelineLayout(desc_layout);
    createShaderModule(compFilepath);
@@ -59,8 +60,15 @@ void ComputeSystem::createPipelineLayout(
    pipelineLayoutCreateInfo.sType =
        VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
    pipelineLayoutCreateInfo.pNext = nullptr;
-   pipelineLayoutCreateInfo.pushConstantRangeCount = 0;
-   pipelineLayoutCreateInfo.pPushConstantRanges = nullptr;
+   VkPushConstantRange pushConstantRange = {
+       .stageFlags = VK_SHADER_STAGE_COMPUTE_BIT,
+       .offset = 0,
+       .size = pushConstantSize,
+   };
+   pipelineLayoutCreateInfo.pushConstantRangeCount =
+       pushConstantSize ? 1 : 0;
+   pipelineLayoutCreateInfo.pPushConstantRanges =
+       pushConstantSize ? &pushConstantRange : nullptr;
    pipelineLayoutCreateInfo.setLayoutCount = desc_layout.size();
    pipelineLayoutCreateInfo.pSetLayouts = desc_layout.data();
 
@@ -151,6 +159,36 @@ void ComputeSystem::await() {
                    uint64_t(-1));
 }
 
+void ComputeSystem::record(
+    VkCommandBuffer commandBuffer, uint32_t groupsX, uint32_t groupsY,
+    uint32_t groupsZ, const std::vector<VkDescriptorSet> &descriptorSets,
+    const void *pushData) {
+   vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE,
+                     this->computePipeline);
+   vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE,
+                           this->pipelineLayout, 0,
+                           static_cast<uint32_t>(descriptorSets.size()),
+                           descriptorSets.data(), 0, nullptr);
+   if (pushConstantSize) {
+      vkCmdPushConstants(commandBuffer, this->pipelineLayout,
+                         VK_SHADER_STAGE_COMPUTE_BIT, 0, pushConstantSize,
+                         pushData);
+   }
+   vkCmdDispatch(commandBuffer, groupsX, groupsY, groupsZ);
+}
+
+void ComputeSystem::run(uint32_t groupsX, uint32_t groupsY,
+                        uint32_t groupsZ,
+                        const std::vector<VkDescriptorSet> &descriptorSets,
+                        const void *pushData) {
+   CmdBuffer = lveDevice.beginSingleTimeCommands();
+   record(CmdBuffer, groupsX, groupsY, groupsZ, descriptorSets, pushData);
+   vkEndCommandBuffer(CmdBuffer);
+   await();
+   vkFreeCommandBuffers(lveDevice.device(), lveDevice.getCommandPool(), 1,
+                        &CmdBuffer);
+}
+
 void ComputeSystem::instant_dispatch(int width, int height, int channels,
                                      VkDescriptorSet &DescriptorSet) {
    dispatch(width, height, channels, DescriptorSet);
@@ -10,7 +10,7 @@ class ComputeSystem {
   public:
    ComputeSystem(LveDevice &device,
                  const std::vector<VkDescriptorSetLayout>,
-                 const std::string &);
+                 const std::string &, uint32_t pushConstantSize = 0);
    ComputeSystem(ComputeSystem &&) = delete;
    ComputeSystem(const ComputeSystem &) = delete;
    ComputeSystem &operator=(ComputeSystem &&) = delete;
@@ -22,6 +22,22 @@ class ComputeSystem {
    void await();
    void instant_dispatch(int width, int height, int channels,
                          VkDescriptorSet &DescriptorSet);
+   /**
+    * Records the dispatch into commandBuffer, to run with the rest of
+    * the frame. pushData holds pushConstantSize bytes, if any.
+    */
+   void record(VkCommandBuffer commandBuffer, uint32_t groupsX,
+               uint32_t groupsY, uint32_t groupsZ,
+               const std::vector<VkDescriptorSet> &descriptorSets,
+               const void *pushData = nullptr);
+   /**
+    * Records the dispatch into a command buffer of its own, submits it
+    * to the compute queue and waits for it, so what it wrote can be used
+    * by anything submitted afterwards.
+    */
+   void run(uint32_t groupsX, uint32_t groupsY, uint32_t groupsZ,
+            const std::vector<VkDescriptorSet> &descriptorSets,
+            const void *pushData = nullptr);
 
   private:
    LveDevice &lveDevice;
@@ -31,6 +47,7 @@ class ComputeSystem {
    VkCommandBuffer CmdBuffer;
    VkSubmitInfo submitInfo;
    VkFence Fence;
+   uint32_t pushConstantSize;
 
    void createFence();
    void createPipelineLayout(const std::vector<VkDescriptorSetLayout>);
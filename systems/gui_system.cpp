@@ -8,6 +8,8 @@
 #include <cstdio>
 #include <set>
 #include <stdexcept>
+#include <string>
+#include <vector>
 
 #include "imgui/backends/imgui_impl_glfw.h"
 #include "imgui/backends/imgui_impl_vulkan.h"
@@ -57,7 +59,8 @@ void ImGuiGui::update(lve::TerrainMovementController &cameraControler,
                       bool &caminata, std::string &path,
                       const std::set<std::string> &recent, int &curr,
                       bool &loadingState, size_t &pipeline,
-                      glm::vec3 coord, bool &viento, int &paleta_viento,
+                      glm::vec3 coord, bool &viento, bool &particulas,
+                      bool &lineas_gpu, int &paleta_viento,
                       const char *paletas) {
    ImGui::Begin("Sensibilidad");
    ImGui::SliderFloat("Velocidad minima", &cameraControler.moveSpeedMin,
@@ -83,6 +86,10 @@ void ImGuiGui::update(lve::TerrainMovementController &cameraControler,
    ImGui::SameLine();
    ImGui::RadioButton("WireFrame", &pipeline_i, 1);
    ImGui::Checkbox("Ver viento", &viento);
+   ImGui::SameLine();
+   ImGui::Checkbox("Particulas", &particulas);
+   ImGui::SameLine();
+   ImGui::Checkbox("Lineas en GPU", &lineas_gpu);
    ImGui::Combo("Paleta viento", &paleta_viento, paletas);
    ImGui::End();
    pipeline = pipeline_i;
@@ -116,6 +123,19 @@ void ImGuiGui::update(lve::TerrainMovementController &cameraControler,
    ImGui::End();
 }
 
+bool ImGuiGui::brush(const std::vector<std::string> &names, int &type,
+                     int &radius) {
+   std::vector<const char *> items;
+   for (const std::string &name : names) items.push_back(name.c_str());
+   ImGui::Begin("Editar vegetacion");
+   ImGui::Combo("Tipo", &type, items.data(), items.size());
+   ImGui::SliderInt("Radio", &radius, 1, 100);
+   bool paint = ImGui::Button("Pintar") && type >= 0 &&
+                static_cast<size_t>(type) < items.size();
+   ImGui::End();
+   return paint;
+}
+
 void ImGuiGui::render(VkCommandBuffer command_buffer) {
    ImGui::Render();
    ImGui_ImplVulkan_RenderDrawData(ImGui::GetDrawData(), command_buffer);
@@ -2,6 +2,8 @@
 
 #include <cstring>
 #include <set>
+#include <string>
+#include <vector>
 
 #include "../lve/lve_device.hpp"
 #include "../lve/lve_renderer.hpp"
@@ -29,6 +31,12 @@ class ImGuiGui {
    void new_frame();
    void update(lve::TerrainMovementController &, bool &, std::string &,
                const std::set<std::string> &, int &, bool &, size_t &,
-               glm::vec3, bool &, int &, const char *);
+               glm::vec3, bool &, bool &, bool &, int &, const char *);
+   /**
+    * Brush that paints vegetation types, by name, in a circle of radius
+    * cells. Returns whether it was asked to paint.
+    */
+   bool brush(const std::vector<std::string> &names, int &type,
+              int &radius);
    void render(VkCommandBuffer command_buffer);
 };
@@ -2,8 +2,10 @@
 
 #include <vulkan/vulkan_core.h>
 
+#include <array>
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <glm/fwd.hpp>
 #include <vector>
 
@@ -20,22 +22,105 @@ struct SimplePushConstantData {
    glm::mat4 normalMatrix{1.f};
 };
 
+// Push constants of terrain_cull.comp.
+struct CullPushConstantData {
+   std::array<glm::vec4, 6> planes{};
+   glm::vec4 viewer{};
+   glm::uvec4 grid{};
+};
+
+// local_size_x of terrain_cull.comp.
+constexpr uint32_t cullGroupSize = 64;
+
 TerrainRenderSystem::TerrainRenderSystem(
     LveDevice &device, VkRenderPass renderPass,
     VkDescriptorSetLayout globalSetLayout, const std::string &vertFilepath,
-    const std::string &fragFilepath)
-    : lveDevice{device} {
+    const std::string &rasterVertFilepath, const std::string &fragFilepath,
+    const std::string &cullFilepath)
+    : lveDevice{device},
+      gpuCulling{device.features.multiDrawIndirect == VK_TRUE} {
+   createTerrainDescriptors();
+   if (gpuCulling) {
+      createCullDescriptors();
+      cullSystem = std::make_unique<ComputeSystem>(
+          lveDevice,
+          std::vector<VkDescriptorSetLayout>{
+              cullSetLayout->getDescriptorSetLayout()},
+          cullFilepath, sizeof(CullPushConstantData));
+   }
    createPipelineLayout(globalSetLayout);
-   createPipeline(renderPass, vertFilepath, fragFilepath,
-                  PipeLineType::Normal);
-   createPipeline(renderPass, vertFilepath, fragFilepath,
-                  PipeLineType::WireFrame);
+   for (LveTerrain::VertexFormat format :
+        {LveTerrain::VertexFormat::Full,
+         LveTerrain::VertexFormat::Compact16,
+         LveTerrain::VertexFormat::Compact32,
+         LveTerrain::VertexFormat::Raster}) {
+      const std::string &vert = format == LveTerrain::VertexFormat::Raster
+                                    ? rasterVertFilepath
+                                    : vertFilepath;
+      createPipeline(renderPass, vert, fragFilepath, format,
+                     PipeLineType::Normal);
+      createPipeline(renderPass, vert, fragFilepath, format,
+                     PipeLineType::WireFrame);
+   }
 }
 
 TerrainRenderSystem::~TerrainRenderSystem() {
    vkDestroyPipelineLayout(lveDevice.device(), pipelineLayout, nullptr);
 }
 
+void TerrainRenderSystem::createTerrainDescriptors() {
+   terrainSetLayout =
+       LveDescriptorSetLayout::Builder(lveDevice)
+           .addBinding(0, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+                       VK_SHADER_STAGE_VERTEX_BIT)
+           .addBinding(1, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+                       VK_SHADER_STAGE_VERTEX_BIT)
+           .addBinding(2, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+                       VK_SHADER_STAGE_VERTEX_BIT)
+           .build();
+   terrainPool =
+       LveDescriptorPool::Builder(lveDevice)
+           .setMaxSets(LveSwapChain::MAX_FRAMES_IN_FLIGHT)
+           .addPoolSize(VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+                        3 * LveSwapChain::MAX_FRAMES_IN_FLIGHT)
+           .build();
+   terrainDescriptorSets.resize(LveSwapChain::MAX_FRAMES_IN_FLIGHT);
+   terrainIds.resize(LveSwapChain::MAX_FRAMES_IN_FLIGHT);
+   for (VkDescriptorSet &set : terrainDescriptorSets) {
+      if (!terrainPool->allocateDescriptor(
+              terrainSetLayout->getDescriptorSetLayout(), set)) {
+         throw std::runtime_error("failed to allocate terrain set!");
+      }
+   }
+}
+
+void TerrainRenderSystem::createCullDescriptors() {
+   cullSetLayout =
+       LveDescriptorSetLayout::Builder(lveDevice)
+           .addBinding(0, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+                       VK_SHADER_STAGE_COMPUTE_BIT)
+           .addBinding(1, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+                       VK_SHADER_STAGE_COMPUTE_BIT)
+           .addBinding(2, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+                       VK_SHADER_STAGE_COMPUTE_BIT)
+           .build();
+   cullPool =
+       LveDescriptorPool::Builder(lveDevice)
+           .setMaxSets(LveSwapChain::MAX_FRAMES_IN_FLIGHT)
+           .addPoolSize(VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+                        3 * LveSwapChain::MAX_FRAMES_IN_FLIGHT)
+           .build();
+   cullDescriptorSets.resize(LveSwapChain::MAX_FRAMES_IN_FLIGHT);
+   drawBuffers.resize(LveSwapChain::MAX_FRAMES_IN_FLIGHT);
+   cullIds.resize(LveSwapChain::MAX_FRAMES_IN_FLIGHT);
+   for (VkDescriptorSet &set : cullDescriptorSets) {
+      if (!cullPool->allocateDescriptor(
+              cullSetLayout->getDescriptorSetLayout(), set)) {
+         throw std::runtime_error("failed to allocate terrain cull set!");
+      }
+   }
+}
+
 void TerrainRenderSystem::createPipelineLayout(
     VkDescriptorSetLayout globalSetLayout) {
    VkPushConstantRange pushConstantRange{};
@@ -44,7 +129,9 @@ void TerrainRenderSystem::createPipelineLayout(
    pushConstantRange.offset = 0;
    pushConstantRange.size = sizeof(SimplePushConstantData);
 
-   std::vector<VkDescriptorSetLayout> descriptoSetLayouts{globalSetLayout};
+   // Only the Raster format uses set 1, the layout is shared anyway.
+   std::vector<VkDescriptorSetLayout> descriptoSetLayouts{
+       globalSetLayout, terrainSetLayout->getDescriptorSetLayout()};
 
    VkPipelineLayoutCreateInfo pipelineLayoutInfo{};
    pipelineLayoutInfo.sType =
@@ -64,14 +151,13 @@ void TerrainRenderSystem::createPipelineLayout(
 void TerrainRenderSystem::createPipeline(VkRenderPass renderPass,
                                          const std::string &vertFilepath,
                                          const std::string &fragFilepath,
+                                         LveTerrain::VertexFormat format,
                                          PipeLineType pipeline) {
    assert(pipelineLayout != nullptr &&
           "Cannot create pipeline before pipeline layout");
 
    PipelineConfigInfo pipelineConfig{};
    LvePipeline::defaultPipelineConfigInfo(pipelineConfig);
-   pipelineConfig.inputAssemblyInfo.topology =
-       VK_PRIMITIVE_TOPOLOGY_TRIANGLE_STRIP;
 
    if (pipeline == PipeLineType::WireFrame) {
       pipelineConfig.rasterizationInfo.polygonMode = VK_POLYGON_MODE_LINE;
@@ -79,26 +165,136 @@ void TerrainRenderSystem::createPipeline(VkRenderPass renderPass,
       pipelineConfig.rasterizationInfo.cullMode = VK_CULL_MODE_NONE;
    }
 
-   pipelineConfig.bindingDescriptions =
-       LveTerrain::Vertex::getBindingDescriptions();
-   pipelineConfig.attributeDescriptions =
-       LveTerrain::Vertex::getAttributeDescriptions();
+   // constant_id 0 in terrain_shader.vert: the normal comes
+   // octahedral-encoded.
+   VkBool32 compactNormal = VK_TRUE;
+   switch (format) {
+      case LveTerrain::VertexFormat::Full:
+         compactNormal = VK_FALSE;
+         pipelineConfig.bindingDescriptions =
+             LveTerrain::Vertex::getBindingDescriptions();
+         pipelineConfig.attributeDescriptions =
+             LveTerrain::Vertex::getAttributeDescriptions();
+         break;
+      case LveTerrain::VertexFormat::Compact16:
+         pipelineConfig.bindingDescriptions =
+             LveTerrain::CompactVertex16::getBindingDescriptions();
+         pipelineConfig.attributeDescriptions =
+             LveTerrain::CompactVertex16::getAttributeDescriptions();
+         break;
+      case LveTerrain::VertexFormat::Compact32:
+         pipelineConfig.bindingDescriptions =
+             LveTerrain::CompactVertex32::getBindingDescriptions();
+         pipelineConfig.attributeDescriptions =
+             LveTerrain::CompactVertex32::getAttributeDescriptions();
+         break;
+      case LveTerrain::VertexFormat::Raster:
+         pipelineConfig.bindingDescriptions.clear();
+         pipelineConfig.attributeDescriptions.clear();
+         break;
+   }
+   pipelineConfig.specializationEntries = {{0, 0, sizeof(VkBool32)}};
+   pipelineConfig.specializationData.resize(sizeof(VkBool32));
+   std::memcpy(pipelineConfig.specializationData.data(), &compactNormal,
+               sizeof(VkBool32));
    pipelineConfig.renderPass = renderPass;
    pipelineConfig.pipelineLayout = pipelineLayout;
-   lvePipeline[static_cast<size_t>(pipeline)] =
+   lvePipeline[static_cast<size_t>(format)]
+              [static_cast<size_t>(pipeline)] =
        std::make_unique<LvePipeline>(lveDevice, vertFilepath, fragFilepath,
                                      pipelineConfig);
 }
 
+void TerrainRenderSystem::cullTerrain(FrameInfo &frameInfo) {
+   if (!gpuCulling) return;
+   LveTerrain &terrain = *frameInfo.terrain;
+   const TerrainChunks &chunks = terrain.getChunks();
+   uint32_t chunkCount = static_cast<uint32_t>(chunks.getChunks().size());
+   if (!chunkCount) return;
+
+   // This frame's buffer and set aren't in use, they can follow a new
+   // terrain.
+   VkDescriptorSet &set = cullDescriptorSets[frameInfo.frameIndex];
+   std::unique_ptr<LveBuffer> &drawBuffer =
+       drawBuffers[frameInfo.frameIndex];
+   std::optional<LveTerrain::id_t> &id = cullIds[frameInfo.frameIndex];
+   if (id != terrain.getId()) {
+      drawBuffer = std::make_unique<LveBuffer>(
+          lveDevice, sizeof(VkDrawIndexedIndirectCommand),
+          TerrainChunks::gpuDrawsPerChunk * chunkCount,
+          VK_BUFFER_USAGE_STORAGE_BUFFER_BIT |
+              VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT,
+          VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+      VkDescriptorBufferInfo chunkInfo = terrain.chunkInfo();
+      VkDescriptorBufferInfo rangeInfo = terrain.chunkRangeInfo();
+      VkDescriptorBufferInfo drawInfo = drawBuffer->descriptorInfo();
+      LveDescriptorWriter(*cullSetLayout, *cullPool)
+          .writeBuffer(0, &chunkInfo)
+          .writeBuffer(1, &rangeInfo)
+          .writeBuffer(2, &drawInfo)
+          .overwrite(set);
+      id = terrain.getId();
+   }
+
+   // Same spaces as LveTerrain::draw: the xz plane is grid space.
+   CullPushConstantData push{};
+   push.planes = TerrainChunks::frustumPlanes(
+       frameInfo.camera.getProjection() * frameInfo.camera.getView());
+   push.viewer = glm::vec4(frameInfo.camera.getPosition(),
+                           LveTerrain::defaultLodDistance);
+   push.grid = glm::uvec4(chunks.getColumns(), chunks.getRows(),
+                          chunks.getLevels(), 0);
+   cullSystem->record(frameInfo.commandBuffer,
+                      (chunkCount + cullGroupSize - 1) / cullGroupSize, 1,
+                      1, {set}, &push);
+
+   VkBufferMemoryBarrier barrier{};
+   barrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+   barrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+   barrier.dstAccessMask = VK_ACCESS_INDIRECT_COMMAND_READ_BIT;
+   barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+   barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+   barrier.buffer = drawBuffer->getBuffer();
+   barrier.offset = 0;
+   barrier.size = VK_WHOLE_SIZE;
+   vkCmdPipelineBarrier(frameInfo.commandBuffer,
+                        VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                        VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT, 0, 0, nullptr,
+                        1, &barrier, 0, nullptr);
+}
+
 void TerrainRenderSystem::renderTerrain(FrameInfo &frameInfo,
                                         PipeLineType pipeline) {
-   lvePipeline[static_cast<size_t>(pipeline)]->bind(
-       frameInfo.commandBuffer);
+   LveTerrain &terrain = *frameInfo.terrain;
+   lvePipeline[static_cast<size_t>(terrain.vertexFormat())]
+              [static_cast<size_t>(pipeline)]
+                  ->bind(frameInfo.commandBuffer);
 
    vkCmdBindDescriptorSets(
        frameInfo.commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
        pipelineLayout, 0, 1, &frameInfo.globalDescriptorSet, 0, nullptr);
 
+   if (terrain.vertexFormat() == LveTerrain::VertexFormat::Raster) {
+      // This frame's set isn't in use, it can follow a new terrain.
+      VkDescriptorSet &set = terrainDescriptorSets[frameInfo.frameIndex];
+      std::optional<LveTerrain::id_t> &id =
+          terrainIds[frameInfo.frameIndex];
+      if (id != terrain.getId()) {
+         VkDescriptorBufferInfo alttitudeInfo = terrain.alttitudeInfo();
+         VkDescriptorBufferInfo vegetationInfo = terrain.vegetationInfo();
+         VkDescriptorBufferInfo paletteInfo = terrain.paletteInfo();
+         LveDescriptorWriter(*terrainSetLayout, *terrainPool)
+             .writeBuffer(0, &alttitudeInfo)
+             .writeBuffer(1, &vegetationInfo)
+             .writeBuffer(2, &paletteInfo)
+             .overwrite(set);
+         id = terrain.getId();
+      }
+      vkCmdBindDescriptorSets(frameInfo.commandBuffer,
+                              VK_PIPELINE_BIND_POINT_GRAPHICS,
+                              pipelineLayout, 1, 1, &set, 0, nullptr);
+   }
+
    SimplePushConstantData push{};
    const float c3 = glm::cos(.0f);
    const float s3 = glm::sin(.0f);
@@ -125,7 +321,7 @@ void TerrainRenderSystem::renderTerrain(FrameInfo &frameInfo,
                                     0.0f,
                                 },
                                 {.0f, .0f, .0f, 1.0f}};
-   ;
+   push.modelMatrix = push.modelMatrix * terrain.altitudeTransform();
    push.normalMatrix = glm::mat3{
        {
            (c1 * c3 + s1 * s2 * s3),
@@ -149,8 +345,17 @@ void TerrainRenderSystem::renderTerrain(FrameInfo &frameInfo,
        VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT, 0,
        sizeof(SimplePushConstantData), &push);
 
-   frameInfo.terrain->bind(frameInfo.commandBuffer);
-   frameInfo.terrain->draw(frameInfo.commandBuffer);
+   terrain.bind(frameInfo.commandBuffer);
+   if (gpuCulling && cullIds[frameInfo.frameIndex] == terrain.getId()) {
+      terrain.drawIndirect(frameInfo.commandBuffer,
+                           drawBuffers[frameInfo.frameIndex]->getBuffer());
+      return;
+   }
+   // The terrain's xz plane is grid space, the model matrix only scales
+   // the altitude.
+   terrain.draw(
+       frameInfo.commandBuffer, frameInfo.camera.getPosition(),
+       frameInfo.camera.getProjection() * frameInfo.camera.getView());
 }
 
 }  // namespace lve
@@ -3,10 +3,15 @@
 #include <vulkan/vulkan_core.h>
 
 #include <memory>
+#include <optional>
 
 #include "../apps/second_app_frame_info.hpp"
+#include "../lve/lve_buffer.hpp"
+#include "../lve/lve_descriptors.hpp"
 #include "../lve/lve_device.hpp"
 #include "../lve/lve_pipeline.hpp"
+#include "../lve/lve_swap_chain.hpp"
+#include "compute_system.hpp"
 
 namespace lve {
 
@@ -20,24 +25,56 @@ class TerrainRenderSystem {
    TerrainRenderSystem(LveDevice &device, VkRenderPass renderPass,
                        VkDescriptorSetLayout globalSetLayout,
                        const std::string &vertFilepath,
-                       const std::string &fragFilepath);
+                       const std::string &rasterVertFilepath,
+                       const std::string &fragFilepath,
+                       const std::string &cullFilepath);
    ~TerrainRenderSystem();
 
    TerrainRenderSystem(const TerrainRenderSystem &) = delete;
    TerrainRenderSystem &operator=(const TerrainRenderSystem &) = delete;
 
+   /**
+    * Records the compute pass that culls the chunks and picks their
+    * levels on the GPU. Has to run every frame before the render pass
+    * begins. Does nothing when the device lacks multiDrawIndirect, then
+    * renderTerrain culls on the CPU.
+    */
+   void cullTerrain(FrameInfo &frameInfo);
    void renderTerrain(FrameInfo &frameInfo, PipeLineType pipeline);
 
   private:
+   void createTerrainDescriptors();
+   void createCullDescriptors();
    void createPipelineLayout(VkDescriptorSetLayout globalSetLayout);
    void createPipeline(VkRenderPass renderPass,
                        const std::string &vertFilepath,
                        const std::string &fragFilepath,
+                       LveTerrain::VertexFormat format,
                        PipeLineType pipeline);
 
    LveDevice &lveDevice;
 
-   std::unique_ptr<LvePipeline> lvePipeline[2];
+   // One pipeline per vertex format and PipeLineType.
+   std::unique_ptr<LvePipeline>
+       lvePipeline[LveTerrain::vertexFormatCount][2];
    VkPipelineLayout pipelineLayout;
+
+   // Set 1 of the Raster format, one per frame in flight so it can be
+   // rewritten while the other frames draw. terrainIds keeps the terrain
+   // each one points to.
+   std::unique_ptr<LveDescriptorSetLayout> terrainSetLayout;
+   std::unique_ptr<LveDescriptorPool> terrainPool;
+   std::vector<VkDescriptorSet> terrainDescriptorSets;
+   std::vector<std::optional<LveTerrain::id_t>> terrainIds;
+
+   // GPU culling. Each frame in flight has its own draw buffer and set,
+   // rebuilt when the terrain changes, with cullIds keeping the terrain.
+   bool gpuCulling;
+   std::unique_ptr<ComputeSystem> cullSystem;
+   std::unique_ptr<LveDescriptorSetLayout> cullSetLayout;
+   std::unique_ptr<LveDescriptorPool> cullPool;
+   std::vector<VkDescriptorSet> cullDescriptorSets;
+   std::vector<std::unique_ptr<LveBuffer>> drawBuffers;
+   std::vector<std::optional<LveTerrain::id_t>> cullIds;
 };
 }  // namespace lve
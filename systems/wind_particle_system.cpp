@@ -0,0 +1,271 @@
+#include "wind_particle_system.hpp"
+
+#include <vulkan/vulkan_core.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <glm/fwd.hpp>
+#include <stdexcept>
+#include <vector>
+
+#define GLM_FORCE_RADIANS
+#define GLM_FORCE_DEPTH_ZERO_TO_ONE
+#include <glm/glm.hpp>
+
+namespace lve {
+
+struct SimplePushConstantData {
+   glm::mat4 modelMatrix{1.f};
+   glm::mat4 normalMatrix{1.f};
+};
+
+// Push constants of wind_particles.comp.
+struct AdvectPushConstantData {
+   glm::uvec4 grid{};
+   glm::vec4 time{};
+   glm::vec2 speed{};
+};
+
+// Particle of wind_particles.comp, head and tail.
+constexpr VkDeviceSize particleSize = 2 * sizeof(glm::vec4);
+
+// local_size_x of wind_particles.comp.
+constexpr uint32_t advectGroupSize = 256;
+
+// Longest frame the particles move in one step, in seconds.
+constexpr float maxFrameTime = 0.1f;
+
+WindParticleSystem::WindParticleSystem(
+    LveDevice &device, VkRenderPass renderPass,
+    VkDescriptorSetLayout globalSetLayout, const std::string &vertFilepath,
+    const std::string &fragFilepath, const std::string &compFilepath,
+    const LvePalette &palette, uint32_t particleCount)
+    : lveDevice{device}, palette{palette}, particleCount{particleCount} {
+   particleBuffer = std::make_unique<LveBuffer>(
+       lveDevice, particleSize, particleCount,
+       VK_BUFFER_USAGE_STORAGE_BUFFER_BIT |
+           VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+       VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+   createDescriptors();
+   advectSystem = std::make_unique<ComputeSystem>(
+       lveDevice,
+       std::vector<VkDescriptorSetLayout>{
+           advectSetLayout->getDescriptorSetLayout()},
+       compFilepath, sizeof(AdvectPushConstantData));
+   createPipelineLayout(globalSetLayout);
+   createPipeline(renderPass, vertFilepath, fragFilepath);
+}
+
+WindParticleSystem::~WindParticleSystem() {
+   vkDestroyPipelineLayout(lveDevice.device(), pipelineLayout, nullptr);
+}
+
+void WindParticleSystem::createDescriptors() {
+   advectSetLayout =
+       LveDescriptorSetLayout::Builder(lveDevice)
+           .addBinding(0, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+                       VK_SHADER_STAGE_COMPUTE_BIT)
+           .addBinding(1, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+                       VK_SHADER_STAGE_COMPUTE_BIT)
+           .addBinding(2, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+                       VK_SHADER_STAGE_COMPUTE_BIT)
+           .build();
+   particleSetLayout =
+       LveDescriptorSetLayout::Builder(lveDevice)
+           .addBinding(0, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+                       VK_SHADER_STAGE_VERTEX_BIT)
+           .addBinding(1, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
+                       VK_SHADER_STAGE_VERTEX_BIT)
+           .build();
+   particlePool =
+       LveDescriptorPool::Builder(lveDevice)
+           .setMaxSets(2)
+           .addPoolSize(VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 4)
+           .addPoolSize(VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 1)
+           .build();
+   if (!particlePool->allocateDescriptor(
+           advectSetLayout->getDescriptorSetLayout(),
+           advectDescriptorSet) ||
+       !particlePool->allocateDescriptor(
+           particleSetLayout->getDescriptorSetLayout(),
+           particleDescriptorSet)) {
+      throw std::runtime_error("failed to allocate wind particle sets!");
+   }
+}
+
+void WindParticleSystem::createPipelineLayout(
+    VkDescriptorSetLayout globalSetLayout) {
+   VkPushConstantRange pushConstantRange{};
+   pushConstantRange.stageFlags =
+       VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT;
+   pushConstantRange.offset = 0;
+   pushConstantRange.size = sizeof(SimplePushConstantData);
+
+   std::vector<VkDescriptorSetLayout> descriptoSetLayouts{
+       globalSetLayout, particleSetLayout->getDescriptorSetLayout()};
+
+   VkPipelineLayoutCreateInfo pipelineLayoutInfo{};
+   pipelineLayoutInfo.sType =
+       VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+   pipelineLayoutInfo.setLayoutCount =
+       static_cast<uint32_t>(descriptoSetLayouts.size());
+   pipelineLayoutInfo.pSetLayouts = descriptoSetLayouts.data();
+   pipelineLayoutInfo.pushConstantRangeCount = 1;
+   pipelineLayoutInfo.pPushConstantRanges = &pushConstantRange;
+
+   if (vkCreatePipelineLayout(lveDevice.device(), &pipelineLayoutInfo,
+                              nullptr, &pipelineLayout) != VK_SUCCESS) {
+      throw std::runtime_error("failed to create pipeline layout!");
+   }
+}
+
+void WindParticleSystem::createPipeline(VkRenderPass renderPass,
+                                        const std::string &vertFilepath,
+                                        const std::string &fragFilepath) {
+   assert(pipelineLayout != nullptr &&
+          "Cannot create pipeline before pipeline layout");
+
+   PipelineConfigInfo pipelineConfig{};
+   LvePipeline::defaultPipelineConfigInfo(pipelineConfig);
+   pipelineConfig.inputAssemblyInfo.topology =
+       VK_PRIMITIVE_TOPOLOGY_LINE_LIST;
+   // The vertex shader reads the particles itself.
+   pipelineConfig.bindingDescriptions.clear();
+   pipelineConfig.attributeDescriptions.clear();
+   pipelineConfig.renderPass = renderPass;
+   pipelineConfig.pipelineLayout = pipelineLayout;
+   lvePipeline = std::make_unique<LvePipeline>(
+       lveDevice, vertFilepath, fragFilepath, pipelineConfig);
+}
+
+template <typename T>
+std::unique_ptr<LveBuffer> WindParticleSystem::createStorageBuffer(
+    const T *data, size_t count) {
+   VkDeviceSize bufferSize = sizeof(T) * count;
+   uint32_t size = sizeof(T);
+
+   std::unique_ptr<LveBuffer> buffer = std::make_unique<LveBuffer>(
+       lveDevice, size, static_cast<uint32_t>(count),
+       VK_BUFFER_USAGE_STORAGE_BUFFER_BIT |
+           VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+       VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+
+   LveBuffer stagingBuffer{
+       lveDevice,
+       size,
+       static_cast<uint32_t>(count),
+       VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+       VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
+           VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+   };
+
+   stagingBuffer.map();
+   stagingBuffer.writeToBuffer((void *)data, bufferSize);
+
+   lveDevice.copyBuffer(stagingBuffer.getBuffer(), buffer->getBuffer(),
+                        bufferSize);
+   return buffer;
+}
+
+void WindParticleSystem::setField(const Raster<glm::float32> &alttitudeMap,
+                                  const Raster<glm::vec2> &wind_speed,
+                                  float min, float max) {
+   if (wind_speed.width() != alttitudeMap.width() ||
+       wind_speed.height() != alttitudeMap.height()) {
+      throw std::runtime_error("wind map size differs from the map");
+   }
+   vkDeviceWaitIdle(lveDevice.device());
+   xn = alttitudeMap.width();
+   yn = alttitudeMap.height();
+   speedRange = glm::vec2(min, max - min);
+   if (alttitudeMap.empty()) {
+      alttitudeBuffer = nullptr;
+      windBuffer = nullptr;
+      return;
+   }
+   alttitudeBuffer =
+       createStorageBuffer(alttitudeMap.data(), alttitudeMap.size());
+   windBuffer = createStorageBuffer(wind_speed.data(), wind_speed.size());
+
+   // With no time left every particle respawns on the next advect.
+   VkCommandBuffer commandBuffer = lveDevice.beginSingleTimeCommands();
+   vkCmdFillBuffer(commandBuffer, particleBuffer->getBuffer(), 0,
+                   VK_WHOLE_SIZE, 0);
+   lveDevice.endSingleTimeCommands(commandBuffer);
+   writeDescriptors();
+}
+
+void WindParticleSystem::writeDescriptors() {
+   if (!hasField()) return;
+   VkDescriptorBufferInfo alttitudeInfo =
+       alttitudeBuffer->descriptorInfo();
+   VkDescriptorBufferInfo windInfo = windBuffer->descriptorInfo();
+   VkDescriptorBufferInfo particleInfo = particleBuffer->descriptorInfo();
+   VkDescriptorImageInfo paletteInfo = palette.descriptorInfo();
+   LveDescriptorWriter(*advectSetLayout, *particlePool)
+       .writeBuffer(0, &alttitudeInfo)
+       .writeBuffer(1, &windInfo)
+       .writeBuffer(2, &particleInfo)
+       .overwrite(advectDescriptorSet);
+   LveDescriptorWriter(*particleSetLayout, *particlePool)
+       .writeBuffer(0, &particleInfo)
+       .writeImage(1, &paletteInfo)
+       .overwrite(particleDescriptorSet);
+}
+
+void WindParticleSystem::advect(FrameInfo &frameInfo) {
+   if (!hasField()) return;
+   VkCommandBuffer commandBuffer = frameInfo.commandBuffer;
+
+   // The previous frame may still be drawing the particles.
+   vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_VERTEX_SHADER_BIT,
+                        VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 0,
+                        nullptr, 0, nullptr, 0, nullptr);
+
+   AdvectPushConstantData push{};
+   push.grid = glm::uvec4(xn, yn, particleCount, frame++);
+   push.time = glm::vec4(
+       std::min(frameInfo.frameTime, maxFrameTime) * timeScale, lifetime,
+       streakTime, 0.f);
+   push.speed = speedRange;
+   advectSystem->record(
+       commandBuffer,
+       (particleCount + advectGroupSize - 1) / advectGroupSize, 1, 1,
+       {advectDescriptorSet}, &push);
+
+   VkBufferMemoryBarrier barrier{};
+   barrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+   barrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+   barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+   barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+   barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+   barrier.buffer = particleBuffer->getBuffer();
+   barrier.offset = 0;
+   barrier.size = VK_WHOLE_SIZE;
+   vkCmdPipelineBarrier(commandBuffer,
+                        VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                        VK_PIPELINE_STAGE_VERTEX_SHADER_BIT, 0, 0, nullptr,
+                        1, &barrier, 0, nullptr);
+}
+
+void WindParticleSystem::renderParticles(FrameInfo &frameInfo) {
+   if (!hasField()) return;
+   lvePipeline->bind(frameInfo.commandBuffer);
+
+   VkDescriptorSet sets[] = {frameInfo.globalDescriptorSet,
+                             particleDescriptorSet};
+   vkCmdBindDescriptorSets(frameInfo.commandBuffer,
+                           VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayout,
+                           0, 2, sets, 0, nullptr);
+
+   SimplePushConstantData push{};
+   vkCmdPushConstants(
+       frameInfo.commandBuffer, pipelineLayout,
+       VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT, 0,
+       sizeof(SimplePushConstantData), &push);
+
+   vkCmdDraw(frameInfo.commandBuffer, 2 * particleCount, 1, 0, 0);
+}
+
+}  // namespace lve
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <vulkan/vulkan_core.h>
+
+#include <memory>
+#include <string>
+
+#include "../apps/second_app_frame_info.hpp"
+#include "../lve/lve_buffer.hpp"
+#include "../lve/lve_descriptors.hpp"
+#include "../lve/lve_device.hpp"
+#include "../lve/lve_palette.hpp"
+#include "../lve/lve_pipeline.hpp"
+#include "../lve/lve_raster.hpp"
+#include "compute_system.hpp"
+
+namespace lve {
+
+/**
+ * Wind shown as particles the GPU moves every frame: a compute pass
+ * advects them through the wind field and respawns those that leave the
+ * map or grow old, and each is drawn as a short streak colored by the
+ * wind speed from palette. Nothing is traced beforehand, so a new wind
+ * field is just an upload, and a new palette just one to palette.
+ */
+class WindParticleSystem {
+  public:
+   static constexpr uint32_t defaultParticleCount = 1u << 20;
+   // Wind time units per second, and those a particle lives at most and
+   // its streak covers, as in LveWind lines.
+   static constexpr float timeScale = 4.f;
+   static constexpr float lifetime = 10.f;
+   static constexpr float streakTime = 0.5f;
+
+   WindParticleSystem(LveDevice &device, VkRenderPass renderPass,
+                      VkDescriptorSetLayout globalSetLayout,
+                      const std::string &vertFilepath,
+                      const std::string &fragFilepath,
+                      const std::string &compFilepath,
+                      const LvePalette &palette,
+                      uint32_t particleCount = defaultParticleCount);
+   ~WindParticleSystem();
+
+   WindParticleSystem(const WindParticleSystem &) = delete;
+   WindParticleSystem &operator=(const WindParticleSystem &) = delete;
+
+   /**
+    * Wind the particles follow, with speeds normalised over [min, max],
+    * over alttitudeMap. The particles start over. Waits for the device
+    * to be idle, the buffers in use are replaced.
+    */
+   void setField(const Raster<glm::float32> &alttitudeMap,
+                 const Raster<glm::vec2> &wind_speed, float min,
+                 float max);
+
+   bool hasField() const {
+      return static_cast<bool>(windBuffer);
+   }
+
+   /**
+    * Records the compute pass that moves the particles frameTime
+    * seconds, before the render pass. Does nothing without a field.
+    */
+   void advect(FrameInfo &frameInfo);
+   void renderParticles(FrameInfo &frameInfo);
+
+  private:
+   void createDescriptors();
+   void createPipelineLayout(VkDescriptorSetLayout globalSetLayout);
+   void createPipeline(VkRenderPass renderPass,
+                       const std::string &vertFilepath,
+                       const std::string &fragFilepath);
+   void writeDescriptors();
+   template <typename T>
+   std::unique_ptr<LveBuffer> createStorageBuffer(const T *data,
+                                                  size_t count);
+
+   LveDevice &lveDevice;
+   const LvePalette &palette;
+   uint32_t particleCount;
+   uint32_t xn = 0;
+   uint32_t yn = 0;
+   glm::vec2 speedRange{0.f, 1.f};
+   uint32_t frame = 0;
+
+   std::unique_ptr<LveBuffer> particleBuffer;
+   std::unique_ptr<LveBuffer> alttitudeBuffer;
+   std::unique_ptr<LveBuffer> windBuffer;
+
+   // Set 0 of the compute pass, set 1 of the pipeline. Rewritten only
+   // with the device idle.
+   std::unique_ptr<LveDescriptorSetLayout> advectSetLayout;
+   std::unique_ptr<LveDescriptorSetLayout> particleSetLayout;
+   std::unique_ptr<LveDescriptorPool> particlePool;
+   VkDescriptorSet advectDescriptorSet;
+   VkDescriptorSet particleDescriptorSet;
+
+   std::unique_ptr<ComputeSystem> advectSystem;
+   std::unique_ptr<LvePipeline> lvePipeline;
+   VkPipelineLayout pipelineLayout;
+};
+
+}  // namespace lve
@@ -23,8 +23,10 @@ WindRenderSystem::WindRenderSystem(LveDevice &device,
                                    VkRenderPass renderPass,
                                    VkDescriptorSetLayout globalSetLayout,
                                    const std::string &vertFilepath,
-                                   const std::string &fragFilepath)
+                                   const std::string &fragFilepath,
+                                   const LvePalette &palette)
     : lveDevice{device} {
+   createDescriptors(palette);
    createPipelineLayout(globalSetLayout);
    createPipeline(renderPass, vertFilepath, fragFilepath);
 }
@@ -33,6 +35,26 @@ WindRenderSystem::~WindRenderSystem() {
    vkDestroyPipelineLayout(lveDevice.device(), pipelineLayout, nullptr);
 }
 
+void WindRenderSystem::createDescriptors(const LvePalette &palette) {
+   paletteSetLayout =
+       LveDescriptorSetLayout::Builder(lveDevice)
+           .addBinding(0, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
+                       VK_SHADER_STAGE_VERTEX_BIT)
+           .build();
+   palettePool =
+       LveDescriptorPool::Builder(lveDevice)
+           .setMaxSets(1)
+           .addPoolSize(VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 1)
+           .build();
+   // The palette keeps its image when it changes, so this stays valid.
+   VkDescriptorImageInfo paletteInfo = palette.descriptorInfo();
+   if (!LveDescriptorWriter(*paletteSetLayout, *palettePool)
+            .writeImage(0, &paletteInfo)
+            .build(paletteDescriptorSet)) {
+      throw std::runtime_error("failed to allocate wind palette set!");
+   }
+}
+
 void WindRenderSystem::createPipelineLayout(
     VkDescriptorSetLayout globalSetLayout) {
    VkPushConstantRange pushConstantRange{};
@@ -41,7 +63,8 @@ void WindRenderSystem::createPipelineLayout(
    pushConstantRange.offset = 0;
    pushConstantRange.size = sizeof(SimplePushConstantData);
 
-   std::vector<VkDescriptorSetLayout> descriptoSetLayouts{globalSetLayout};
+   std::vector<VkDescriptorSetLayout> descriptoSetLayouts{
+       globalSetLayout, paletteSetLayout->getDescriptorSetLayout()};
 
    VkPipelineLayoutCreateInfo pipelineLayoutInfo{};
    pipelineLayoutInfo.sType =
@@ -83,9 +106,11 @@ void WindRenderSystem::createPipeline(VkRenderPass renderPass,
 void WindRenderSystem::renderWind(FrameInfo &frameInfo) {
    lvePipeline->bind(frameInfo.commandBuffer);
 
-   vkCmdBindDescriptorSets(
-       frameInfo.commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
-       pipelineLayout, 0, 1, &frameInfo.globalDescriptorSet, 0, nullptr);
+   VkDescriptorSet sets[] = {frameInfo.globalDescriptorSet,
+                             paletteDescriptorSet};
+   vkCmdBindDescriptorSets(frameInfo.commandBuffer,
+                           VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayout,
+                           0, 2, sets, 0, nullptr);
 
    SimplePushConstantData push{};
    const float c3 = glm::cos(.0f);
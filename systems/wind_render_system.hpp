@@ -5,17 +5,21 @@
 #include <memory>
 
 #include "../apps/second_app_frame_info.hpp"
+#include "../lve/lve_descriptors.hpp"
 #include "../lve/lve_device.hpp"
+#include "../lve/lve_palette.hpp"
 #include "../lve/lve_pipeline.hpp"
 
 namespace lve {
 
+// Draws the wind lines, colored by their speed from palette.
 class WindRenderSystem {
   public:
    WindRenderSystem(LveDevice &device, VkRenderPass renderPass,
                     VkDescriptorSetLayout globalSetLayout,
                     const std::string &vertFilepath,
-                    const std::string &fragFilepath);
+                    const std::string &fragFilepath,
+                    const LvePalette &palette);
    ~WindRenderSystem();
 
    WindRenderSystem(const WindRenderSystem &) = delete;
@@ -24,6 +28,7 @@ class WindRenderSystem {
    void renderWind(FrameInfo &frameInfo);
 
   private:
+   void createDescriptors(const LvePalette &palette);
    void createPipelineLayout(VkDescriptorSetLayout globalSetLayout);
    void createPipeline(VkRenderPass renderPass,
                        const std::string &vertFilepath,
@@ -31,6 +36,11 @@ class WindRenderSystem {
 
    LveDevice &lveDevice;
 
+   // Set 1, the palette.
+   std::unique_ptr<LveDescriptorSetLayout> paletteSetLayout;
+   std::unique_ptr<LveDescriptorPool> palettePool;
+   VkDescriptorSet paletteDescriptorSet;
+
    std::unique_ptr<LvePipeline> lvePipeline;
    VkPipelineLayout pipelineLayout;
 };
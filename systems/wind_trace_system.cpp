@@ -0,0 +1,138 @@
+#include "wind_trace_system.hpp"
+
+#include <vulkan/vulkan_core.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <glm/fwd.hpp>
+#include <stdexcept>
+#include <vector>
+
+#define GLM_FORCE_RADIANS
+#define GLM_FORCE_DEPTH_ZERO_TO_ONE
+#include <glm/glm.hpp>
+
+namespace lve {
+
+// Push constants of wind_trace.comp.
+struct TracePushConstantData {
+   glm::uvec4 grid{};
+   glm::uvec2 line{};
+   glm::vec2 speed{};
+};
+
+// local_size_x of wind_trace.comp.
+constexpr uint32_t traceGroupSize = 64;
+
+WindTraceSystem::WindTraceSystem(LveDevice &device,
+                                 const std::string &compFilepath)
+    : lveDevice{device} {
+   traceSetLayout =
+       LveDescriptorSetLayout::Builder(lveDevice)
+           .addBinding(0, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+                       VK_SHADER_STAGE_COMPUTE_BIT)
+           .addBinding(1, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+                       VK_SHADER_STAGE_COMPUTE_BIT)
+           .addBinding(2, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+                       VK_SHADER_STAGE_COMPUTE_BIT)
+           .addBinding(3, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+                       VK_SHADER_STAGE_COMPUTE_BIT)
+           .build();
+   tracePool = LveDescriptorPool::Builder(lveDevice)
+                   .setMaxSets(1)
+                   .addPoolSize(VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 4)
+                   .build();
+   if (!tracePool->allocateDescriptor(
+           traceSetLayout->getDescriptorSetLayout(), traceDescriptorSet)) {
+      throw std::runtime_error("failed to allocate wind trace set!");
+   }
+   traceSystem = std::make_unique<ComputeSystem>(
+       lveDevice,
+       std::vector<VkDescriptorSetLayout>{
+           traceSetLayout->getDescriptorSetLayout()},
+       compFilepath, sizeof(TracePushConstantData));
+}
+
+WindTraceSystem::~WindTraceSystem() {
+}
+
+template <typename T>
+std::unique_ptr<LveBuffer> WindTraceSystem::createStorageBuffer(
+    const T *data, size_t count) {
+   VkDeviceSize bufferSize = sizeof(T) * count;
+   uint32_t size = sizeof(T);
+   // Vulkan doesn't allow empty buffers.
+   uint32_t instances = static_cast<uint32_t>(std::max<size_t>(count, 1));
+
+   std::unique_ptr<LveBuffer> buffer = std::make_unique<LveBuffer>(
+       lveDevice, size, instances,
+       VK_BUFFER_USAGE_STORAGE_BUFFER_BIT |
+           VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+       VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+   if (!bufferSize) return buffer;
+
+   LveBuffer stagingBuffer{
+       lveDevice,
+       size,
+       instances,
+       VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+       VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
+           VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+   };
+
+   stagingBuffer.map();
+   stagingBuffer.writeToBuffer((void *)data, bufferSize);
+
+   lveDevice.copyBuffer(stagingBuffer.getBuffer(), buffer->getBuffer(),
+                        bufferSize);
+   return buffer;
+}
+
+std::unique_ptr<LveWind> WindTraceSystem::trace(
+    const Raster<glm::float32> &alttitudeMap,
+    const Raster<glm::vec2> &wind_speed, float min, float max,
+    uint32_t lineCapacity) {
+   const uint32_t xn = alttitudeMap.width();
+   const uint32_t yn = alttitudeMap.height();
+   if (wind_speed.width() != xn || wind_speed.height() != yn) {
+      throw std::runtime_error("wind map size differs from the map");
+   }
+
+   // Seeds like generateMesh, row by row.
+   const uint32_t spacing = LveWind::seedSpacing;
+   uint32_t columns = (xn + spacing - 1) / spacing;
+   uint32_t rows = (yn + spacing - 1) / spacing;
+   uint32_t lines = columns * rows;
+   uint32_t capacity = std::max(
+       std::min(lineCapacity, maxVertices / std::max(lines, 1u)), 2u);
+   std::unique_ptr<LveWind> wind =
+       std::make_unique<LveWind>(lveDevice, lines, capacity);
+   if (!lines) return wind;
+
+   std::unique_ptr<LveBuffer> alttitudeBuffer =
+       createStorageBuffer(alttitudeMap.data(), alttitudeMap.size());
+   std::unique_ptr<LveBuffer> windBuffer =
+       createStorageBuffer(wind_speed.data(), wind_speed.size());
+
+   VkDescriptorBufferInfo alttitudeInfo =
+       alttitudeBuffer->descriptorInfo();
+   VkDescriptorBufferInfo windInfo = windBuffer->descriptorInfo();
+   VkDescriptorBufferInfo vertexInfo = wind->vertexInfo();
+   VkDescriptorBufferInfo drawInfo = wind->drawInfo();
+   LveDescriptorWriter(*traceSetLayout, *tracePool)
+       .writeBuffer(0, &alttitudeInfo)
+       .writeBuffer(1, &windInfo)
+       .writeBuffer(2, &vertexInfo)
+       .writeBuffer(3, &drawInfo)
+       .overwrite(traceDescriptorSet);
+
+   TracePushConstantData push{};
+   push.grid = glm::uvec4(xn, yn, columns, lines);
+   push.line = glm::uvec2(spacing, capacity);
+   push.speed = glm::vec2(min, max - min);
+   traceSystem->run((lines + traceGroupSize - 1) / traceGroupSize, 1, 1,
+                    {traceDescriptorSet}, &push);
+   return wind;
+}
+
+}  // namespace lve
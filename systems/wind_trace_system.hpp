@@ -0,0 +1,51 @@
+#pragma once
+
+#include <vulkan/vulkan_core.h>
+
+#include <memory>
+#include <string>
+
+#include "../lve/lve_buffer.hpp"
+#include "../lve/lve_descriptors.hpp"
+#include "../lve/lve_device.hpp"
+#include "../lve/lve_raster.hpp"
+#include "../lve/lve_wind.hpp"
+#include "compute_system.hpp"
+
+namespace lve {
+
+// generateMesh with Grid seeds and the Adaptive integrator, on the GPU.
+class WindTraceSystem {
+  public:
+   // Vertices a line keeps at most, and all lines together.
+   static constexpr uint32_t defaultLineCapacity = 512;
+   static constexpr uint32_t maxVertices = 1u << 22;
+
+   WindTraceSystem(LveDevice &device, const std::string &compFilepath);
+   ~WindTraceSystem();
+
+   WindTraceSystem(const WindTraceSystem &) = delete;
+   WindTraceSystem &operator=(const WindTraceSystem &) = delete;
+
+   // Waits for the compute queue. Lines longer than lineCapacity, or
+   // than their share of maxVertices, are cut short.
+   std::unique_ptr<LveWind> trace(
+       const Raster<glm::float32> &alttitudeMap,
+       const Raster<glm::vec2> &wind_speed, float min, float max,
+       uint32_t lineCapacity = defaultLineCapacity);
+
+  private:
+   template <typename T>
+   std::unique_ptr<LveBuffer> createStorageBuffer(const T *data,
+                                                  size_t count);
+
+   LveDevice &lveDevice;
+
+   std::unique_ptr<LveDescriptorSetLayout> traceSetLayout;
+   std::unique_ptr<LveDescriptorPool> tracePool;
+   // Rewritten by every trace, which waits for the GPU to be done.
+   VkDescriptorSet traceDescriptorSet;
+   std::unique_ptr<ComputeSystem> traceSystem;
+};
+
+}  // namespace lve
@@ -0,0 +1,112 @@
+// Checks that AscReader's blocks match the file, also when a row doesn't
+// fit in its buffer.
+#include <unistd.h>
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+#include "asc_process/Lexer.hpp"
+#include "tests/test_check.hpp"
+
+namespace {
+
+int32_t cell(uint32_t x, uint32_t y) {
+   return static_cast<int32_t>((x * 7919 + y * 13) % 200000) - 100000;
+}
+
+void writeAsc(const std::filesystem::path &path, uint32_t xn,
+              uint32_t yn) {
+   std::ofstream ofile(path, std::ios::binary);
+   ofile << "ncols        " << xn << "\n"
+         << "nrows        " << yn << "\n"
+         << "xllcorner    0\n"
+         << "yllcorner    0\n"
+         << "cellsize     30\n"
+         << "NODATA_value -9999\n";
+   for (uint32_t y = 0; y < yn; ++y) {
+      for (uint32_t x = 0; x < xn; ++x) ofile << ' ' << cell(x, y);
+      ofile << '\n';
+   }
+}
+
+// Reads the file with readi and readf and compares every cell.
+void checkReader(const std::filesystem::path &path, uint32_t xn,
+                 uint32_t yn, size_t budget) {
+   std::string name = std::to_string(xn) + "x" + std::to_string(yn) +
+                      " with " + std::to_string(budget) + " bytes";
+   try {
+      Lexer::AscReader reader(path, budget);
+      check(reader.width() == xn && reader.height() == yn,
+            name + ": size");
+      check(reader.cellsize() == 30 && reader.NODATA_value() == -9999,
+            name + ": metadata");
+
+      uint32_t next = 0;
+      bool equal = true;
+      reader.readi([&](uint32_t first,
+                       const Lexer::AscReader::Block<glm::int32> &block) {
+         equal = equal && first == next && block.width() == xn;
+         for (uint32_t row = 0; row < block.height(); ++row) {
+            for (uint32_t x = 0; x < xn; ++x) {
+               equal = equal && block.row(row)[x] == cell(x, first + row);
+            }
+         }
+         next = first + block.height();
+      });
+      check(equal && next == yn, name + ": readi");
+
+      next = 0;
+      equal = true;
+      reader.readf([&](uint32_t first,
+                       const Lexer::AscReader::Block<glm::float32>
+                           &block) {
+         equal = equal && first == next && block.width() == xn;
+         for (uint32_t row = 0; row < block.height(); ++row) {
+            for (uint32_t x = 0; x < xn; ++x) {
+               equal = equal && block.row(row)[x] ==
+                                    static_cast<glm::float32>(
+                                        cell(x, first + row));
+            }
+         }
+         next = first + block.height();
+      });
+      check(equal && next == yn, name + ": readf");
+   } catch (const std::exception &e) {
+      check(false, name + ": " + e.what());
+   }
+}
+
+}  // namespace
+
+int main() {
+   std::filesystem::path dir =
+       std::filesystem::temp_directory_path() /
+       ("asc_reader_test_" + std::to_string(getpid()));
+   std::filesystem::create_directories(dir);
+
+   const size_t budget = 64 << 10;
+   struct Case {
+      uint32_t xn, yn;
+   } cases[] = {
+       // Rows wider than half the budget: the buffer grows on the first
+       // read, with the header still in front.
+       {12000, 4},
+       // Rows wider than the whole budget, it grows twice.
+       {40000, 3},
+       // Many narrow rows, several blocks and reads.
+       {50, 3000},
+       {1, 1},
+   };
+   for (const Case &c : cases) {
+      std::filesystem::path path =
+          dir / (std::to_string(c.xn) + "x" + std::to_string(c.yn) +
+                 ".asc");
+      writeAsc(path, c.xn, c.yn);
+      checkReader(path, c.xn, c.yn, budget);
+   }
+   std::filesystem::remove_all(dir);
+
+   return report("asc_reader_test");
+}
@@ -0,0 +1,138 @@
+// Checks every terrain normal kernel against the original glm::cross
+// formula, bit for bit, on random rows and sub-ranges of them.
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "lve/lve_terrain_normals.hpp"
+#include "tests/test_check.hpp"
+
+namespace {
+
+// The loop lve_terrain used before the kernels existed.
+glm::vec3 reference(const std::vector<std::vector<glm::float32>> &map,
+                    uint32_t x, uint32_t y) {
+   uint32_t yn = map.size();
+   uint32_t xn = map[0].size();
+   uint32_t xs = x == xn - 1 ? x : x + 1;
+   uint32_t xa = x == 0 ? x : x - 1;
+   uint32_t ys = y == yn - 1 ? y : y + 1;
+   uint32_t ya = y == 0 ? y : y - 1;
+
+   glm::vec3 x_y = {x, y, map[y][x]};
+   glm::vec3 xs_y = {xs, y, map[y][xs]};
+   glm::vec3 xa_y = {xa, y, map[y][xa]};
+   glm::vec3 x_ys = {x, ys, map[ys][x]};
+   glm::vec3 x_ya = {x, ya, map[ya][x]};
+
+   glm::vec3 x_a = x_y - x_ys;
+   glm::vec3 x_b = x_y - xs_y;
+   glm::vec3 x_c = x_y - x_ya;
+   glm::vec3 x_d = x_y - xa_y;
+
+   glm::vec3 n1 = glm::cross(x_a, x_b);
+   glm::vec3 n2 = glm::cross(x_b, x_c);
+   glm::vec3 n3 = glm::cross(x_c, x_d);
+   glm::vec3 n4 = glm::cross(x_d, x_a);
+
+   return (n1 + n2 + n3 + n4) / 4.f;
+}
+
+const struct {
+   lve::NormalsKernel kernel;
+   const char *name;
+} kernels[] = {
+    {lve::NormalsKernel::Best, "best"},
+    {lve::NormalsKernel::Scalar, "scalar"},
+    {lve::NormalsKernel::Sse2, "sse2"},
+    {lve::NormalsKernel::Avx, "avx"},
+};
+
+/**
+ * Runs every kernel on row y over [x0, x1) and compares the bits with
+ * the reference. Normals outside the range must stay untouched.
+ */
+void checkRange(const std::vector<std::vector<glm::float32>> &map,
+                uint32_t y, uint32_t x0, uint32_t x1) {
+   uint32_t yn = map.size();
+   uint32_t xn = map[0].size();
+   uint32_t ys = y == yn - 1 ? y : y + 1;
+   uint32_t ya = y == 0 ? y : y - 1;
+   uint32_t end = std::min(x1, xn);
+
+   const glm::vec3 untouched = {-1234.5f, -1234.5f, -1234.5f};
+   std::vector<glm::vec3> expected(xn, untouched);
+   for (uint32_t x = x0; x < end; ++x) {
+      expected[x] = reference(map, x, y);
+   }
+
+   for (const auto &k : kernels) {
+      std::vector<glm::vec3> normals(xn, untouched);
+      if (!lve::terrainRowNormals(k.kernel, map[y].data(),
+                                  map[ys].data(), map[ya].data(), y, ys,
+                                  ya, xn, normals.data(), x0, x1)) {
+         continue;
+      }
+      bool equal = true;
+      for (uint32_t x = 0; x < xn; ++x) {
+         equal = equal && !std::memcmp(&normals[x], &expected[x],
+                                       sizeof(glm::vec3));
+      }
+      check(equal, std::string(k.name) + " row " + std::to_string(y) +
+                       " of " + std::to_string(yn) + "x" +
+                       std::to_string(xn) + " [" + std::to_string(x0) +
+                       ", " + std::to_string(end) + ")");
+   }
+}
+
+}  // namespace
+
+int main() {
+   for (const auto &k : kernels) {
+      std::vector<glm::vec3> normals(1);
+      glm::float32 cell = 0.f;
+      bool available = lve::terrainRowNormals(
+          k.kernel, &cell, &cell, &cell, 0, 0, 0, 1, normals.data());
+      std::printf("%s kernel: %s\n", k.name,
+                  available ? "tested" : "not available");
+   }
+   check(lve::terrainRowNormals(lve::NormalsKernel::Scalar, nullptr,
+                                nullptr, nullptr, 0, 0, 0, 0, nullptr),
+         "the scalar kernel is always available");
+
+   std::mt19937 rng(7);
+   std::uniform_real_distribution<glm::float32> height(-500.f, 4000.f);
+   // Widths around the 4 and 8 lane blocks, and a long row.
+   const uint32_t widths[] = {1,  2,  3,  4,  5,  7,   8,
+                              9, 10, 16, 17, 33, 1001};
+   for (uint32_t xn : widths) {
+      const uint32_t yn = 4;
+      std::vector<std::vector<glm::float32>> map(
+          yn, std::vector<glm::float32>(xn));
+      for (auto &row : map) {
+         for (glm::float32 &cell : row) cell = height(rng);
+      }
+      // Flat and repeated cells, where the crosses cancel out.
+      map[1][0] = map[1][xn - 1] = map[0][0];
+
+      // The first and last rows have a single vertical neighbour.
+      for (uint32_t y = 0; y < yn; ++y) {
+         checkRange(map, y, 0, UINT32_MAX);
+         checkRange(map, y, 0, xn);
+         std::uniform_int_distribution<uint32_t> pick(0, xn);
+         for (int i = 0; i < 8; ++i) {
+            uint32_t a = pick(rng);
+            uint32_t b = pick(rng);
+            checkRange(map, y, std::min(a, b), std::max(a, b));
+         }
+         // The sub-ranges the parallel mesh build splits rows into.
+         checkRange(map, y, 0, xn / 2);
+         checkRange(map, y, xn / 2, xn);
+         checkRange(map, y, 1, xn - 1);
+      }
+   }
+
+   return report("terrain_normals_test");
+}
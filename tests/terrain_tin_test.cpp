@@ -0,0 +1,168 @@
+// Checks that simplifyTerrain covers the grid with a watertight mesh of
+// counterclockwise triangles that stays within maxError of the map.
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "lve/lve_terrain_tin.hpp"
+#include "tests/test_check.hpp"
+
+namespace {
+
+struct Point {
+   int64_t c;
+   int64_t r;
+};
+
+int64_t orient(const Point &a, const Point &b, const Point &q) {
+   return (b.c - a.c) * (q.r - a.r) - (b.r - a.r) * (q.c - a.c);
+}
+
+lve::Raster<glm::float32> plane(uint32_t xn, uint32_t yn) {
+   lve::Raster<glm::float32> map(xn, yn);
+   for (uint32_t y = 0; y < yn; ++y) {
+      for (uint32_t x = 0; x < xn; ++x) map(x, y) = 2.f * x - 0.5f * y;
+   }
+   return map;
+}
+
+/**
+ * Simplifies map and checks the mesh. Returns its triangle count, or 0
+ * when the layout doesn't hold every index.
+ */
+size_t checkMesh(const std::string &name,
+                 const lve::Raster<glm::float32> &map, float maxError,
+                 uint32_t chunkSize) {
+   const uint32_t xn = map.width();
+   const uint32_t yn = map.height();
+   std::vector<uint32_t> indices;
+   lve::TerrainChunks chunks =
+       lve::simplifyTerrain(map, maxError, indices, 0, chunkSize);
+
+   size_t drawn = 0;
+   for (const auto &chunk : chunks.getChunks()) {
+      check(chunk.lods.size() == 1, name + ": one level per chunk");
+      if (!chunk.lods.empty()) drawn += chunk.lods[0].interior.count;
+   }
+   check(drawn == indices.size(), name + ": the chunks draw every index");
+   if (indices.size() % 3 || drawn != indices.size()) return 0;
+
+   auto point = [&](uint32_t i) {
+      return Point{i % xn, i / xn};
+   };
+   auto height = [&](const Point &p) {
+      return static_cast<double>(map(xn - 1 - p.c, p.r));
+   };
+
+   // Each inner edge must be used once in each direction, and only the
+   // edges on the border of the grid once.
+   std::map<std::pair<uint32_t, uint32_t>, int> edges;
+   int64_t area = 0;
+   bool nondegenerate = true;
+   double worst = 0.;
+   for (size_t t = 0; t < indices.size(); t += 3) {
+      const uint32_t *v = &indices[t];
+      Point a = point(v[0]), b = point(v[1]), q = point(v[2]);
+      int64_t twice = orient(a, b, q);
+      if (twice <= 0) {
+         nondegenerate = false;
+         continue;
+      }
+      area += twice;
+      for (int k = 0; k < 3; ++k) ++edges[{v[k], v[(k + 1) % 3]}];
+
+      int64_t c0 = std::min({a.c, b.c, q.c});
+      int64_t c1 = std::max({a.c, b.c, q.c});
+      int64_t r0 = std::min({a.r, b.r, q.r});
+      int64_t r1 = std::max({a.r, b.r, q.r});
+      for (int64_t r = r0; r <= r1; ++r) {
+         for (int64_t c = c0; c <= c1; ++c) {
+            Point x{c, r};
+            int64_t wa = orient(b, q, x);
+            int64_t wb = orient(q, a, x);
+            int64_t wq = orient(a, b, x);
+            if (wa < 0 || wb < 0 || wq < 0) continue;
+            double fan =
+                (wa * height(a) + wb * height(b) + wq * height(q)) /
+                twice;
+            worst = std::max(worst, std::abs(fan - height(x)));
+         }
+      }
+   }
+   check(nondegenerate, name + ": counterclockwise, nondegenerate");
+   check(area == 2 * int64_t(xn - 1) * (yn - 1),
+         name + ": the triangles cover the grid once");
+
+   bool watertight = true;
+   for (const auto &[edge, count] : edges) {
+      auto twin = edges.find({edge.second, edge.first});
+      if (count != 1) {
+         watertight = false;
+      } else if (twin == edges.end()) {
+         Point a = point(edge.first), b = point(edge.second);
+         bool border = (a.r == b.r && (a.r == 0 || a.r == yn - 1)) ||
+                       (a.c == b.c && (a.c == 0 || a.c == xn - 1));
+         watertight = watertight && border;
+      }
+   }
+   check(watertight, name + ": watertight");
+   check(worst <= maxError + 1e-3,
+         name + ": within maxError, off by " + std::to_string(worst));
+
+   std::vector<uint32_t> serial;
+   lve::simplifyTerrain(map, maxError, serial, 1, chunkSize);
+   check(serial == indices, name + ": same mesh on one thread");
+   return indices.size() / 3;
+}
+
+}  // namespace
+
+int main() {
+   struct Case {
+      uint32_t xn, yn;
+      float maxError;
+      uint32_t chunkSize;
+   } cases[] = {
+       {130, 97, 0.5f, 16},
+       {130, 97, 2.f, 64},
+       {65, 65, 0.f, 32},
+       {200, 3, 1.f, 16},
+       {2, 2, 1.f, 16},
+   };
+   for (const Case &c : cases) {
+      std::string name = std::to_string(c.xn) + "x" +
+                         std::to_string(c.yn) + " error " +
+                         std::to_string(c.maxError) + " chunk " +
+                         std::to_string(c.chunkSize);
+      size_t triangles = checkMesh(name, syntheticTerrain(c.xn, c.yn),
+                                   c.maxError, c.chunkSize);
+      if (c.maxError == 0.f) {
+         check(triangles == 2 * size_t(c.xn - 1) * (c.yn - 1),
+               name + ": no error keeps every quad");
+      }
+   }
+
+   // A plane needs no more than the chunk corners.
+   size_t triangles = checkMesh("plane", plane(129, 129), 0.01f, 32);
+   check(triangles > 0 && triangles <= 16 * 4,
+         "plane: simplified to " + std::to_string(triangles) +
+             " triangles");
+
+   bool threw = false;
+   try {
+      std::vector<uint32_t> indices;
+      lve::simplifyTerrain(syntheticTerrain(10, 10), 1.f, indices, 0,
+                           12);
+   } catch (const std::runtime_error &) {
+      threw = true;
+   }
+   check(threw, "chunk sizes must be powers of two");
+
+   return report("terrain_tin_test");
+}
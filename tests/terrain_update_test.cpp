@@ -0,0 +1,231 @@
+// Updates regions of a terrain and checks its buffers against a terrain
+// built from the edited maps, for every vertex format. Skipped without a
+// Vulkan device.
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "lve/lve_terrain.hpp"
+#include "tests/test_check.hpp"
+#include "tests/test_device.hpp"
+
+namespace {
+
+using lve::LveTerrain;
+using Format = LveTerrain::VertexFormat;
+
+const uint32_t xn = 90;
+const uint32_t yn = 70;
+// One inside the map, one across its last column and row.
+const LveTerrain::Region regions[] = {
+    {.x0 = 17, .y0 = 9, .x1 = 41, .y1 = 30},
+    {.x0 = xn - 6, .y0 = 20, .x1 = xn + 4, .y1 = yn},
+};
+const glm::int32 types[] = {3, 7, 12};
+// Only painted by the edits.
+const glm::int32 newType = 99;
+
+struct Maps {
+   lve::Raster<glm::float32> altitude;
+   lve::Raster<glm::vec3> color;
+   lve::Raster<glm::int32> vegetation;
+};
+
+/**
+ * The extremes of the altitude sit in corners no region touches, so the
+ * edits keep the Compact16 range.
+ */
+Maps syntheticMaps() {
+   Maps maps{syntheticTerrain(xn, yn), lve::Raster<glm::vec3>(xn, yn),
+             lve::Raster<glm::int32>(xn, yn)};
+   for (uint32_t y = 0; y < yn; ++y) {
+      for (uint32_t x = 0; x < xn; ++x) {
+         maps.color(x, y) = {x / float(xn), y / float(yn), 0.5f};
+         maps.vegetation(x, y) = types[(x / 7 + y / 5) % 3];
+      }
+   }
+   maps.altitude(xn - 1, 0) = 200.f;
+   maps.altitude(0, yn - 1) = -200.f;
+   return maps;
+}
+
+void edit(Maps &maps, const LveTerrain::Region &region, glm::int32 type) {
+   for (uint32_t y = region.y0; y < std::min(region.y1, yn); ++y) {
+      for (uint32_t x = region.x0; x < std::min(region.x1, xn); ++x) {
+         maps.altitude(x, y) = 0.5f * maps.altitude(x, y) + 3.f;
+         maps.color(x, y) = {0.1f, 0.9f, 0.2f};
+         maps.vegetation(x, y) = type;
+      }
+   }
+}
+
+std::vector<uint8_t> bytes(lve::LveDevice &device,
+                           const VkDescriptorBufferInfo &info,
+                           VkDeviceSize size) {
+   return readBack<uint8_t>(device, info.buffer,
+                            static_cast<uint32_t>(size));
+}
+
+size_t vertexSize(Format format) {
+   switch (format) {
+      case Format::Full:
+         return sizeof(LveTerrain::Vertex);
+      case Format::Compact16:
+         return sizeof(LveTerrain::CompactVertex16);
+      case Format::Compact32:
+         return sizeof(LveTerrain::CompactVertex32);
+      case Format::Raster:
+         break;
+   }
+   return 0;
+}
+
+void checkChunks(lve::LveDevice &device, const std::string &name,
+                 LveTerrain &updated, LveTerrain &rebuilt) {
+   const auto &chunks = updated.getChunks().getChunks();
+   const auto &expected = rebuilt.getChunks().getChunks();
+   bool same = chunks.size() == expected.size();
+   for (size_t i = 0; same && i < chunks.size(); ++i) {
+      same = chunks[i].minAlttitude == expected[i].minAlttitude &&
+             chunks[i].maxAlttitude == expected[i].maxAlttitude;
+   }
+   check(same, name + ": chunk bounds");
+   VkDeviceSize size =
+       sizeof(lve::TerrainChunks::GpuChunk) * chunks.size();
+   check(bytes(device, updated.chunkInfo(), size) ==
+             bytes(device, rebuilt.chunkInfo(), size),
+         name + ": chunk buffer");
+}
+
+void checkVertexFormat(lve::LveDevice &device, Format format,
+                       const std::string &name) {
+   Maps maps = syntheticMaps();
+   LveTerrain::Builder builder;
+   builder.format = format;
+   builder.generateMesh(maps.altitude, maps.color);
+   LveTerrain updated(device, builder);
+   for (const LveTerrain::Region &region : regions) {
+      edit(maps, region, newType);
+      updated.update(maps.altitude, maps.color, region);
+   }
+
+   builder.generateMesh(maps.altitude, maps.color);
+   LveTerrain rebuilt(device, builder);
+   VkDeviceSize size = vertexSize(format) * xn * yn;
+   check(bytes(device, updated.vertexInfo(), size) ==
+             bytes(device, rebuilt.vertexInfo(), size),
+         name + ": vertex buffer");
+   checkChunks(device, name, updated, rebuilt);
+
+   builder.maxError = 1.f;
+   builder.generateMesh(maps.altitude, maps.color);
+   LveTerrain simplified(device, builder);
+   bool threw = false;
+   try {
+      simplified.update(maps.altitude, maps.color, regions[0]);
+   } catch (const std::runtime_error &) {
+      threw = true;
+   }
+   check(threw, name + ": simplified terrains refuse altitude updates");
+}
+
+/**
+ * Vegetation type of every vertex of a Raster terrain. The classes
+ * depend on the order the types were met in, so the types are compared
+ * instead of the vegetation buffer bytes.
+ */
+std::vector<glm::int32> vertexTypes(lve::LveDevice &device,
+                                    LveTerrain &terrain) {
+   std::vector<glm::uint32> words = readBack<glm::uint32>(
+       device, terrain.vegetationInfo().buffer, (xn * yn + 1) / 2);
+   std::vector<glm::int32> out;
+   for (size_t i = 0; i < size_t(xn) * yn; ++i) {
+      glm::uint32 vegetationClass = (words[i / 2] >> (16 * (i % 2))) &
+                                    0xffff;
+      out.push_back(terrain.getVegetationTypes().at(vegetationClass));
+   }
+   return out;
+}
+
+std::vector<glm::int32> mapTypes(const Maps &maps) {
+   std::vector<glm::int32> out;
+   for (size_t i = 0; i < size_t(xn) * yn; ++i) {
+      out.push_back(maps.vegetation(xn - 1 - i % xn, i / xn));
+   }
+   return out;
+}
+
+void checkRaster(lve::LveDevice &device) {
+   Maps maps = syntheticMaps();
+   LveTerrain::Builder builder;
+   builder.generateRaster(maps.altitude, maps.vegetation);
+   builder.palette.resize(builder.vegetationTypes.size());
+   LveTerrain updated(device, builder);
+   edit(maps, regions[0], types[1]);
+   updated.update(maps.altitude, maps.vegetation, regions[0]);
+   edit(maps, regions[1], newType);
+   updated.update(maps.altitude, maps.vegetation, regions[1]);
+
+   builder.generateRaster(maps.altitude, maps.vegetation);
+   builder.palette.resize(builder.vegetationTypes.size());
+   LveTerrain rebuilt(device, builder);
+   VkDeviceSize size = sizeof(glm::float32) * xn * yn;
+   check(bytes(device, updated.alttitudeInfo(), size) ==
+             bytes(device, rebuilt.alttitudeInfo(), size),
+         "raster: altitude buffer");
+   checkChunks(device, "raster", updated, rebuilt);
+   check(vertexTypes(device, updated) == mapTypes(maps),
+         "raster: vegetation buffer");
+   check(updated.getVegetationTypes().size() == 4 &&
+             updated.getVegetationTypes().back() == newType,
+         "raster: the new type takes the next class");
+
+   std::vector<glm::vec4> palette(4, glm::vec4(0.25f, 0.5f, 0.75f, 1.f));
+   updated.setPalette(palette);
+   check(readBack<glm::vec4>(device, updated.paletteInfo().buffer, 4) ==
+             palette,
+         "raster: the palette grows with the types");
+
+   // Only the vegetation of a simplified terrain can change.
+   builder.maxError = 1.f;
+   builder.generateRaster(maps.altitude, maps.vegetation);
+   builder.palette.resize(builder.vegetationTypes.size());
+   LveTerrain simplified(device, builder);
+   bool threw = false;
+   try {
+      simplified.update(maps.altitude, maps.vegetation, regions[0]);
+   } catch (const std::runtime_error &) {
+      threw = true;
+   }
+   check(threw, "simplified raster: refuses altitude updates");
+   edit(maps, regions[0], types[2]);
+   simplified.update(maps.vegetation, regions[0]);
+   check(vertexTypes(device, simplified) == mapTypes(maps),
+         "simplified raster: vegetation buffer");
+}
+
+}  // namespace
+
+int main() {
+   TestDevice gpu;
+   if (!gpu.open()) {
+      std::printf("no Vulkan device, skipping terrain_update_test\n");
+      return 0;
+   }
+   const struct {
+      Format format;
+      const char *name;
+   } formats[] = {
+       {Format::Full, "full"},
+       {Format::Compact16, "compact16"},
+       {Format::Compact32, "compact32"},
+   };
+   for (const auto &f : formats) {
+      checkVertexFormat(*gpu.device, f.format, f.name);
+   }
+   checkRaster(*gpu.device);
+   return report("terrain_update_test");
+}
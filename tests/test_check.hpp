@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+
+#include "lve/lve_raster.hpp"
+
+#define GLM_FORCE_RADIANS
+#define GLM_FORCE_DEPTH_ZERO_TO_ONE
+#include <glm/glm.hpp>
+
+/**
+ * Counts the failed checks of a test. The test's main returns
+ * report(name), nonzero when any check failed.
+ */
+inline int failures = 0;
+
+inline void check(bool ok, const std::string &what) {
+   if (ok) return;
+   std::fprintf(stderr, "FAIL: %s\n", what.c_str());
+   ++failures;
+}
+
+inline int report(const char *test) {
+   if (failures) {
+      std::fprintf(stderr, "%s: %d checks failed\n", test, failures);
+      return 1;
+   }
+   std::printf("%s: OK\n", test);
+   return 0;
+}
+
+/**
+ * Wind blowing along x and waving along y, over a slope. Some lines
+ * leave the map and others run out of time inside it.
+ */
+inline void syntheticField(uint32_t xn, uint32_t yn,
+                           lve::Raster<glm::float32> &altitude,
+                           lve::Raster<glm::vec2> &wind, float &min,
+                           float &max) {
+   altitude = lve::Raster<glm::float32>(xn, yn);
+   wind = lve::Raster<glm::vec2>(xn, yn);
+   min = 1e30f;
+   max = 0.f;
+   for (uint32_t y = 0; y < yn; ++y) {
+      for (uint32_t x = 0; x < xn; ++x) {
+         altitude(x, y) = 0.3f * x + 5.f * std::sin(y * 0.05f);
+         glm::vec2 w(1.f + 0.5f * std::cos(y * 0.07f),
+                     0.6f * std::sin(x * 0.1f) + 0.2f);
+         wind(x, y) = w;
+         min = std::min(min, glm::length(w));
+         max = std::max(max, glm::length(w));
+      }
+   }
+}
+
+/**
+ * Hills and a cliff, so that simplifyTerrain splits some blocks down to
+ * single quads.
+ */
+inline lve::Raster<glm::float32> syntheticTerrain(uint32_t xn,
+                                                  uint32_t yn) {
+   lve::Raster<glm::float32> map(xn, yn);
+   for (uint32_t y = 0; y < yn; ++y) {
+      for (uint32_t x = 0; x < xn; ++x) {
+         map(x, y) = 40.f * std::sin(x * 0.05f) * std::cos(y * 0.07f) +
+                     0.1f * x + (x > xn / 3 ? 25.f : 0.f);
+      }
+   }
+   return map;
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstdio>
+#include <cstring>
+#include <exception>
+#include <memory>
+#include <vector>
+
+#include "lve/lve_buffer.hpp"
+#include "lve/lve_device.hpp"
+#include "lve/lve_window.hpp"
+
+/**
+ * A hidden window and a device for the tests that need the GPU. Without
+ * a display or a Vulkan driver open fails, and those checks are skipped.
+ */
+struct TestDevice {
+   std::unique_ptr<lve::LveWindow> window;
+   std::unique_ptr<lve::LveDevice> device;
+
+   bool open() {
+      // LveWindow doesn't check that its window opened, so try first.
+      if (!glfwInit()) return false;
+      if (!glfwVulkanSupported()) {
+         glfwTerminate();
+         return false;
+      }
+      glfwWindowHint(GLFW_CLIENT_API, GLFW_NO_API);
+      glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+      GLFWwindow *probe =
+          glfwCreateWindow(64, 64, "test", nullptr, nullptr);
+      if (!probe) {
+         glfwTerminate();
+         return false;
+      }
+      glfwDestroyWindow(probe);
+      try {
+         window = std::make_unique<lve::LveWindow>(64, 64, "test");
+         device = std::make_unique<lve::LveDevice>(*window);
+      } catch (const std::exception &e) {
+         std::fprintf(stderr, "no Vulkan device: %s\n", e.what());
+         device.reset();
+         window.reset();
+         return false;
+      }
+      return true;
+   }
+};
+
+// Copies count elements of a device local buffer back to the host.
+template <typename T>
+std::vector<T> readBack(lve::LveDevice &device, VkBuffer buffer,
+                        uint32_t count) {
+   lve::LveBuffer host{
+       device,
+       sizeof(T),
+       count,
+       VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+       VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
+           VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+   };
+   device.copyBuffer(buffer, host.getBuffer(), sizeof(T) * count);
+   host.map();
+   std::vector<T> ret(count);
+   std::memcpy(ret.data(), host.getMappedMemory(), sizeof(T) * count);
+   return ret;
+}
@@ -0,0 +1,108 @@
+// Checks the cache miss ratio of the terrain index orders and that
+// optimizeVertexCache only reorders triangles.
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "lve/lve_terrain_chunks.hpp"
+#include "lve/lve_terrain_tin.hpp"
+#include "lve/lve_vertex_cache.hpp"
+#include "tests/test_check.hpp"
+
+namespace {
+
+// Level 0 bound for both terrain orders; a regular grid can't go below
+// 0.5.
+constexpr float max_ratio = 0.65f;
+
+using Triangle = std::array<uint32_t, 3>;
+
+// Triangles rotated to start at their smallest index, winding kept, and
+// sorted, so that two lists with the same triangles compare equal.
+std::vector<Triangle> triangles(const uint32_t *indices, size_t count) {
+   std::vector<Triangle> out;
+   for (size_t t = 0; t + 2 < count; t += 3) {
+      Triangle tri = {indices[t], indices[t + 1], indices[t + 2]};
+      std::rotate(tri.begin(), std::min_element(tri.begin(), tri.end()),
+                  tri.end());
+      out.push_back(tri);
+   }
+   std::sort(out.begin(), out.end());
+   return out;
+}
+
+// Quads of an xn * yn grid, split as the terrain does.
+std::vector<uint32_t> gridTriangles(uint32_t xn, uint32_t yn) {
+   std::vector<uint32_t> indices;
+   for (uint32_t r = 0; r + 1 < yn; ++r) {
+      for (uint32_t c = 0; c + 1 < xn; ++c) {
+         uint32_t a = r * xn + c;
+         indices.insert(indices.end(),
+                        {a, a + 1, a + xn, a + 1, a + xn + 1, a + xn});
+      }
+   }
+   return indices;
+}
+
+void checkOptimize(const std::string &name,
+                   std::vector<uint32_t> indices) {
+   const uint32_t *data = indices.data();
+   std::vector<Triangle> before = triangles(data, indices.size());
+   float ratio = lve::averageCacheMissRatio(data, indices.size());
+   lve::optimizeVertexCache(indices.data(), indices.size());
+   check(triangles(data, indices.size()) == before,
+         name + ": same triangles and winding");
+   float optimized = lve::averageCacheMissRatio(data, indices.size());
+   check(optimized <= ratio,
+         name + ": ratio " + std::to_string(ratio) + " went up to " +
+             std::to_string(optimized));
+}
+
+}  // namespace
+
+int main() {
+   const uint32_t single[] = {0, 1, 2};
+   check(lve::averageCacheMissRatio(single, 3) == 3.f,
+         "a lone triangle misses every vertex");
+   const uint32_t twice[] = {0, 1, 2, 2, 1, 0};
+   check(lve::averageCacheMissRatio(twice, 6) == 1.5f,
+         "a repeated triangle hits the cache");
+
+   const uint32_t xn = 257, yn = 193;
+   std::vector<uint32_t> grid;
+   lve::TerrainChunks chunks(xn, yn, grid);
+   float ratio = chunks.cacheMissRatio(grid);
+   check(ratio < max_ratio, "grid chunks: ratio " + std::to_string(ratio));
+
+   // The terrain only simplifies with a positive error.
+   const float errors[] = {0.1f, 0.5f, 2.f};
+   for (float maxError : errors) {
+      std::string name = "TIN error " + std::to_string(maxError);
+      std::vector<uint32_t> tin;
+      lve::TerrainChunks layout =
+          lve::simplifyTerrain(syntheticTerrain(xn, yn), maxError, tin);
+      std::vector<Triangle> before = triangles(tin.data(), tin.size());
+      layout.optimizeIndices(tin);
+      check(triangles(tin.data(), tin.size()) == before,
+            name + ": optimizeIndices keeps the triangles");
+      ratio = layout.cacheMissRatio(tin);
+      check(ratio < max_ratio, name + ": ratio " + std::to_string(ratio));
+   }
+
+   std::vector<uint32_t> shuffled = gridTriangles(60, 40);
+   std::vector<Triangle> quads(shuffled.size() / 3);
+   std::memcpy(quads.data(), shuffled.data(),
+               shuffled.size() * sizeof(uint32_t));
+   std::shuffle(quads.begin(), quads.end(), std::mt19937(7));
+   std::memcpy(shuffled.data(), quads.data(),
+               shuffled.size() * sizeof(uint32_t));
+   checkOptimize("shuffled grid", shuffled);
+   checkOptimize("grid rows", gridTriangles(300, 4));
+   checkOptimize("empty", {});
+
+   return report("vertex_cache_test");
+}
@@ -0,0 +1,71 @@
+// Checks that wind meshes small enough for 16-bit indices get them,
+// line restarts included.
+#include <algorithm>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "lve/lve_buffer.hpp"
+#include "lve/lve_wind.hpp"
+#include "tests/test_check.hpp"
+#include "tests/test_device.hpp"
+
+int main() {
+   const uint32_t restart = 0xffffffff;
+   check(lve::indexTypeFor({0, 1, 2, restart, 3, 4}) ==
+             VK_INDEX_TYPE_UINT16,
+         "restarts don't need 32-bit indices");
+   check(lve::indexTypeFor({0, 0xffff, restart}) == VK_INDEX_TYPE_UINT32,
+         "0xffff needs 32-bit indices");
+   check(lve::indexTypeFor({0, 70000}) == VK_INDEX_TYPE_UINT32,
+         "large indices need 32-bit indices");
+   check(lve::narrowIndices({7, restart, 0xfffe}) ==
+             std::vector<uint16_t>{7, 0xffff, 0xfffe},
+         "narrowIndices keeps the restarts");
+
+   lve::Raster<glm::float32> altitude;
+   lve::Raster<glm::vec2> wind;
+   float min, max;
+   syntheticField(120, 90, altitude, wind, min, max);
+
+   TestDevice gpu;
+   bool has_device = gpu.open();
+   if (!has_device) std::printf("no Vulkan device, skipping LveWind\n");
+
+   const lve::LveWind::Seeding seedings[] = {
+       lve::LveWind::Seeding::Grid, lve::LveWind::Seeding::EvenlySpaced};
+   for (lve::LveWind::Seeding seeding : seedings) {
+      std::string name = seeding == lve::LveWind::Seeding::Grid
+                             ? "grid"
+                             : "evenly spaced";
+      lve::LveWind::Builder builder;
+      builder.seeding = seeding;
+      builder.integrator = lve::LveWind::Integrator::Adaptive;
+      builder.generateMesh(altitude, wind, min, max);
+      check(!builder.vertices.empty() && builder.vertices.size() < 0xffff,
+            name + ": the mesh fits 16-bit indices");
+
+      size_t restarts = 0;
+      for (uint32_t index : builder.indices) restarts += index == restart;
+      check(restarts > 0, name + ": the lines end in restarts");
+      check(lve::indexTypeFor(builder.indices) == VK_INDEX_TYPE_UINT16,
+            name + ": indexTypeFor gives UINT16");
+
+      std::vector<uint16_t> narrow = lve::narrowIndices(builder.indices);
+      bool same = narrow.size() == builder.indices.size();
+      for (size_t i = 0; same && i < narrow.size(); ++i) {
+         same = builder.indices[i] == restart
+                    ? narrow[i] == 0xffff
+                    : narrow[i] == builder.indices[i];
+      }
+      check(same, name + ": narrowed indices");
+
+      if (has_device) {
+         lve::LveWind mesh(*gpu.device, builder);
+         check(mesh.getIndexType() == VK_INDEX_TYPE_UINT16,
+               name + ": LveWind binds UINT16 indices");
+      }
+   }
+
+   return report("wind_indices_test");
+}
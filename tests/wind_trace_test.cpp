@@ -0,0 +1,166 @@
+// Traces the same wind lines with WindTraceSystem on the GPU and with
+// LveWind::Builder::generateMesh, Grid seeds and Adaptive integrator,
+// and checks they agree. Skipped without a Vulkan device.
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "lve/lve_buffer.hpp"
+#include "lve/lve_wind.hpp"
+#include "systems/wind_trace_system.hpp"
+#include "tests/test_check.hpp"
+#include "tests/test_device.hpp"
+
+namespace {
+
+using Vertex = lve::LveWind::Vertex;
+
+// Room per line on the GPU, more than any line of the field takes.
+constexpr uint32_t capacity = 2048;
+// How far, in cells, a GPU vertex may be from the CPU line. Rounding
+// makes the two pick different steps, so they keep different vertices
+// along the same path, each up to decimate_distance (0.02) off it.
+constexpr float distance_tolerance = 0.05f;
+constexpr float speed_tolerance = 1e-3f;
+// Longest adaptive step, in cells, max_segment in lve_wind.cpp. Lines
+// end after a fixed time or before the step that would leave the map,
+// and with different steps they drift along the path, so their ends may
+// be up to a step apart. Only the ends are checked there.
+constexpr float max_segment = 1.f;
+
+// Distance from p to the segment ab.
+float segmentDistance(const glm::vec3 &p, const glm::vec3 &a,
+                      const glm::vec3 &b) {
+   glm::vec3 ab = b - a;
+   float length2 = glm::dot(ab, ab);
+   float t = length2 > 0.f
+                 ? glm::clamp(glm::dot(p - a, ab) / length2, 0.f, 1.f)
+                 : 0.f;
+   return glm::length(p - (a + ab * t));
+}
+
+// Distance from p to the polyline through line.
+float lineDistance(const glm::vec3 &p, const std::vector<Vertex> &line) {
+   float best = glm::length(p - line[0].position);
+   for (size_t i = 1; i < line.size(); ++i) {
+      best = std::min(best, segmentDistance(p, line[i - 1].position,
+                                            line[i].position));
+   }
+   return best;
+}
+
+/**
+ * Largest distance from a vertex of `from` to the polyline through
+ * `to`, leaving out those within a step of the end of `to`.
+ */
+float lineDistance(const std::vector<Vertex> &from,
+                   const std::vector<Vertex> &to) {
+   float worst = 0.f;
+   for (const Vertex &vertex : from) {
+      if (glm::length(vertex.position - to.back().position) <
+          max_segment) {
+         continue;
+      }
+      worst = std::max(worst, lineDistance(vertex.position, to));
+   }
+   return worst;
+}
+
+/**
+ * Compares line by line: the seed and its speed, the vertex counts, how
+ * far every GPU vertex is from the CPU line and vice versa, and where
+ * the lines end.
+ */
+void compare(const lve::LveWind::Builder &builder,
+             const std::vector<Vertex> &gpu,
+             const std::vector<VkDrawIndirectCommand> &draws) {
+   std::vector<std::vector<Vertex>> lines(1);
+   for (uint32_t index : builder.indices) {
+      if (index == 0xffffffff) {
+         lines.emplace_back();
+      } else {
+         lines.back().push_back(builder.vertices[index]);
+      }
+   }
+   lines.pop_back();
+   check(lines.size() == draws.size(), "line counts");
+
+   // Decimating keeps more or fewer vertices depending on where the
+   // steps fall, a line varies a lot more than the total.
+   size_t n = std::min(lines.size(), draws.size());
+   size_t cpu_total = 0;
+   size_t gpu_total = 0;
+   for (size_t l = 0; l < n; ++l) {
+      std::string name = "line " + std::to_string(l);
+      const VkDrawIndirectCommand &draw = draws[l];
+      check(draw.firstVertex == l * capacity && draw.instanceCount == 1,
+            name + ": draw");
+      const std::vector<Vertex> &cpu = lines[l];
+      uint32_t count = std::min(draw.vertexCount, capacity);
+      check(cpu.size() < capacity, name + ": fits the GPU line");
+      cpu_total += cpu.size();
+      gpu_total += count;
+      uint32_t slack = 4 + static_cast<uint32_t>(cpu.size() / 4);
+      check(count + slack >= cpu.size() && count <= cpu.size() + slack,
+            name + ": " + std::to_string(count) + " vertices, " +
+                std::to_string(cpu.size()) + " on the CPU");
+      if (!count || cpu.empty()) continue;
+
+      std::vector<Vertex> line(gpu.begin() + draw.firstVertex,
+                               gpu.begin() + draw.firstVertex + count);
+      check(glm::length(line[0].position - cpu[0].position) < 1e-3f &&
+                std::fabs(line[0].speed - cpu[0].speed) <
+                    speed_tolerance,
+            name + ": seed");
+      float worst =
+          std::max(lineDistance(line, cpu), lineDistance(cpu, line));
+      check(worst < distance_tolerance,
+            name + ": " + std::to_string(worst) + " cells apart");
+      check(glm::length(line.back().position - cpu.back().position) <
+                max_segment + distance_tolerance,
+            name + ": ends");
+   }
+   check(gpu_total * 50 >= cpu_total * 49 &&
+             gpu_total * 49 <= cpu_total * 50,
+         std::to_string(gpu_total) + " vertices, " +
+             std::to_string(cpu_total) + " on the CPU");
+}
+
+}  // namespace
+
+int main() {
+   TestDevice gpu;
+   if (!gpu.open()) {
+      std::printf("no Vulkan device, skipping wind_trace_test\n");
+      return 0;
+   }
+
+   const uint32_t xn = 200;
+   const uint32_t yn = 150;
+   lve::Raster<glm::float32> altitude;
+   lve::Raster<glm::vec2> wind;
+   float min, max;
+   syntheticField(xn, yn, altitude, wind, min, max);
+
+   lve::LveWind::Builder builder;
+   builder.seeding = lve::LveWind::Seeding::Grid;
+   builder.integrator = lve::LveWind::Integrator::Adaptive;
+   builder.generateMesh(altitude, wind, min, max);
+
+   const uint32_t spacing = lve::LveWind::seedSpacing;
+   const uint32_t lines =
+       ((xn + spacing - 1) / spacing) * ((yn + spacing - 1) / spacing);
+   lve::WindTraceSystem traceSystem{*gpu.device,
+                                    "shaders/wind_trace.comp.spv"};
+   std::unique_ptr<lve::LveWind> traced =
+       traceSystem.trace(altitude, wind, min, max, capacity);
+   compare(builder,
+           readBack<Vertex>(*gpu.device, traced->vertexInfo().buffer,
+                            lines * capacity),
+           readBack<VkDrawIndirectCommand>(
+               *gpu.device, traced->drawInfo().buffer, lines));
+
+   return report("wind_trace_test");
+}